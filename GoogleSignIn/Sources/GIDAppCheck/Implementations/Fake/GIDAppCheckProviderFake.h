@@ -38,6 +38,9 @@ NS_CLASS_AVAILABLE_IOS(14)
 - (instancetype)initWithAppCheckToken:(nullable GACAppCheckToken *)token
                                 error:(nullable NSError *)error;
 
+/// The number of times `getLimitedUseTokenWithCompletion:` has been called.
+@property(atomic, readonly) NSUInteger limitedUseTokenRequestCount;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -24,6 +24,7 @@ NSUInteger const kGIDAppCheckProviderFakeError = 1;
 
 @property(nonatomic, strong, nullable) GACAppCheckToken *token;
 @property(nonatomic, strong, nullable) NSError *error;
+@property(atomic, readwrite) NSUInteger limitedUseTokenRequestCount;
 
 @end
 
@@ -46,6 +47,9 @@ NSUInteger const kGIDAppCheckProviderFakeError = 1;
 
 - (void)getLimitedUseTokenWithCompletion:(void (^)(GACAppCheckToken *,
                                                    NSError * _Nullable))handler {
+  @synchronized (self) {
+    self.limitedUseTokenRequestCount++;
+  }
   dispatch_async(dispatch_get_main_queue(), ^{
     handler(self.token, self.error);
   });
@@ -61,10 +61,25 @@ NS_CLASS_AVAILABLE_IOS(14)
 
 /// Fetches the limited use Firebase token.
 ///
+/// If a fresh token was prefetched it is handed out without waiting on the provider. Otherwise the
+/// caller waits for the in-flight fetch along with any other callers. Each token is handed out at
+/// most once, and `completion` is always called asynchronously on the main queue.
+///
 /// @param completion A `nullable` callback with the `FIRAppCheckToken`, or an `NSError` otherwise.
-- (void)getLimitedUseTokenWithCompletion:
+/// @return `YES` if a prefetched token was taken for `completion`, `NO` if it has to wait for one.
+- (BOOL)getLimitedUseTokenWithCompletion:
     (nullable void (^)(GACAppCheckToken *token, NSError * _Nullable error))completion;
 
+/// Fetches a limited use token in the background, if one is not already available or in flight, so
+/// that the next call to `getLimitedUseTokenWithCompletion:` can be served without waiting.
+///
+/// Every fetched token counts against the App Check quota, so only call this when a sign-in is
+/// likely to follow. Unused tokens are dropped once they are about to expire.
+- (void)prefetchLimitedUseToken;
+
+/// Whether or not a fresh limited use token is ready to be handed out without waiting.
+- (BOOL)hasPrefetchedToken;
+
 /// Whether or not the App Attest key ID created and the attestation object has been fetched.
 - (BOOL)isPrepared;
 
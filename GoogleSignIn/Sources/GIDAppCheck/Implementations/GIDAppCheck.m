@@ -20,6 +20,7 @@
 
 #import <AppCheckCore/GACAppCheck.h>
 #import <AppCheckCore/GACAppCheckSettings.h>
+#import <AppCheckCore/GACAppCheckToken.h>
 #import <AppCheckCore/GACAppCheckTokenResult.h>
 #import <AppCheckCore/GACAppAttestProvider.h>
 #import <AppCheckCore/GACAppCheckDebugProvider.h>
@@ -35,6 +36,9 @@ static NSString *const kGIDAppAttestServiceName = @"GoogleSignIn-iOS";
 static NSString *const kGIDAppAttestResourceNameFormat = @"oauthClients/%@";
 static NSString *const kGIDAppAttestBaseURL = @"https://firebaseappcheck.googleapis.com/v1";
 
+/// A prefetched token closer than this to its expiration is no longer handed out.
+static NSTimeInterval const kGIDAppCheckTokenMinimumTimeToExpire = 60;
+
 typedef void (^GIDAppCheckPrepareCompletion)(NSError * _Nullable);
 typedef void (^GIDAppCheckTokenCompletion)(GACAppCheckToken *,NSError * _Nullable);
 
@@ -45,6 +49,11 @@ typedef void (^GIDAppCheckTokenCompletion)(GACAppCheckToken *,NSError * _Nullabl
 @property(nonatomic, strong) NSUserDefaults *userDefaults;
 @property(atomic, strong) NSMutableArray<GIDAppCheckPrepareCompletion> *prepareCompletions;
 @property(atomic) BOOL preparing;
+/// A fresh limited use token that has not been handed out yet.
+@property(atomic, strong, nullable) GACAppCheckToken *prefetchedToken;
+/// Callers waiting for a limited use token, served in order as tokens arrive.
+@property(atomic, strong) NSMutableArray<GIDAppCheckTokenCompletion> *tokenCompletions;
+@property(atomic) BOOL fetchingToken;
 
 @end
 
@@ -74,6 +83,8 @@ typedef void (^GIDAppCheckTokenCompletion)(GACAppCheckToken *,NSError * _Nullabl
     _workerQueue = dispatch_queue_create("com.google.googlesignin.GIDAppCheckWorkerQueue", nil);
     _prepareCompletions = [NSMutableArray array];
     _preparing = NO;
+    _tokenCompletions = [NSMutableArray array];
+    _fetchingToken = NO;
   }
   return self;
 }
@@ -127,6 +138,11 @@ typedef void (^GIDAppCheckTokenCompletion)(GACAppCheckToken *,NSError * _Nullabl
           [self.userDefaults setBool:YES forKey:kGIDAppCheckPreparedKey];
         }
 
+        // The token fetched to prepare has not been used, so keep it for the first sign-in.
+        if (result.token && !result.error && !self.prefetchedToken) {
+          self.prefetchedToken = result.token;
+        }
+
         callbacks = [self.prepareCompletions copy];
         [self.prepareCompletions removeAllObjects];
         self.preparing = NO;
@@ -140,19 +156,104 @@ typedef void (^GIDAppCheckTokenCompletion)(GACAppCheckToken *,NSError * _Nullabl
   });
 }
 
-- (void)getLimitedUseTokenWithCompletion:(nullable GIDAppCheckTokenCompletion)completion {
+- (BOOL)getLimitedUseTokenWithCompletion:(nullable GIDAppCheckTokenCompletion)completion {
+  GACAppCheckToken *token;
+  @synchronized (self) {
+    token = [self takePrefetchedToken];
+    if (!token && completion) {
+      [self.tokenCompletions addObject:completion];
+    }
+  }
+
+  if (token) {
+    // Deliver on the main queue like tokens fetched from the provider, never on the caller's stack.
+    if (completion) {
+      dispatch_async(dispatch_get_main_queue(), ^{
+        completion(token, nil);
+      });
+    }
+    return YES;
+  }
+  [self fetchLimitedUseTokenIfNeeded];
+  return NO;
+}
+
+- (void)prefetchLimitedUseToken {
+  if ([self hasPrefetchedToken]) {
+    return;
+  }
+  [self fetchLimitedUseTokenIfNeeded];
+}
+
+- (BOOL)hasPrefetchedToken {
+  @synchronized (self) {
+    return [GIDAppCheck isFreshToken:self.prefetchedToken];
+  }
+}
+
+#pragma mark - Private methods
+
++ (BOOL)isFreshToken:(nullable GACAppCheckToken *)token {
+  return token &&
+      [token.expirationDate timeIntervalSinceNow] > kGIDAppCheckTokenMinimumTimeToExpire;
+}
+
+/// Removes and returns the prefetched token if it is still fresh. Must be called while holding the
+/// lock on `self`.
+- (nullable GACAppCheckToken *)takePrefetchedToken {
+  GACAppCheckToken *token = self.prefetchedToken;
+  self.prefetchedToken = nil;
+  return [GIDAppCheck isFreshToken:token] ? token : nil;
+}
+
+/// Starts fetching a limited use token unless a fetch is already in flight, in which case its
+/// result will be used.
+- (void)fetchLimitedUseTokenIfNeeded {
+  @synchronized (self) {
+    if (self.fetchingToken) {
+      return;
+    }
+    self.fetchingToken = YES;
+  }
+
   dispatch_async(self.workerQueue, ^{
     [self.appCheck limitedUseTokenWithCompletion:^(GACAppCheckTokenResult * _Nonnull result) {
-      if (result.token) {
-        [self.userDefaults setBool:YES forKey:kGIDAppCheckPreparedKey];
-      }
-      if (completion) {
-        completion(result.token, result.error);
-      }
+      [self didFetchTokenResult:result];
     }];
   });
 }
 
+- (void)didFetchTokenResult:(GACAppCheckTokenResult *)result {
+  if (result.token) {
+    [self.userDefaults setBool:YES forKey:kGIDAppCheckPreparedKey];
+  }
+
+  NSArray<GIDAppCheckTokenCompletion> *callbacks = @[];
+  BOOL fetchAgain = NO;
+  @synchronized (self) {
+    self.fetchingToken = NO;
+    if (!result.token || result.error) {
+      // Failures are not pooled; every waiting caller gets the placeholder token and the error.
+      callbacks = [self.tokenCompletions copy];
+      [self.tokenCompletions removeAllObjects];
+    } else if (self.tokenCompletions.count > 0) {
+      // Limited use tokens may only be used once, so each waiting caller needs a token of its own.
+      callbacks = @[ self.tokenCompletions.firstObject ];
+      [self.tokenCompletions removeObjectAtIndex:0];
+      fetchAgain = self.tokenCompletions.count > 0;
+    } else {
+      self.prefetchedToken = result.token;
+    }
+  }
+
+  for (GIDAppCheckTokenCompletion savedCompletion in callbacks) {
+    savedCompletion(result.token, result.error);
+  }
+  if (fetchAgain) {
+    [self fetchLimitedUseTokenIfNeeded];
+  }
+}
+
 + (NSString *)appAttestResourceName {
   NSString *clientID = [NSBundle.mainBundle objectForInfoDictionaryKey:kGIDConfigClientIDKey];
   return [NSString stringWithFormat:kGIDAppAttestResourceNameFormat, clientID];
@@ -41,12 +41,41 @@ static NSString *const kGenericAttribute = @"OAuth";
 // Keychain service name used to store the last used fingerprint value.
 static NSString *const kFingerprintService = @"fingerprint";
 
+// Suffix of the keychain service name used to store additional token request parameters.
+static NSString *const kAdditionalTokenRequestParametersSuffix = @"~~atrp";
+
 @interface GIDAuthStateMigration ()
 
 @property (nonatomic, strong) GTMKeychainStore *keychainStore;
 
 @end
 
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+// Returns the client ID in a fingerprint stored by an old version of the SDK or |nil| if the
+// fingerprint doesn't belong to |bundleID|. Equivalent to matching the fingerprint against
+// "^<bundle ID>-(.+)-(?:email|profile|https:\/\/).*$".
+static NSString *_Nullable GIDClientIDFromFingerprint(NSString *fingerprint,
+                                                      NSString *_Nullable bundleID) {
+  NSString *prefix = [NSString stringWithFormat:@"%@-", bundleID];
+  if (!bundleID || ![fingerprint hasPrefix:prefix]) {
+    return nil;
+  }
+  // The client ID is as long as possible, so it ends at the last scope separator.
+  NSUInteger clientIDEnd = NSNotFound;
+  for (NSString *separator in @[ @"-email", @"-profile", @"-https://" ]) {
+    NSRange range = [fingerprint rangeOfString:separator options:NSBackwardsSearch];
+    if (range.location != NSNotFound && range.location > prefix.length &&
+        (clientIDEnd == NSNotFound || range.location > clientIDEnd)) {
+      clientIDEnd = range.location;
+    }
+  }
+  if (clientIDEnd == NSNotFound) {
+    return nil;
+  }
+  return [fingerprint substringWithRange:NSMakeRange(prefix.length, clientIDEnd - prefix.length)];
+}
+#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+
 @implementation GIDAuthStateMigration
 
 - (instancetype)initWithKeychainStore:(GTMKeychainStore *)keychainStore {
@@ -140,13 +169,25 @@ static NSString *const kFingerprintService = @"fingerprint";
 // was found or the migration failed.
 - (nullable GTMAuthSession *)extractAuthSessionWithTokenURL:(NSURL *)tokenURL
                                                callbackPath:(NSString *)callbackPath {
+  // Retrieve the items written by GPPSignIn and old versions of the SDK at once.
+  NSDictionary<NSString *, NSString *> *passwords = [GIDAuthStateMigration legacyPasswords];
+
   // Retrieve the last used fingerprint.
-  NSString *fingerprint = [GIDAuthStateMigration passwordForService:kFingerprintService];
+  NSString *fingerprint = passwords[kFingerprintService];
   if (!fingerprint) {
     return nil;
   }
 
-  // Retrieve the GTMOAuth2 persistence string.
+  // Extract the client ID from the fingerprint, which has the form
+  // "<bundle ID>-<client ID>-<scopes>", where the scopes start with "email", "profile" or a URL.
+  NSString *bundleID = [[NSBundle mainBundle] bundleIdentifier];
+  NSString *clientID = GIDClientIDFromFingerprint(fingerprint, bundleID);
+  if (!clientID) {
+    return nil;
+  }
+
+  // Retrieve the GTMOAuth2 persistence string, which is stored with the keychain attributes of
+  // the keychain store, such as its access group.
   NSError *passwordError;
   NSString *GTMOAuth2PersistenceString =
       [self.keychainStore.keychainHelper passwordForService:fingerprint error:&passwordError];
@@ -154,35 +195,14 @@ static NSString *const kFingerprintService = @"fingerprint";
     return nil;
   }
 
-  // Parse the fingerprint.
-  NSString *bundleID = [[NSBundle mainBundle] bundleIdentifier];
-  NSString *pattern =
-      [NSString stringWithFormat:@"^%@-(.+)-(?:email|profile|https:\\/\\/).*$", bundleID];
-  NSError *error;
-  NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattern
-                                                                         options:0
-                                                                           error:&error];
-  NSRange matchRange = NSMakeRange(0, fingerprint.length);
-  NSArray<NSTextCheckingResult *> *matches = [regex matchesInString:fingerprint
-                                                            options:0
-                                                              range:matchRange];
-  if ([matches count] != 1) {
-    return nil;
-  }
-
-  // Extract the client ID from the fingerprint.
-  NSString *clientID = [fingerprint substringWithRange:[matches[0] rangeAtIndex:1]];
-
   // Generate the redirect URI from the extracted client ID.
   NSString *scheme =
       [[[GIDSignInCallbackSchemes alloc] initWithClientIdentifier:clientID] clientIdentifierScheme];
   NSString *redirectURI = [NSString stringWithFormat:@"%@:%@", scheme, callbackPath];
 
   // Retrieve the additional token request parameters value.
-  NSString *additionalTokenRequestParametersService =
-      [NSString stringWithFormat:@"%@~~atrp", fingerprint];
   NSString *additionalTokenRequestParameters =
-      [GIDAuthStateMigration passwordForService:additionalTokenRequestParametersService];
+      passwords[[fingerprint stringByAppendingString:kAdditionalTokenRequestParametersSuffix]];
 
   // Generate a persistence string that includes additional token request parameters if present.
   NSString *persistenceString = GTMOAuth2PersistenceString;
@@ -205,34 +225,37 @@ static NSString *const kFingerprintService = @"fingerprint";
   return authSession;
 }
 
-// Returns the password string for a given service string stored by an old version of the SDK or
-// |nil| if no matching keychain item was found.
-+ (nullable NSString *)passwordForService:(NSString *)service {
-  if (!service.length) {
-    return nil;
-  }
-  CFDataRef result = NULL;
+// Returns the passwords stored by GPPSignIn and old versions of the SDK, such as the last used
+// fingerprint and its additional token request parameters, keyed by keychain service. A single
+// keychain query reads them all, and only those items: it matches their account and generic
+// attribute, so the secrets of other keychain items are never read.
++ (NSDictionary<NSString *, NSString *> *)legacyPasswords {
+  CFArrayRef result = NULL;
   NSDictionary<id, id> *query = @{
     (id)kSecClass : (id)kSecClassGenericPassword,
     (id)kSecAttrGeneric : kGenericAttribute,
     (id)kSecAttrAccount : kOldKeychainAccount,
-    (id)kSecAttrService : service,
+    (id)kSecReturnAttributes : (id)kCFBooleanTrue,
     (id)kSecReturnData : (id)kCFBooleanTrue,
-    (id)kSecMatchLimit : (id)kSecMatchLimitOne,
+    (id)kSecMatchLimit : (id)kSecMatchLimitAll,
   };
-  OSStatus status = SecItemCopyMatching((CFDictionaryRef)query, (CFTypeRef *)&result);
-  NSData *passwordData;
-  if (status == noErr && [(__bridge NSData *)result length] > 0) {
-    passwordData = [(__bridge NSData *)result copy];
-  }
-  if (result != NULL) {
-    CFRelease(result);
-  }
-  if (!passwordData) {
-    return nil;
+  SecItemCopyMatching((CFDictionaryRef)query, (CFTypeRef *)&result);
+  NSArray<NSDictionary<id, id> *> *items = CFBridgingRelease(result);
+
+  NSMutableDictionary<NSString *, NSString *> *passwords = [NSMutableDictionary dictionary];
+  for (NSDictionary<id, id> *item in items) {
+    NSString *service = item[(id)kSecAttrService];
+    NSData *passwordData = item[(id)kSecValueData];
+    if (!service.length || !passwordData.length) {
+      continue;
+    }
+    NSString *password = [[NSString alloc] initWithData:passwordData
+                                               encoding:NSUTF8StringEncoding];
+    if (password) {
+      passwords[service] = password;
+    }
   }
-  NSString *password = [[NSString alloc] initWithData:passwordData encoding:NSUTF8StringEncoding];
-  return password;
+  return passwords;
 }
 #endif // TARGET_OS_OSX
 
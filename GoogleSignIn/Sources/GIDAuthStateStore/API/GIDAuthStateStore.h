@@ -0,0 +1,123 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class GIDUserInfoRecord;
+@class OIDAuthState;
+@class OIDTokenResponse;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A protocol for persisting the auth state of the signed-in user.
+ *
+ * The auth state is stored as two records: the whole auth state, written when the grant changes,
+ * and the latest refreshed token response, written after a token refresh. The last userinfo
+ * response of the user is kept alongside them so it can be revalidated. Implementations must be
+ * safe to call from any thread.
+ */
+@protocol GIDAuthStateStore <NSObject>
+
+/**
+ * Saves the whole auth state, replacing any saved auth state and token response.
+ *
+ * @param authState The auth state to save.
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return `YES` if the auth state was saved.
+ */
+- (BOOL)saveAuthState:(OIDAuthState *)authState error:(NSError *_Nullable *_Nullable)error;
+
+/**
+ * Retrieves the saved auth state, without applying the saved token response.
+ *
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return The saved auth state, or `nil` if there is none or it could not be read.
+ */
+- (nullable OIDAuthState *)retrieveAuthStateWithError:(NSError *_Nullable *_Nullable)error;
+
+/**
+ * Saves a refreshed token response for the saved auth state, replacing any saved token response.
+ *
+ * @param tokenResponse The token response to save.
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return `YES` if the token response was saved.
+ */
+- (BOOL)saveTokenResponse:(OIDTokenResponse *)tokenResponse
+                    error:(NSError *_Nullable *_Nullable)error;
+
+/**
+ * Retrieves the saved token response.
+ *
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return The saved token response, or `nil` if there is none or it could not be read.
+ */
+- (nullable OIDTokenResponse *)retrieveTokenResponseWithError:(NSError *_Nullable *_Nullable)error;
+
+/**
+ * Saves the userinfo response of the signed-in user, replacing any saved userinfo response.
+ *
+ * Unlike the token response, the userinfo response is kept when the auth state is saved again.
+ *
+ * @param userInfoRecord The userinfo response to save.
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return `YES` if the userinfo response was saved.
+ */
+- (BOOL)saveUserInfoRecord:(GIDUserInfoRecord *)userInfoRecord
+                     error:(NSError *_Nullable *_Nullable)error;
+
+/**
+ * Retrieves the saved userinfo response.
+ *
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return The saved userinfo response, or `nil` if there is none or it could not be read.
+ */
+- (nullable GIDUserInfoRecord *)retrieveUserInfoRecordWithError:
+    (NSError *_Nullable *_Nullable)error;
+
+/**
+ * Saves the tokens that are yet to be revoked, replacing any saved ones.
+ *
+ * The pending revocations are kept when the auth state is removed, since a user is signed out as
+ * soon as their token is queued for revocation.
+ *
+ * @param tokens The tokens to save. Saving an empty array removes the saved tokens.
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return `YES` if the tokens were saved.
+ */
+- (BOOL)savePendingRevocations:(NSArray<NSString *> *)tokens
+                         error:(NSError *_Nullable *_Nullable)error;
+
+/**
+ * Retrieves the tokens that are yet to be revoked.
+ *
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return The saved tokens, or `nil` if there are none or they could not be read.
+ */
+- (nullable NSArray<NSString *> *)retrievePendingRevocationsWithError:
+    (NSError *_Nullable *_Nullable)error;
+
+/**
+ * Removes the saved auth state, token response and userinfo response.
+ *
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return `YES` if nothing is saved anymore.
+ */
+- (BOOL)removeAuthStateWithError:(NSError *_Nullable *_Nullable)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
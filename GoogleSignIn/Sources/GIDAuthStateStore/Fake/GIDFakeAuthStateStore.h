@@ -0,0 +1,31 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDAuthStateStore/API/GIDAuthStateStore.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A fake `GIDAuthStateStore` for testing, which keeps the auth state in memory instead of the
+ * keychain.
+ *
+ * Saved records are archived, so later changes to a saved auth state are not visible until it is
+ * saved again, as with the keychain.
+ */
+@interface GIDFakeAuthStateStore : NSObject <GIDAuthStateStore>
+@end
+
+NS_ASSUME_NONNULL_END
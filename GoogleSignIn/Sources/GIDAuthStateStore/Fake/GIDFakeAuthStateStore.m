@@ -0,0 +1,143 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDAuthStateStore/Fake/GIDFakeAuthStateStore.h"
+
+#import "GoogleSignIn/Sources/GIDUserInfoRecord.h"
+
+#ifdef SWIFT_PACKAGE
+@import AppAuth;
+#else
+#import <AppAuth/AppAuth.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+@implementation GIDFakeAuthStateStore {
+  // The archived records. Guarded by @synchronized(self).
+  NSData *_authState;
+  NSData *_tokenResponse;
+  NSData *_userInfoRecord;
+  NSArray<NSString *> *_pendingRevocations;
+}
+
+- (BOOL)saveAuthState:(OIDAuthState *)authState error:(NSError *_Nullable *_Nullable)error {
+  NSData *data = [NSKeyedArchiver archivedDataWithRootObject:authState
+                                       requiringSecureCoding:YES
+                                                       error:error];
+  if (!data) {
+    return NO;
+  }
+  @synchronized(self) {
+    _authState = data;
+    _tokenResponse = nil;
+  }
+  return YES;
+}
+
+- (nullable OIDAuthState *)retrieveAuthStateWithError:(NSError *_Nullable *_Nullable)error {
+  NSData *data;
+  @synchronized(self) {
+    data = _authState;
+  }
+  if (!data) {
+    return nil;
+  }
+  return [NSKeyedUnarchiver unarchivedObjectOfClass:[OIDAuthState class] fromData:data error:error];
+}
+
+- (BOOL)saveTokenResponse:(OIDTokenResponse *)tokenResponse
+                    error:(NSError *_Nullable *_Nullable)error {
+  NSData *data = [NSKeyedArchiver archivedDataWithRootObject:tokenResponse
+                                       requiringSecureCoding:YES
+                                                       error:error];
+  if (!data) {
+    return NO;
+  }
+  @synchronized(self) {
+    _tokenResponse = data;
+  }
+  return YES;
+}
+
+- (nullable OIDTokenResponse *)retrieveTokenResponseWithError:(NSError *_Nullable *_Nullable)error {
+  NSData *data;
+  @synchronized(self) {
+    data = _tokenResponse;
+  }
+  if (!data) {
+    return nil;
+  }
+  return [NSKeyedUnarchiver unarchivedObjectOfClass:[OIDTokenResponse class]
+                                           fromData:data
+                                              error:error];
+}
+
+- (BOOL)saveUserInfoRecord:(GIDUserInfoRecord *)userInfoRecord
+                     error:(NSError *_Nullable *_Nullable)error {
+  NSData *data = [NSKeyedArchiver archivedDataWithRootObject:userInfoRecord
+                                       requiringSecureCoding:YES
+                                                       error:error];
+  if (!data) {
+    return NO;
+  }
+  @synchronized(self) {
+    _userInfoRecord = data;
+  }
+  return YES;
+}
+
+- (nullable GIDUserInfoRecord *)retrieveUserInfoRecordWithError:
+    (NSError *_Nullable *_Nullable)error {
+  NSData *data;
+  @synchronized(self) {
+    data = _userInfoRecord;
+  }
+  if (!data) {
+    return nil;
+  }
+  return [NSKeyedUnarchiver unarchivedObjectOfClass:[GIDUserInfoRecord class]
+                                           fromData:data
+                                              error:error];
+}
+
+- (BOOL)savePendingRevocations:(NSArray<NSString *> *)tokens
+                         error:(NSError *_Nullable *_Nullable)error {
+  @synchronized(self) {
+    _pendingRevocations = tokens.count ? [tokens copy] : nil;
+  }
+  return YES;
+}
+
+- (nullable NSArray<NSString *> *)retrievePendingRevocationsWithError:
+    (NSError *_Nullable *_Nullable)error {
+  @synchronized(self) {
+    return _pendingRevocations;
+  }
+}
+
+- (BOOL)removeAuthStateWithError:(NSError *_Nullable *_Nullable)error {
+  @synchronized(self) {
+    _authState = nil;
+    _tokenResponse = nil;
+    _userInfoRecord = nil;
+  }
+  return YES;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDAuthStateStore/API/GIDAuthStateStore.h"
+
+@class GTMKeychainStore;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A `GIDAuthStateStore` backed by the keychain.
+ *
+ * The auth state is saved as a `GTMAuthSession` by the given `GTMKeychainStore`. The token
+ * response, the userinfo response and the pending revocations are saved in separate keychain items,
+ * named after the store's item name with a "-tokens", "-userinfo" and "-revocations" suffix.
+ */
+@interface GIDKeychainAuthStateStore : NSObject <GIDAuthStateStore>
+
+/** The keychain store that saves the auth state. */
+@property(nonatomic, readonly) GTMKeychainStore *keychainStore;
+
+/**
+ * Creates a store that saves the auth state with the given keychain store.
+ *
+ * @param keychainStore The keychain store to save the auth state with.
+ */
+- (instancetype)initWithKeychainStore:(GTMKeychainStore *)keychainStore NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDAuthStateStore/Implementation/GIDKeychainAuthStateStore.h"
+
+@import GTMAppAuth;
+
+#import "GoogleSignIn/Sources/GIDUserInfoRecord.h"
+
+#ifdef SWIFT_PACKAGE
+@import AppAuth;
+#else
+#import <AppAuth/AppAuth.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+// The suffix of the keychain service that holds the latest refreshed token response. It is
+// appended to the keychain store's item name.
+static NSString *const kTokenResponseKeychainServiceSuffix = @"-tokens";
+
+// The suffix of the keychain service that holds the last userinfo response.
+static NSString *const kUserInfoKeychainServiceSuffix = @"-userinfo";
+
+// The suffix of the keychain service that holds the tokens that are yet to be revoked.
+static NSString *const kPendingRevocationsKeychainServiceSuffix = @"-revocations";
+
+@implementation GIDKeychainAuthStateStore
+
+- (instancetype)initWithKeychainStore:(GTMKeychainStore *)keychainStore {
+  self = [super init];
+  if (self) {
+    _keychainStore = keychainStore;
+  }
+  return self;
+}
+
+- (BOOL)saveAuthState:(OIDAuthState *)authState error:(NSError *_Nullable *_Nullable)error {
+  GTMAuthSession *authSession = [[GTMAuthSession alloc] initWithAuthState:authState];
+  NSError *saveError;
+  [_keychainStore saveAuthSession:authSession error:&saveError];
+  if (saveError) {
+    if (error) {
+      *error = saveError;
+    }
+    return NO;
+  }
+  // The auth session now holds the latest tokens.
+  [_keychainStore.keychainHelper removePasswordForService:[self tokenResponseService] error:nil];
+  return YES;
+}
+
+- (nullable OIDAuthState *)retrieveAuthStateWithError:(NSError *_Nullable *_Nullable)error {
+  return [_keychainStore retrieveAuthSessionWithError:error].authState;
+}
+
+- (BOOL)saveTokenResponse:(OIDTokenResponse *)tokenResponse
+                    error:(NSError *_Nullable *_Nullable)error {
+  return [self saveObject:tokenResponse forService:[self tokenResponseService] error:error];
+}
+
+- (nullable OIDTokenResponse *)retrieveTokenResponseWithError:(NSError *_Nullable *_Nullable)error {
+  return [self retrieveObjectOfClass:[OIDTokenResponse class]
+                          forService:[self tokenResponseService]
+                               error:error];
+}
+
+- (BOOL)saveUserInfoRecord:(GIDUserInfoRecord *)userInfoRecord
+                     error:(NSError *_Nullable *_Nullable)error {
+  return [self saveObject:userInfoRecord forService:[self userInfoService] error:error];
+}
+
+- (nullable GIDUserInfoRecord *)retrieveUserInfoRecordWithError:
+    (NSError *_Nullable *_Nullable)error {
+  return [self retrieveObjectOfClass:[GIDUserInfoRecord class]
+                          forService:[self userInfoService]
+                               error:error];
+}
+
+- (BOOL)savePendingRevocations:(NSArray<NSString *> *)tokens
+                         error:(NSError *_Nullable *_Nullable)error {
+  if (!tokens.count) {
+    [_keychainStore.keychainHelper removePasswordForService:[self pendingRevocationsService]
+                                                      error:nil];
+    return YES;
+  }
+  NSData *data = [NSJSONSerialization dataWithJSONObject:tokens options:0 error:error];
+  if (!data) {
+    return NO;
+  }
+  NSError *saveError;
+  [_keychainStore.keychainHelper
+      setPassword:[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]
+       forService:[self pendingRevocationsService]
+            error:&saveError];
+  if (saveError) {
+    if (error) {
+      *error = saveError;
+    }
+    return NO;
+  }
+  return YES;
+}
+
+- (nullable NSArray<NSString *> *)retrievePendingRevocationsWithError:
+    (NSError *_Nullable *_Nullable)error {
+  NSString *password =
+      [_keychainStore.keychainHelper passwordForService:[self pendingRevocationsService] error:nil];
+  NSData *data = [password dataUsingEncoding:NSUTF8StringEncoding];
+  if (!data) {
+    return nil;
+  }
+  return [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+}
+
+- (BOOL)removeAuthStateWithError:(NSError *_Nullable *_Nullable)error {
+  [_keychainStore.keychainHelper removePasswordForService:[self tokenResponseService] error:nil];
+  [_keychainStore.keychainHelper removePasswordForService:[self userInfoService] error:nil];
+  return [_keychainStore removeAuthSessionWithError:error];
+}
+
+#pragma mark - Private methods
+
+- (NSString *)tokenResponseService {
+  return [_keychainStore.itemName stringByAppendingString:kTokenResponseKeychainServiceSuffix];
+}
+
+- (NSString *)userInfoService {
+  return [_keychainStore.itemName stringByAppendingString:kUserInfoKeychainServiceSuffix];
+}
+
+- (NSString *)pendingRevocationsService {
+  return [_keychainStore.itemName stringByAppendingString:kPendingRevocationsKeychainServiceSuffix];
+}
+
+// Archives |object| into the keychain item of |service|.
+- (BOOL)saveObject:(id<NSSecureCoding>)object
+        forService:(NSString *)service
+             error:(NSError *_Nullable *_Nullable)error {
+  NSData *data = [NSKeyedArchiver archivedDataWithRootObject:object
+                                       requiringSecureCoding:YES
+                                                       error:error];
+  if (!data) {
+    return NO;
+  }
+  NSError *saveError;
+  [_keychainStore.keychainHelper setPassword:[data base64EncodedStringWithOptions:0]
+                                  forService:service
+                                       error:&saveError];
+  if (saveError) {
+    if (error) {
+      *error = saveError;
+    }
+    return NO;
+  }
+  return YES;
+}
+
+// Unarchives an object of class |cls| from the keychain item of |service|.
+- (nullable id)retrieveObjectOfClass:(Class)cls
+                          forService:(NSString *)service
+                               error:(NSError *_Nullable *_Nullable)error {
+  NSString *password = [_keychainStore.keychainHelper passwordForService:service error:nil];
+  NSData *data = password ? [[NSData alloc] initWithBase64EncodedString:password options:0] : nil;
+  if (!data) {
+    return nil;
+  }
+  return [NSKeyedUnarchiver unarchivedObjectOfClass:cls fromData:data error:error];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
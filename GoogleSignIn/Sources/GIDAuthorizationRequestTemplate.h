@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class GIDConfiguration;
+@class GIDSignInInternalOptions;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The parts of an authorization request that only depend on a `GIDConfiguration`.
+///
+/// A template validates the app's URL schemes and computes the redirect URL and the invariant
+/// request parameters once, so that each sign-in only adds the per-request values.
+@interface GIDAuthorizationRequestTemplate : NSObject
+
+/// The configuration the template was built for.
+@property(nonatomic, readonly) GIDConfiguration *configuration;
+
+/// The redirect URL for the configuration's client ID.
+@property(nonatomic, readonly, nullable) NSURL *redirectURL;
+
+/// The callback schemes required by the configuration but missing from the app's Info.plist.
+@property(nonatomic, readonly) NSArray<NSString *> *unsupportedSchemes;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Builds the template for `configuration`, using `callbackPath` for the redirect URL.
+- (instancetype)initWithConfiguration:(GIDConfiguration *)configuration
+                         callbackPath:(NSString *)callbackPath NS_DESIGNATED_INITIALIZER;
+
+/// Whether the template can be used for requests made with `configuration`. A template built before
+/// the registered URL schemes were invalidated is never valid.
+- (BOOL)isValidForConfiguration:(nullable GIDConfiguration *)configuration;
+
+/// Returns the additional authorization request parameters for `options`.
+///
+/// @param options The options of the sign-in flow being started.
+/// @param emmSupport The EMM support version to report, or `nil` if EMM is not supported.
+- (NSMutableDictionary<NSString *, NSString *> *)
+    additionalParametersWithOptions:(GIDSignInInternalOptions *)options
+                         emmSupport:(nullable NSString *)emmSupport;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,122 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleSignIn/Sources/GIDAuthorizationRequestTemplate.h"
+
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDConfiguration.h"
+
+#import "GoogleSignIn/Sources/GIDSignInCallbackSchemes.h"
+#import "GoogleSignIn/Sources/GIDSignInInternalOptions.h"
+#import "GoogleSignIn/Sources/GIDSignInPreferences.h"
+
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+#import "GoogleSignIn/Sources/GIDEMMSupport.h"
+#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Parameters for the auth endpoint.
+static NSString *const kAudienceParameter = @"audience";
+static NSString *const kIncludeGrantedScopesParameter = @"include_granted_scopes";
+static NSString *const kLoginHintParameter = @"login_hint";
+static NSString *const kHostedDomainParameter = @"hd";
+static NSString *const kClaimsParameter = @"claims";
+
+@implementation GIDAuthorizationRequestTemplate {
+  // Parameters that are the same for every request made with the configuration.
+  NSDictionary<NSString *, NSString *> *_configurationParameters;
+  // Logging parameters, which are applied last so that they cannot be overridden.
+  NSDictionary<NSString *, NSString *> *_loggingParameters;
+  // The Info.plist schemes |unsupportedSchemes| was computed from.
+  NSSet<NSString *> *_registeredURLSchemes;
+}
+
+- (instancetype)initWithConfiguration:(GIDConfiguration *)configuration
+                         callbackPath:(NSString *)callbackPath {
+  self = [super init];
+  if (self) {
+    _configuration = configuration;
+
+    GIDSignInCallbackSchemes *schemes =
+        [[GIDSignInCallbackSchemes alloc] initWithClientIdentifier:configuration.clientID];
+    _registeredURLSchemes = [GIDSignInCallbackSchemes registeredURLSchemes];
+    _unsupportedSchemes = [[schemes unsupportedSchemes] copy];
+    _redirectURL = [NSURL URLWithString:[NSString stringWithFormat:@"%@:%@",
+                                         [schemes clientIdentifierScheme],
+                                         callbackPath]];
+
+    NSMutableDictionary<NSString *, NSString *> *configurationParameters =
+        [NSMutableDictionary dictionaryWithCapacity:3];
+    configurationParameters[kIncludeGrantedScopesParameter] = @"true";
+    if (configuration.serverClientID) {
+      configurationParameters[kAudienceParameter] = configuration.serverClientID;
+    }
+    if (configuration.hostedDomain) {
+      configurationParameters[kHostedDomainParameter] = configuration.hostedDomain;
+    }
+    _configurationParameters = [configurationParameters copy];
+    _loggingParameters = @{
+      kSDKVersionLoggingParameter : GIDVersion(),
+      kEnvironmentLoggingParameter : GIDEnvironment(),
+    };
+  }
+  return self;
+}
+
+- (BOOL)isValidForConfiguration:(nullable GIDConfiguration *)configuration {
+  // The registered schemes are only read again after the cache is invalidated, which yields a new
+  // set, so an identity check is enough to notice that |unsupportedSchemes| is out of date.
+  if ([GIDSignInCallbackSchemes registeredURLSchemes] != _registeredURLSchemes) {
+    return NO;
+  }
+  if (configuration == _configuration) {
+    return YES;
+  }
+  // Only the values that go into the request need to match.
+  return configuration &&
+      [configuration.clientID isEqualToString:_configuration.clientID] &&
+      (configuration.serverClientID == _configuration.serverClientID ||
+          [configuration.serverClientID isEqualToString:_configuration.serverClientID]) &&
+      (configuration.hostedDomain == _configuration.hostedDomain ||
+          [configuration.hostedDomain isEqualToString:_configuration.hostedDomain]);
+}
+
+- (NSMutableDictionary<NSString *, NSString *> *)
+    additionalParametersWithOptions:(GIDSignInInternalOptions *)options
+                         emmSupport:(nullable NSString *)emmSupport {
+  NSMutableDictionary<NSString *, NSString *> *additionalParameters =
+      [_configurationParameters mutableCopy];
+  if (options.loginHint) {
+    additionalParameters[kLoginHintParameter] = options.loginHint;
+  }
+  if (options.claimsAsJSON) {
+    additionalParameters[kClaimsParameter] = options.claimsAsJSON;
+  }
+
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+  [additionalParameters addEntriesFromDictionary:
+      [GIDEMMSupport parametersWithParameters:options.extraParams
+                                   emmSupport:emmSupport
+                       isPasscodeInfoRequired:NO]];
+#elif TARGET_OS_OSX || TARGET_OS_MACCATALYST
+  [additionalParameters addEntriesFromDictionary:options.extraParams];
+#endif // TARGET_OS_OSX || TARGET_OS_MACCATALYST
+  [additionalParameters addEntriesFromDictionary:_loggingParameters];
+
+  return additionalParameters;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
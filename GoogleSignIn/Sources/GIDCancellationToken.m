@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDCancellationToken.h"
+
+#import "GoogleSignIn/Sources/GIDCancellationToken_Private.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@implementation GIDCancellationToken {
+  // Guarded by @synchronized(self).
+  BOOL _cancelled;
+  // The blocks to call on cancellation, keyed by their registration, which increases with every
+  // block added. Guarded by @synchronized(self).
+  NSMutableDictionary<NSNumber *, void (^)(void)> *_cancellationHandlers;
+  // The registration of the next block added. Guarded by @synchronized(self).
+  NSUInteger _nextRegistration;
+}
+
+- (BOOL)isCancelled {
+  @synchronized(self) {
+    return _cancelled;
+  }
+}
+
+- (void)cancel {
+  NSArray<void (^)(void)> *cancellationHandlers;
+  @synchronized(self) {
+    if (_cancelled) {
+      return;
+    }
+    _cancelled = YES;
+    // Called in the order they were added.
+    NSArray<NSNumber *> *registrations =
+        [_cancellationHandlers.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    cancellationHandlers = [_cancellationHandlers objectsForKeys:registrations
+                                                  notFoundMarker:[NSNull null]];
+    _cancellationHandlers = nil;
+  }
+  // The handlers are called outside the lock, since they may cancel other tokens.
+  for (void (^handler)(void) in cancellationHandlers) {
+    handler();
+  }
+}
+
+- (id<NSObject>)addCancellationHandler:(void (^)(void))handler {
+  NSNumber *registration;
+  @synchronized(self) {
+    registration = @(_nextRegistration++);
+    if (!_cancelled) {
+      if (!_cancellationHandlers) {
+        _cancellationHandlers = [NSMutableDictionary dictionary];
+      }
+      _cancellationHandlers[registration] = [handler copy];
+      return registration;
+    }
+  }
+  handler();
+  return registration;
+}
+
+- (void)removeCancellationHandler:(nullable id<NSObject>)registration {
+  if (!registration) {
+    return;
+  }
+  @synchronized(self) {
+    [_cancellationHandlers removeObjectForKey:(NSNumber *)registration];
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
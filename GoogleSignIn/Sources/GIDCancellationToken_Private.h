@@ -0,0 +1,35 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDCancellationToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Private |GIDCancellationToken| methods that are used in this SDK.
+@interface GIDCancellationToken ()
+
+// Adds a block that is called once the token is cancelled, on the thread that cancels it, or right
+// away if the token is already cancelled. The token keeps the block until then, so the block should
+// not retain the token. Returns a registration that removes the block.
+- (id<NSObject>)addCancellationHandler:(void (^)(void))handler;
+
+// Removes the block added with |registration|, so that a token that outlives the work it cancels
+// doesn't keep the block. Does nothing if the block was already called or removed.
+- (void)removeCancellationHandler:(nullable id<NSObject>)registration;
+
+@end
+
+NS_ASSUME_NONNULL_END
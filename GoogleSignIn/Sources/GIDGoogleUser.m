@@ -16,11 +16,14 @@
 
 #import "GoogleSignIn/Sources/GIDGoogleUser_Private.h"
 
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDCancellationToken.h"
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDConfiguration.h"
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDSignIn.h"
 
 #import "GoogleSignIn/Sources/GIDAuthentication.h"
+#import "GoogleSignIn/Sources/GIDCancellationToken_Private.h"
 #import "GoogleSignIn/Sources/GIDEMMSupport.h"
+#import "GoogleSignIn/Sources/GIDGoogleUserRecord.h"
 #import "GoogleSignIn/Sources/GIDProfileData_Private.h"
 #import "GoogleSignIn/Sources/GIDSignIn_Private.h"
 #import "GoogleSignIn/Sources/GIDSignInPreferences.h"
@@ -39,7 +42,10 @@ NS_ASSUME_NONNULL_BEGIN
 // The ID Token claim key for the hosted domain value.
 static NSString *const kHostedDomainIDTokenClaimKey = @"hd";
 
-// Key constants used for encode and decode.
+// Key constants used for encode and decode. Only the record is written, which SDK versions from
+// before it can't decode; see `GIDGoogleUserRecord`.
+static NSString *const kRecordKey = @"record";
+// Keys of the previous encoding, which are still read.
 static NSString *const kProfileDataKey = @"profileData";
 static NSString *const kAuthStateKey = @"authState";
 
@@ -67,8 +73,26 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
   // A queue for pending token refresh handlers so we don't fire multiple requests in parallel.
   // Access to this ivar should be synchronized.
   NSMutableArray<GIDGoogleUserCompletion> *_tokenRefreshHandlerQueue;
+
+  // The token of the refresh in flight, cancelled once no handler waits for it anymore.
+  // Guarded by @synchronized(_tokenRefreshHandlerQueue).
+  GIDCancellationToken *_tokenRefreshCancellationToken;
+
+  // A queue for pending profile load handlers so we don't fire multiple requests in parallel.
+  // Access to this ivar should be synchronized.
+  NSMutableArray<GIDProfileDataCompletion> *_profileLoadHandlerQueue;
+
+  // The token of the profile load in flight, cancelled once no handler waits for it anymore.
+  // Guarded by @synchronized(_profileLoadHandlerQueue).
+  GIDCancellationToken *_profileLoadCancellationToken;
+
+  // The decoded record this user was created from, until its auth state is first needed.
+  // Access to this ivar should be synchronized.
+  GIDGoogleUserRecord *_pendingRecord;
 }
 
+@synthesize fetcherAuthorizer = _fetcherAuthorizer;
+
 - (nullable NSString *)userID {
   NSString *idTokenString = self.idToken.tokenString;
   if (idTokenString) {
@@ -118,10 +142,28 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
 }
 
 - (void)refreshTokensIfNeededWithCompletion:(GIDGoogleUserCompletion)completion {
-  if (!([self.accessToken.expirationDate timeIntervalSinceNow] < kMinimalTimeToExpire ||
-      (self.idToken && [self.idToken.expirationDate timeIntervalSinceNow] < kMinimalTimeToExpire))) {
+  [self refreshTokensIfNeededWithCancellationToken:[[GIDCancellationToken alloc] init]
+                                        completion:completion];
+}
+
+- (void)refreshTokensIfNeededWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                                        completion:(GIDGoogleUserCompletion)completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
+  __weak GIDCancellationToken *weakCancellationToken = cancellationToken;
+  // The caller's token may outlive the refresh, so the handler removes itself from it once called.
+  __block id<NSObject> registration;
+  GIDGoogleUserCompletion handler = ^(GIDGoogleUser *_Nullable user, NSError *_Nullable error) {
+    GIDCancellationToken *strongCancellationToken = weakCancellationToken;
+    if (!strongCancellationToken.isCancelled) {
+      completion(user, error);
+    }
+    [strongCancellationToken removeCancellationHandler:registration];
+  };
+  if (![self needsTokenRefresh]) {
     dispatch_async(dispatch_get_main_queue(), ^{
-      completion(self, nil);
+      handler(self, nil);
     });
     return;
   }
@@ -130,18 +172,23 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
                                          code:kGIDSignInErrorCodeRefreshTokenExpired
                                      userInfo:nil];
     dispatch_async(dispatch_get_main_queue(), ^{
-      completion(nil, error);
+      handler(nil, error);
     });
     return;
   }
 
+  registration = [self removeHandler:handler
+      fromTokenRefreshHandlerQueueWhenCancelled:cancellationToken];
+  GIDCancellationToken *tokenRefresh;
   @synchronized (_tokenRefreshHandlerQueue) {
     // Push the handler into the callback queue.
-    [_tokenRefreshHandlerQueue addObject:[completion copy]];
+    [_tokenRefreshHandlerQueue addObject:handler];
     if (_tokenRefreshHandlerQueue.count > 1) {
       // This is not the first handler in the queue, no fetch is needed.
       return;
     }
+    tokenRefresh = [[GIDCancellationToken alloc] init];
+    _tokenRefreshCancellationToken = tokenRefresh;
   }
   // This is the first handler in the queue, a fetch is needed.
   NSMutableDictionary *additionalParameters = [@{} mutableCopy];
@@ -162,6 +209,8 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
                  originalAuthorizationResponse:self.authState.lastAuthorizationResponse
                                       callback:^(OIDTokenResponse *_Nullable tokenResponse,
                                                  NSError *_Nullable error) {
+    // Token requests can't be stopped, so the response of an abandoned refresh is still applied:
+    // the server may have rotated the refresh token, and dropping the response would lose it.
     if (tokenResponse) {
       [self.authState updateWithTokenResponse:tokenResponse error:nil];
     } else {
@@ -169,31 +218,17 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
         [self.authState updateWithAuthorizationError:error];
       }
     }
+    // No handler waits for an abandoned refresh. A refresh requested since then has started a new
+    // token request.
+    if (tokenRefresh.isCancelled) {
+      return;
+    }
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
     [GIDEMMSupport handleTokenFetchEMMError:error completion:^(NSError *_Nullable error) {
-      // Process the handler queue to call back.
-      NSArray<GIDGoogleUserCompletion> *refreshTokensHandlerQueue;
-      @synchronized(self->_tokenRefreshHandlerQueue) {
-        refreshTokensHandlerQueue = [self->_tokenRefreshHandlerQueue copy];
-        [self->_tokenRefreshHandlerQueue removeAllObjects];
-      }
-      for (GIDGoogleUserCompletion completion in refreshTokensHandlerQueue) {
-        dispatch_async(dispatch_get_main_queue(), ^{
-          completion(error ? nil : self, error);
-        });
-      }
+      [self finishTokenRefresh:tokenRefresh withError:error];
     }];
 #elif TARGET_OS_OSX || TARGET_OS_MACCATALYST
-    NSArray<GIDGoogleUserCompletion> *refreshTokensHandlerQueue;
-    @synchronized(self->_tokenRefreshHandlerQueue) {
-      refreshTokensHandlerQueue = [self->_tokenRefreshHandlerQueue copy];
-      [self->_tokenRefreshHandlerQueue removeAllObjects];
-    }
-    for (GIDGoogleUserCompletion completion in refreshTokensHandlerQueue) {
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(error ? nil : self, error);
-      });
-    }
+    [self finishTokenRefresh:tokenRefresh withError:error];
 #endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
   }];
 }
@@ -202,6 +237,51 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
   return ((GTMAuthSession *)self.fetcherAuthorizer).authState;
 }
 
+- (id<GTMFetcherAuthorizationProtocol>)fetcherAuthorizer {
+  @synchronized(self) {
+    [self setUpPendingRecord];
+    return _fetcherAuthorizer;
+  }
+}
+
+// A user decoded from a record writes that record back unchanged until it is mutated, so each
+// setter first builds the auth state from the record and then encodes its own state.
+
+- (void)setFetcherAuthorizer:(id<GTMFetcherAuthorizationProtocol>)fetcherAuthorizer {
+  @synchronized(self) {
+    _pendingRecord = nil;
+    _fetcherAuthorizer = fetcherAuthorizer;
+  }
+}
+
+- (void)setProfile:(nullable GIDProfileData *)profile {
+  @synchronized(self) {
+    [self setUpPendingRecord];
+    _profile = profile;
+  }
+}
+
+- (void)setAccessToken:(GIDToken *)accessToken {
+  @synchronized(self) {
+    [self setUpPendingRecord];
+    _accessToken = accessToken;
+  }
+}
+
+- (void)setRefreshToken:(GIDToken *)refreshToken {
+  @synchronized(self) {
+    [self setUpPendingRecord];
+    _refreshToken = refreshToken;
+  }
+}
+
+- (void)setIdToken:(nullable GIDToken *)idToken {
+  @synchronized(self) {
+    [self setUpPendingRecord];
+    _idToken = idToken;
+  }
+}
+
 - (void)addScopes:(NSArray<NSString *> *)scopes
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
     presentingViewController:(UIViewController *)presentingViewController
@@ -210,13 +290,37 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
 #endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
                   completion:(nullable void (^)(GIDSignInResult *_Nullable signInResult,
                                                 NSError *_Nullable error))completion {
+  [self addScopes:scopes
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+      presentingViewController:presentingViewController
+#elif TARGET_OS_OSX
+              presentingWindow:presentingWindow
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+             cancellationToken:[[GIDCancellationToken alloc] init]
+                    completion:completion];
+}
+
+- (void)addScopes:(NSArray<NSString *> *)scopes
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+    presentingViewController:(UIViewController *)presentingViewController
+#elif TARGET_OS_OSX
+            presentingWindow:(NSWindow *)presentingWindow
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+           cancellationToken:(GIDCancellationToken *)cancellationToken
+                  completion:(nullable void (^)(GIDSignInResult *_Nullable signInResult,
+                                                NSError *_Nullable error))completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
   if (self != GIDSignIn.sharedInstance.currentUser) {
     NSError *error = [NSError errorWithDomain:kGIDSignInErrorDomain
                                          code:kGIDSignInErrorCodeMismatchWithCurrentUser
                                      userInfo:nil];
     if (completion) {
       dispatch_async(dispatch_get_main_queue(), ^{
-        completion(nil, error);
+        if (!cancellationToken.isCancelled) {
+          completion(nil, error);
+        }
       });
     }
     return;
@@ -228,11 +332,168 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
 #elif TARGET_OS_OSX
                      presentingWindow:presentingWindow
 #endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+                    cancellationToken:cancellationToken
                            completion:completion];
 }
 
+- (void)loadProfileWithCompletion:(nullable GIDProfileDataCompletion)completion {
+  [self loadProfileWithCancellationToken:[[GIDCancellationToken alloc] init]
+                              completion:completion];
+}
+
+- (void)loadProfileWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                              completion:(nullable GIDProfileDataCompletion)completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
+  __weak GIDCancellationToken *weakCancellationToken = cancellationToken;
+  // The caller's token may outlive the load, so the handler removes itself from it once called.
+  __block id<NSObject> registration;
+  GIDProfileDataCompletion handler = ^(GIDProfileData *_Nullable profile,
+                                       NSError *_Nullable error) {
+    GIDCancellationToken *strongCancellationToken = weakCancellationToken;
+    if (completion && !strongCancellationToken.isCancelled) {
+      completion(profile, error);
+    }
+    [strongCancellationToken removeCancellationHandler:registration];
+  };
+  GIDProfileData *profile = self.profile;
+  if (profile) {
+    if (completion) {
+      dispatch_async(dispatch_get_main_queue(), ^{
+        handler(profile, nil);
+      });
+    }
+    return;
+  }
+
+  registration = [self removeHandler:handler
+      fromProfileLoadHandlerQueueWhenCancelled:cancellationToken];
+  GIDCancellationToken *profileLoad;
+  @synchronized (_profileLoadHandlerQueue) {
+    // Push the handler into the callback queue.
+    [_profileLoadHandlerQueue addObject:handler];
+    if (_profileLoadHandlerQueue.count > 1) {
+      // This is not the first handler in the queue, no fetch is needed.
+      return;
+    }
+    profileLoad = [[GIDCancellationToken alloc] init];
+    _profileLoadCancellationToken = profileLoad;
+  }
+  // This is the first handler in the queue, a fetch is needed.
+  OIDIDToken *idToken = [[OIDIDToken alloc] initWithIDTokenString:self.idToken.tokenString];
+  GIDCancellationToken *fetchCancellationToken =
+      [GIDSignIn.sharedInstance fetchProfileDataWithAuthState:self.authState
+                                                      idToken:idToken
+                                                   completion:^(GIDProfileData *_Nullable profile,
+                                                                NSError *_Nullable error) {
+    if (profile) {
+      self.profile = profile;
+    }
+    // Process the handler queue to call back.
+    NSArray<GIDProfileDataCompletion> *profileLoadHandlerQueue;
+    @synchronized(self->_profileLoadHandlerQueue) {
+      if (self->_profileLoadCancellationToken != profileLoad) {
+        return;
+      }
+      profileLoadHandlerQueue = [self->_profileLoadHandlerQueue copy];
+      [self->_profileLoadHandlerQueue removeAllObjects];
+      self->_profileLoadCancellationToken = nil;
+    }
+    for (GIDProfileDataCompletion completion in profileLoadHandlerQueue) {
+      dispatch_async(dispatch_get_main_queue(), ^{
+        completion(profile, error);
+      });
+    }
+  }];
+  [profileLoad addCancellationHandler:^{
+    [fetchCancellationToken cancel];
+  }];
+}
+
 #pragma mark - Private Methods
 
+// Builds the auth state of a user decoded from a record on first use. The tokens and profile were
+// already set from the record, so they are not updated again. Must be called within
+// @synchronized(self).
+- (void)setUpPendingRecord {
+  if (_pendingRecord) {
+    GIDGoogleUserRecord *record = _pendingRecord;
+    _pendingRecord = nil;
+    [self setUpAuthSessionWithAuthState:[record authState]];
+  }
+}
+
+// Calls back the handlers waiting for |tokenRefresh|, unless it was abandoned.
+- (void)finishTokenRefresh:(GIDCancellationToken *)tokenRefresh
+                 withError:(nullable NSError *)error {
+  NSArray<GIDGoogleUserCompletion> *refreshTokensHandlerQueue;
+  @synchronized(_tokenRefreshHandlerQueue) {
+    if (_tokenRefreshCancellationToken != tokenRefresh) {
+      return;
+    }
+    refreshTokensHandlerQueue = [_tokenRefreshHandlerQueue copy];
+    [_tokenRefreshHandlerQueue removeAllObjects];
+    _tokenRefreshCancellationToken = nil;
+  }
+  for (GIDGoogleUserCompletion completion in refreshTokensHandlerQueue) {
+    dispatch_async(dispatch_get_main_queue(), ^{
+      completion(error ? nil : self, error);
+    });
+  }
+}
+
+// Removes |handler| from the token refresh handler queue once |cancellationToken| is cancelled,
+// abandoning the refresh in flight if no other handler waits for it. Returns the registration of
+// the cancellation handler.
+- (id<NSObject>)removeHandler:(GIDGoogleUserCompletion)handler
+    fromTokenRefreshHandlerQueueWhenCancelled:(GIDCancellationToken *)cancellationToken {
+  __weak GIDGoogleUser *weakSelf = self;
+  return [cancellationToken addCancellationHandler:^{
+    GIDGoogleUser *strongSelf = weakSelf;
+    if (!strongSelf) {
+      return;
+    }
+    GIDCancellationToken *abandonedTokenRefresh;
+    @synchronized(strongSelf->_tokenRefreshHandlerQueue) {
+      [strongSelf->_tokenRefreshHandlerQueue removeObjectIdenticalTo:handler];
+      if (!strongSelf->_tokenRefreshHandlerQueue.count) {
+        abandonedTokenRefresh = strongSelf->_tokenRefreshCancellationToken;
+        strongSelf->_tokenRefreshCancellationToken = nil;
+      }
+    }
+    [abandonedTokenRefresh cancel];
+  }];
+}
+
+// Removes |handler| from the profile load handler queue once |cancellationToken| is cancelled,
+// stopping the profile fetch if no other handler waits for it. Returns the registration of the
+// cancellation handler.
+- (id<NSObject>)removeHandler:(GIDProfileDataCompletion)handler
+    fromProfileLoadHandlerQueueWhenCancelled:(GIDCancellationToken *)cancellationToken {
+  __weak GIDGoogleUser *weakSelf = self;
+  return [cancellationToken addCancellationHandler:^{
+    GIDGoogleUser *strongSelf = weakSelf;
+    if (!strongSelf) {
+      return;
+    }
+    GIDCancellationToken *abandonedProfileLoad;
+    @synchronized(strongSelf->_profileLoadHandlerQueue) {
+      [strongSelf->_profileLoadHandlerQueue removeObjectIdenticalTo:handler];
+      if (!strongSelf->_profileLoadHandlerQueue.count) {
+        abandonedProfileLoad = strongSelf->_profileLoadCancellationToken;
+        strongSelf->_profileLoadCancellationToken = nil;
+      }
+    }
+    [abandonedProfileLoad cancel];
+  }];
+}
+
+- (BOOL)needsTokenRefresh {
+  return [self.accessToken.expirationDate timeIntervalSinceNow] < kMinimalTimeToExpire ||
+      (self.idToken && [self.idToken.expirationDate timeIntervalSinceNow] < kMinimalTimeToExpire);
+}
+
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
 - (nullable NSString *)emmSupport {
   return self.authState.lastAuthorizationResponse
@@ -245,27 +506,47 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
   self = [super init];
   if (self) {
     _tokenRefreshHandlerQueue = [[NSMutableArray alloc] init];
+    _profileLoadHandlerQueue = [[NSMutableArray alloc] init];
     _profile = profileData;
-    
-    GTMAuthSession *authSession = [[GTMAuthSession alloc] initWithAuthState:authState];
-#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
-    _authSessionDelegate = [[GIDEMMSupport alloc] init];
-    authSession.delegate = _authSessionDelegate;
-#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
-    authSession.authState.stateChangeDelegate = self;
-    _fetcherAuthorizer = authSession;
-    
+    [self setUpAuthSessionWithAuthState:authState];
     [self updateTokensWithAuthState:authState];
   }
   return self;
 }
 
+- (instancetype)initWithRecord:(GIDGoogleUserRecord *)record {
+  self = [super init];
+  if (self) {
+    _tokenRefreshHandlerQueue = [[NSMutableArray alloc] init];
+    _profileLoadHandlerQueue = [[NSMutableArray alloc] init];
+    _profile = record.profileData;
+    _accessToken = record.accessToken;
+    _refreshToken = record.refreshToken;
+    _idToken = record.idToken;
+    _pendingRecord = record;
+  }
+  return self;
+}
+
+- (void)setUpAuthSessionWithAuthState:(OIDAuthState *)authState {
+  GTMAuthSession *authSession = [[GTMAuthSession alloc] initWithAuthState:authState];
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+  _authSessionDelegate = [[GIDEMMSupport alloc] init];
+  authSession.delegate = _authSessionDelegate;
+#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+  authSession.authState.stateChangeDelegate = self;
+  _fetcherAuthorizer = authSession;
+}
+
 - (void)updateWithTokenResponse:(OIDTokenResponse *)tokenResponse
           authorizationResponse:(OIDAuthorizationResponse *)authorizationResponse
                     profileData:(nullable GIDProfileData *)profileData {
   @synchronized(self) {
-    _profile = profileData;
-    
+    // Only notify observers of the profile when it actually changed.
+    if (profileData != _profile && ![profileData isEqual:_profile]) {
+      self.profile = profileData;
+    }
+
     // We don't want to trigger the delegate before we update authState completely. So we unset the
     // delegate before the first update. Also the order of updates is important because
     // `updateWithAuthorizationResponse` would clear the last token reponse and refresh token.
@@ -341,13 +622,24 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
 }
 
 - (nullable instancetype)initWithCoder:(NSCoder *)decoder {
+  if ([decoder containsValueForKey:kRecordKey]) { // Current encoding
+    NSData *data = [decoder decodeObjectOfClass:[NSData class] forKey:kRecordKey];
+    GIDGoogleUserRecord *record = data ? [[GIDGoogleUserRecord alloc] initWithData:data] : nil;
+    if (!record) {
+      return nil;
+    }
+    return [self initWithRecord:record];
+  }
+
+  // Archives written before the record format are decoded in full. Encoding the user again
+  // writes the record, so this only happens once per archive.
   self = [super init];
   if (self) {
     GIDProfileData *profile =
         [decoder decodeObjectOfClass:[GIDProfileData class] forKey:kProfileDataKey];
     
     OIDAuthState *authState;
-    if ([decoder containsValueForKey:kAuthStateKey]) { // Current encoding
+    if ([decoder containsValueForKey:kAuthStateKey]) { // Previous encoding
       authState = [decoder decodeObjectOfClass:[OIDAuthState class] forKey:kAuthStateKey];
     } else { // Old encoding
       GIDAuthentication *authentication = [decoder decodeObjectOfClass:[GIDAuthentication class]
@@ -361,8 +653,18 @@ static NSTimeInterval const kMinimalTimeToExpire = 60.0;
 }
 
 - (void)encodeWithCoder:(NSCoder *)encoder {
-  [encoder encodeObject:_profile forKey:kProfileDataKey];
-  [encoder encodeObject:self.authState forKey:kAuthStateKey];
+  GIDGoogleUserRecord *record;
+  @synchronized(self) {
+    // An unchanged decoded user writes back the record it came from.
+    record = _pendingRecord;
+  }
+  if (!record) {
+    record = [[GIDGoogleUserRecord alloc] initWithAuthState:self.authState
+                                 refreshTokenExpirationDate:self.refreshToken.expirationDate
+                                      idTokenExpirationDate:self.idToken.expirationDate
+                                                profileData:_profile];
+  }
+  [encoder encodeObject:record.data forKey:kRecordKey];
 }
 
 @end
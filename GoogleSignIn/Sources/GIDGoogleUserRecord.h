@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class GIDProfileData;
+@class GIDToken;
+@class OIDAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The version written by `GIDGoogleUserRecord`. Records with a newer version are rejected.
+extern const uint8_t kGIDGoogleUserRecordVersion;
+
+/// The state needed to resume a `GIDGoogleUser`, in a compact, versioned binary format.
+///
+/// A record keeps the tokens and their expiration dates, the granted scopes, the client
+/// configuration and the profile. It does not keep the original authorization and token exchange
+/// responses, so the auth state built from it can refresh tokens but not replay the sign-in.
+///
+/// The format is a 4-byte magic and a version byte, followed by fields stored as a tag byte, a
+/// little-endian 32-bit length and the value. Readers ignore tags they don't know, but keep their
+/// bytes so that a decoded record written back unchanged still has them.
+///
+/// SDK versions from before this format can't read it: once a user has been archived as a record,
+/// downgrading the SDK loses the signed-in user.
+@interface GIDGoogleUserRecord : NSObject
+
+/// The encoded record.
+@property(nonatomic, readonly) NSData *data;
+
+/// The profile stored in the record.
+@property(nonatomic, readonly, nullable) GIDProfileData *profileData;
+
+/// The access token stored in the record.
+@property(nonatomic, readonly) GIDToken *accessToken;
+
+/// The refresh token stored in the record.
+@property(nonatomic, readonly) GIDToken *refreshToken;
+
+/// The ID token stored in the record.
+@property(nonatomic, readonly, nullable) GIDToken *idToken;
+
+/// Captures the resumable parts of `authState` and `profileData`.
+///
+/// The refresh and ID token expiration dates are passed in, since the auth state only has them
+/// relative to when its token response arrived.
+- (instancetype)initWithAuthState:(OIDAuthState *)authState
+       refreshTokenExpirationDate:(nullable NSDate *)refreshTokenExpirationDate
+            idTokenExpirationDate:(nullable NSDate *)idTokenExpirationDate
+                      profileData:(nullable GIDProfileData *)profileData;
+
+/// Parses an encoded record, returning `nil` if the data is malformed or from a newer version.
+- (nullable instancetype)initWithData:(NSData *)data;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Builds a new auth state from the record.
+- (OIDAuthState *)authState;
+
+@end
+
+NS_ASSUME_NONNULL_END
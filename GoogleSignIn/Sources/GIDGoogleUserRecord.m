@@ -0,0 +1,482 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDGoogleUserRecord.h"
+
+#include <math.h>
+#include <string.h>
+
+#import "GoogleSignIn/Sources/GIDProfileData_Private.h"
+#import "GoogleSignIn/Sources/GIDToken_Private.h"
+
+#ifdef SWIFT_PACKAGE
+@import AppAuth;
+#else
+#import <AppAuth/AppAuth.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+const uint8_t kGIDGoogleUserRecordVersion = 1;
+
+/// The bytes every record starts with.
+static const char kRecordMagic[4] = {'G', 'I', 'D', 'U'};
+
+/// The size of the header: the magic followed by the version byte.
+static const NSUInteger kRecordHeaderLength = sizeof(kRecordMagic) + 1;
+
+// Token response parameter names.
+static NSString *const kAccessTokenParameter = @"access_token";
+static NSString *const kExpiresInParameter = @"expires_in";
+static NSString *const kTokenTypeParameter = @"token_type";
+static NSString *const kIDTokenParameter = @"id_token";
+static NSString *const kScopeParameter = @"scope";
+static NSString *const kRefreshTokenParameter = @"refresh_token";
+static NSString *const kRefreshTokenExpiresInParameter = @"refresh_token_expires_in";
+
+/// The fields of a record. Tags are never reused; new fields get new tags.
+typedef NS_ENUM(uint8_t, GIDGoogleUserRecordField) {
+  // Strings.
+  GIDGoogleUserRecordFieldAccessToken = 1,
+  GIDGoogleUserRecordFieldRefreshToken = 2,
+  GIDGoogleUserRecordFieldIDToken = 3,
+  GIDGoogleUserRecordFieldTokenType = 4,
+  GIDGoogleUserRecordFieldGrantedScope = 5,
+  GIDGoogleUserRecordFieldRequestedScope = 6,
+  GIDGoogleUserRecordFieldClientID = 7,
+  GIDGoogleUserRecordFieldClientSecret = 8,
+  GIDGoogleUserRecordFieldRedirectURL = 9,
+  GIDGoogleUserRecordFieldNonce = 10,
+  GIDGoogleUserRecordFieldAuthorizationEndpoint = 11,
+  GIDGoogleUserRecordFieldTokenEndpoint = 12,
+  GIDGoogleUserRecordFieldProfileEmail = 13,
+  GIDGoogleUserRecordFieldProfileName = 14,
+  GIDGoogleUserRecordFieldProfileGivenName = 15,
+  GIDGoogleUserRecordFieldProfileFamilyName = 16,
+  GIDGoogleUserRecordFieldProfileImageURL = 17,
+  // Dates.
+  GIDGoogleUserRecordFieldAccessTokenExpirationDate = 64,
+  GIDGoogleUserRecordFieldRefreshTokenExpirationDate = 65,
+  GIDGoogleUserRecordFieldIDTokenExpirationDate = 66,
+  // String to string maps.
+  GIDGoogleUserRecordFieldAuthorizationRequestParameters = 128,
+  GIDGoogleUserRecordFieldAuthorizationResponseParameters = 129,
+  GIDGoogleUserRecordFieldTokenRequestParameters = 130,
+};
+
+typedef NS_ENUM(NSInteger, GIDGoogleUserRecordValueType) {
+  GIDGoogleUserRecordValueTypeString,
+  GIDGoogleUserRecordValueTypeDate,
+  GIDGoogleUserRecordValueTypeMap,
+  // Fields from a newer writer, kept as their raw bytes so they survive being written back.
+  GIDGoogleUserRecordValueTypeUnknown,
+};
+
+static GIDGoogleUserRecordValueType GIDGoogleUserRecordValueTypeForTag(uint8_t tag) {
+  switch ((GIDGoogleUserRecordField)tag) {
+    case GIDGoogleUserRecordFieldAccessToken:
+    case GIDGoogleUserRecordFieldRefreshToken:
+    case GIDGoogleUserRecordFieldIDToken:
+    case GIDGoogleUserRecordFieldTokenType:
+    case GIDGoogleUserRecordFieldGrantedScope:
+    case GIDGoogleUserRecordFieldRequestedScope:
+    case GIDGoogleUserRecordFieldClientID:
+    case GIDGoogleUserRecordFieldClientSecret:
+    case GIDGoogleUserRecordFieldRedirectURL:
+    case GIDGoogleUserRecordFieldNonce:
+    case GIDGoogleUserRecordFieldAuthorizationEndpoint:
+    case GIDGoogleUserRecordFieldTokenEndpoint:
+    case GIDGoogleUserRecordFieldProfileEmail:
+    case GIDGoogleUserRecordFieldProfileName:
+    case GIDGoogleUserRecordFieldProfileGivenName:
+    case GIDGoogleUserRecordFieldProfileFamilyName:
+    case GIDGoogleUserRecordFieldProfileImageURL:
+      return GIDGoogleUserRecordValueTypeString;
+    case GIDGoogleUserRecordFieldAccessTokenExpirationDate:
+    case GIDGoogleUserRecordFieldRefreshTokenExpirationDate:
+    case GIDGoogleUserRecordFieldIDTokenExpirationDate:
+      return GIDGoogleUserRecordValueTypeDate;
+    case GIDGoogleUserRecordFieldAuthorizationRequestParameters:
+    case GIDGoogleUserRecordFieldAuthorizationResponseParameters:
+    case GIDGoogleUserRecordFieldTokenRequestParameters:
+      return GIDGoogleUserRecordValueTypeMap;
+  }
+  return GIDGoogleUserRecordValueTypeUnknown;
+}
+
+#pragma mark - Writing
+
+static void GIDRecordAppendLength(NSMutableData *data, NSUInteger length) {
+  uint32_t littleEndian = CFSwapInt32HostToLittle((uint32_t)length);
+  [data appendBytes:&littleEndian length:sizeof(littleEndian)];
+}
+
+static void GIDRecordAppendString(NSMutableData *data, NSString *string) {
+  NSData *utf8 = [string dataUsingEncoding:NSUTF8StringEncoding];
+  GIDRecordAppendLength(data, utf8.length);
+  [data appendData:utf8];
+}
+
+static void GIDRecordAppendField(NSMutableData *data, uint8_t tag, id value) {
+  NSMutableData *encoded = [NSMutableData data];
+  switch (GIDGoogleUserRecordValueTypeForTag(tag)) {
+    case GIDGoogleUserRecordValueTypeString: {
+      [encoded appendData:[(NSString *)value dataUsingEncoding:NSUTF8StringEncoding]];
+      break;
+    }
+    case GIDGoogleUserRecordValueTypeDate: {
+      double seconds = [(NSDate *)value timeIntervalSince1970];
+      uint64_t bits;
+      memcpy(&bits, &seconds, sizeof(bits));
+      bits = CFSwapInt64HostToLittle(bits);
+      [encoded appendBytes:&bits length:sizeof(bits)];
+      break;
+    }
+    case GIDGoogleUserRecordValueTypeMap: {
+      [(NSDictionary<NSString *, NSString *> *)value
+          enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *object, BOOL *stop) {
+        GIDRecordAppendString(encoded, key);
+        GIDRecordAppendString(encoded, object);
+      }];
+      break;
+    }
+    case GIDGoogleUserRecordValueTypeUnknown: {
+      [encoded appendData:(NSData *)value];
+      break;
+    }
+  }
+  [data appendBytes:&tag length:1];
+  GIDRecordAppendLength(data, encoded.length);
+  [data appendData:encoded];
+}
+
+#pragma mark - Reading
+
+/// A cursor over the bytes of a record.
+typedef struct {
+  const uint8_t *bytes;
+  NSUInteger remaining;
+} GIDRecordReader;
+
+static BOOL GIDRecordReadLength(GIDRecordReader *reader, NSUInteger *length) {
+  uint32_t littleEndian;
+  if (reader->remaining < sizeof(littleEndian)) {
+    return NO;
+  }
+  memcpy(&littleEndian, reader->bytes, sizeof(littleEndian));
+  reader->bytes += sizeof(littleEndian);
+  reader->remaining -= sizeof(littleEndian);
+  *length = CFSwapInt32LittleToHost(littleEndian);
+  return *length <= reader->remaining;
+}
+
+static NSString *_Nullable GIDRecordReadBytesAsString(GIDRecordReader *reader,
+                                                      NSUInteger length) {
+  NSString *string = [[NSString alloc] initWithBytes:reader->bytes
+                                              length:length
+                                            encoding:NSUTF8StringEncoding];
+  reader->bytes += length;
+  reader->remaining -= length;
+  return string;
+}
+
+static NSString *_Nullable GIDRecordReadString(GIDRecordReader *reader) {
+  NSUInteger length;
+  if (!GIDRecordReadLength(reader, &length)) {
+    return nil;
+  }
+  return GIDRecordReadBytesAsString(reader, length);
+}
+
+/// Reads a field value of `length` bytes, or returns `nil` if it is malformed. The value of a tag
+/// this version doesn't know is returned as its raw bytes.
+static id _Nullable GIDRecordReadValue(GIDRecordReader *reader, uint8_t tag, NSUInteger length) {
+  switch (GIDGoogleUserRecordValueTypeForTag(tag)) {
+    case GIDGoogleUserRecordValueTypeString:
+      return GIDRecordReadBytesAsString(reader, length);
+    case GIDGoogleUserRecordValueTypeDate: {
+      uint64_t bits;
+      if (length != sizeof(bits)) {
+        return nil;
+      }
+      memcpy(&bits, reader->bytes, sizeof(bits));
+      reader->bytes += length;
+      reader->remaining -= length;
+      bits = CFSwapInt64LittleToHost(bits);
+      double seconds;
+      memcpy(&seconds, &bits, sizeof(seconds));
+      return isfinite(seconds) ? [NSDate dateWithTimeIntervalSince1970:seconds] : nil;
+    }
+    case GIDGoogleUserRecordValueTypeMap: {
+      GIDRecordReader mapReader = { reader->bytes, length };
+      reader->bytes += length;
+      reader->remaining -= length;
+      NSMutableDictionary<NSString *, NSString *> *map = [NSMutableDictionary dictionary];
+      while (mapReader.remaining) {
+        NSString *key = GIDRecordReadString(&mapReader);
+        NSString *value = key ? GIDRecordReadString(&mapReader) : nil;
+        if (!value) {
+          return nil;
+        }
+        map[key] = value;
+      }
+      return [map copy];
+    }
+    case GIDGoogleUserRecordValueTypeUnknown: {
+      NSData *value = [NSData dataWithBytes:reader->bytes length:length];
+      reader->bytes += length;
+      reader->remaining -= length;
+      return value;
+    }
+  }
+}
+
+/// Returns the entries of `parameters` whose keys and values are both strings, or `nil` if there
+/// are none.
+static NSDictionary<NSString *, NSString *> *_Nullable GIDStringParameters(
+    NSDictionary<NSString *, NSObject *> *_Nullable parameters) {
+  NSMutableDictionary<NSString *, NSString *> *strings = [NSMutableDictionary dictionary];
+  [parameters enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSObject *value, BOOL *stop) {
+    if ([key isKindOfClass:[NSString class]] && [value isKindOfClass:[NSString class]]) {
+      strings[key] = (NSString *)value;
+    }
+  }];
+  return strings.count ? [strings copy] : nil;
+}
+
+/// Returns the whole seconds from now until `date`, as used by `expires_in` parameters.
+static NSNumber *GIDExpiresInWithDate(NSDate *date) {
+  return @(llround([date timeIntervalSinceNow]));
+}
+
+@implementation GIDGoogleUserRecord {
+  NSDictionary<NSNumber *, id> *_fields;
+  // The encoded record, produced on first use for records built from an auth state.
+  NSData *_data;
+}
+
+- (instancetype)initWithAuthState:(OIDAuthState *)authState
+       refreshTokenExpirationDate:(nullable NSDate *)refreshTokenExpirationDate
+            idTokenExpirationDate:(nullable NSDate *)idTokenExpirationDate
+                      profileData:(nullable GIDProfileData *)profileData {
+  self = [super init];
+  if (self) {
+    OIDTokenResponse *tokenResponse = authState.lastTokenResponse;
+    OIDAuthorizationResponse *authorizationResponse = authState.lastAuthorizationResponse;
+    OIDAuthorizationRequest *authorizationRequest = authorizationResponse.request;
+    OIDServiceConfiguration *configuration = authorizationRequest.configuration;
+
+    NSMutableDictionary<NSNumber *, id> *fields = [NSMutableDictionary dictionary];
+    fields[@(GIDGoogleUserRecordFieldAccessToken)] = tokenResponse.accessToken;
+    fields[@(GIDGoogleUserRecordFieldAccessTokenExpirationDate)] =
+        tokenResponse.accessTokenExpirationDate;
+    fields[@(GIDGoogleUserRecordFieldRefreshToken)] = authState.refreshToken;
+    fields[@(GIDGoogleUserRecordFieldRefreshTokenExpirationDate)] = refreshTokenExpirationDate;
+    fields[@(GIDGoogleUserRecordFieldIDToken)] = tokenResponse.idToken;
+    fields[@(GIDGoogleUserRecordFieldIDTokenExpirationDate)] = idTokenExpirationDate;
+    fields[@(GIDGoogleUserRecordFieldTokenType)] = tokenResponse.tokenType;
+    fields[@(GIDGoogleUserRecordFieldGrantedScope)] = tokenResponse.scope;
+    fields[@(GIDGoogleUserRecordFieldRequestedScope)] = authorizationRequest.scope;
+    fields[@(GIDGoogleUserRecordFieldClientID)] = authorizationRequest.clientID;
+    fields[@(GIDGoogleUserRecordFieldClientSecret)] = authorizationRequest.clientSecret;
+    fields[@(GIDGoogleUserRecordFieldRedirectURL)] =
+        authorizationRequest.redirectURL.absoluteString;
+    fields[@(GIDGoogleUserRecordFieldNonce)] = authorizationRequest.nonce;
+    fields[@(GIDGoogleUserRecordFieldAuthorizationEndpoint)] =
+        configuration.authorizationEndpoint.absoluteString;
+    fields[@(GIDGoogleUserRecordFieldTokenEndpoint)] = configuration.tokenEndpoint.absoluteString;
+    fields[@(GIDGoogleUserRecordFieldAuthorizationRequestParameters)] =
+        GIDStringParameters(authorizationRequest.additionalParameters);
+    fields[@(GIDGoogleUserRecordFieldAuthorizationResponseParameters)] =
+        GIDStringParameters(authorizationResponse.additionalParameters);
+    fields[@(GIDGoogleUserRecordFieldTokenRequestParameters)] =
+        GIDStringParameters(tokenResponse.request.additionalParameters);
+    fields[@(GIDGoogleUserRecordFieldProfileEmail)] = profileData.email;
+    fields[@(GIDGoogleUserRecordFieldProfileName)] = profileData.name;
+    fields[@(GIDGoogleUserRecordFieldProfileGivenName)] = profileData.givenName;
+    fields[@(GIDGoogleUserRecordFieldProfileFamilyName)] = profileData.familyName;
+    fields[@(GIDGoogleUserRecordFieldProfileImageURL)] = profileData.imageURL.absoluteString;
+    _fields = [fields copy];
+  }
+  return self;
+}
+
+- (nullable instancetype)initWithData:(NSData *)data {
+  self = [super init];
+  if (self) {
+    if (data.length < kRecordHeaderLength ||
+        memcmp(data.bytes, kRecordMagic, sizeof(kRecordMagic)) != 0 ||
+        ((const uint8_t *)data.bytes)[sizeof(kRecordMagic)] > kGIDGoogleUserRecordVersion) {
+      return nil;
+    }
+    GIDRecordReader reader = {
+      (const uint8_t *)data.bytes + kRecordHeaderLength,
+      data.length - kRecordHeaderLength,
+    };
+    NSMutableDictionary<NSNumber *, id> *fields = [NSMutableDictionary dictionary];
+    while (reader.remaining) {
+      uint8_t tag = reader.bytes[0];
+      reader.bytes++;
+      reader.remaining--;
+      NSUInteger length;
+      if (!GIDRecordReadLength(&reader, &length)) {
+        return nil;
+      }
+      id value = GIDRecordReadValue(&reader, tag, length);
+      if (!value) {
+        return nil;
+      }
+      fields[@(tag)] = value;
+    }
+    _fields = [fields copy];
+    _data = [data copy];
+
+    // A record can't be resumed without these.
+    if (!_fields[@(GIDGoogleUserRecordFieldAccessToken)] ||
+        !_fields[@(GIDGoogleUserRecordFieldClientID)] ||
+        ![NSURL URLWithString:_fields[@(GIDGoogleUserRecordFieldRedirectURL)] ?: @""] ||
+        ![NSURL URLWithString:_fields[@(GIDGoogleUserRecordFieldAuthorizationEndpoint)] ?: @""] ||
+        ![NSURL URLWithString:_fields[@(GIDGoogleUserRecordFieldTokenEndpoint)] ?: @""]) {
+      return nil;
+    }
+  }
+  return self;
+}
+
+- (NSData *)data {
+  @synchronized(self) {
+    if (!_data) {
+      NSMutableData *data = [NSMutableData dataWithBytes:kRecordMagic length:sizeof(kRecordMagic)];
+      [data appendBytes:&kGIDGoogleUserRecordVersion length:1];
+      // Sorting the tags keeps the encoding of equal records identical.
+      NSArray<NSNumber *> *tags =
+          [_fields.allKeys sortedArrayUsingSelector:@selector(compare:)];
+      for (NSNumber *tag in tags) {
+        GIDRecordAppendField(data, tag.unsignedCharValue, _fields[tag]);
+      }
+      _data = [data copy];
+    }
+    return _data;
+  }
+}
+
+- (nullable GIDProfileData *)profileData {
+  NSString *email = _fields[@(GIDGoogleUserRecordFieldProfileEmail)];
+  NSString *name = _fields[@(GIDGoogleUserRecordFieldProfileName)];
+  if (!email && !name) {
+    return nil;
+  }
+  NSString *imageURLString = _fields[@(GIDGoogleUserRecordFieldProfileImageURL)];
+  return [[GIDProfileData alloc]
+      initWithEmail:email ?: @""
+               name:name ?: @""
+          givenName:_fields[@(GIDGoogleUserRecordFieldProfileGivenName)]
+         familyName:_fields[@(GIDGoogleUserRecordFieldProfileFamilyName)]
+           imageURL:imageURLString ? [NSURL URLWithString:imageURLString] : nil];
+}
+
+- (GIDToken *)accessToken {
+  return [[GIDToken alloc]
+      initWithTokenString:_fields[@(GIDGoogleUserRecordFieldAccessToken)]
+           expirationDate:_fields[@(GIDGoogleUserRecordFieldAccessTokenExpirationDate)]];
+}
+
+- (GIDToken *)refreshToken {
+  return [[GIDToken alloc]
+      initWithTokenString:_fields[@(GIDGoogleUserRecordFieldRefreshToken)]
+           expirationDate:_fields[@(GIDGoogleUserRecordFieldRefreshTokenExpirationDate)]];
+}
+
+- (nullable GIDToken *)idToken {
+  NSString *idToken = _fields[@(GIDGoogleUserRecordFieldIDToken)];
+  if (!idToken) {
+    return nil;
+  }
+  return [[GIDToken alloc]
+      initWithTokenString:idToken
+           expirationDate:_fields[@(GIDGoogleUserRecordFieldIDTokenExpirationDate)]];
+}
+
+- (OIDAuthState *)authState {
+  NSString *clientID = _fields[@(GIDGoogleUserRecordFieldClientID)];
+  NSString *clientSecret = _fields[@(GIDGoogleUserRecordFieldClientSecret)];
+  NSString *redirectURL = _fields[@(GIDGoogleUserRecordFieldRedirectURL)];
+  NSString *refreshToken = _fields[@(GIDGoogleUserRecordFieldRefreshToken)];
+
+  OIDServiceConfiguration *configuration = [[OIDServiceConfiguration alloc]
+      initWithAuthorizationEndpoint:
+          [NSURL URLWithString:_fields[@(GIDGoogleUserRecordFieldAuthorizationEndpoint)]]
+                      tokenEndpoint:
+          [NSURL URLWithString:_fields[@(GIDGoogleUserRecordFieldTokenEndpoint)]]];
+
+  OIDAuthorizationRequest *authorizationRequest = [[OIDAuthorizationRequest alloc]
+      initWithConfiguration:configuration
+                   clientId:clientID
+               clientSecret:clientSecret
+                      scope:_fields[@(GIDGoogleUserRecordFieldRequestedScope)]
+                redirectURL:[NSURL URLWithString:redirectURL]
+               responseType:OIDResponseTypeCode
+                      state:nil
+                      nonce:_fields[@(GIDGoogleUserRecordFieldNonce)]
+               codeVerifier:nil
+              codeChallenge:nil
+        codeChallengeMethod:nil
+       additionalParameters:_fields[@(GIDGoogleUserRecordFieldAuthorizationRequestParameters)]];
+  OIDAuthorizationResponse *authorizationResponse = [[OIDAuthorizationResponse alloc]
+      initWithRequest:authorizationRequest
+           parameters:_fields[@(GIDGoogleUserRecordFieldAuthorizationResponseParameters)] ?: @{}];
+
+  // The token request stands in for the last refresh, which carried the stored parameters.
+  OIDTokenRequest *tokenRequest = [[OIDTokenRequest alloc]
+      initWithConfiguration:configuration
+                  grantType:OIDGrantTypeRefreshToken
+          authorizationCode:nil
+                redirectURL:nil
+                   clientID:clientID
+               clientSecret:clientSecret
+                     scopes:nil
+               refreshToken:refreshToken
+               codeVerifier:nil
+       additionalParameters:_fields[@(GIDGoogleUserRecordFieldTokenRequestParameters)]];
+
+  NSMutableDictionary<NSString *, NSObject<NSCopying> *> *tokenParameters =
+      [NSMutableDictionary dictionary];
+  tokenParameters[kAccessTokenParameter] = _fields[@(GIDGoogleUserRecordFieldAccessToken)];
+  tokenParameters[kTokenTypeParameter] = _fields[@(GIDGoogleUserRecordFieldTokenType)];
+  tokenParameters[kIDTokenParameter] = _fields[@(GIDGoogleUserRecordFieldIDToken)];
+  tokenParameters[kScopeParameter] = _fields[@(GIDGoogleUserRecordFieldGrantedScope)];
+  tokenParameters[kRefreshTokenParameter] = refreshToken;
+  NSDate *accessTokenExpirationDate =
+      _fields[@(GIDGoogleUserRecordFieldAccessTokenExpirationDate)];
+  if (accessTokenExpirationDate) {
+    tokenParameters[kExpiresInParameter] = GIDExpiresInWithDate(accessTokenExpirationDate);
+  }
+  NSDate *refreshTokenExpirationDate =
+      _fields[@(GIDGoogleUserRecordFieldRefreshTokenExpirationDate)];
+  if (refreshTokenExpirationDate) {
+    tokenParameters[kRefreshTokenExpiresInParameter] =
+        GIDExpiresInWithDate(refreshTokenExpirationDate);
+  }
+  OIDTokenResponse *tokenResponse = [[OIDTokenResponse alloc] initWithRequest:tokenRequest
+                                                                    parameters:tokenParameters];
+
+  return [[OIDAuthState alloc] initWithAuthorizationResponse:authorizationResponse
+                                               tokenResponse:tokenResponse];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
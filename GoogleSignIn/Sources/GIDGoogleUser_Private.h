@@ -29,6 +29,11 @@ NS_ASSUME_NONNULL_BEGIN
 /// A completion block that takes a `GIDGoogleUser` or an error if the attempt to refresh tokens was unsuccessful.
 typedef void (^GIDGoogleUserCompletion)(GIDGoogleUser *_Nullable user, NSError *_Nullable error);
 
+/// A completion block that takes a `GIDProfileData` or an error if the attempt to load the profile
+/// was unsuccessful.
+typedef void (^GIDProfileDataCompletion)(GIDProfileData *_Nullable profile,
+                                         NSError *_Nullable error);
+
 /// Internal methods for the class that are not part of the public API.
 @interface GIDGoogleUser () <OIDAuthStateChangeDelegate>
 
@@ -38,6 +43,8 @@ typedef void (^GIDGoogleUserCompletion)(GIDGoogleUser *_Nullable user, NSError *
 
 @property(nonatomic, readwrite, nullable) GIDToken *idToken;
 
+@property(nonatomic, readwrite, nullable) GIDProfileData *profile;
+
 /// A representation of the state of the OAuth session for this instance.
 @property(nonatomic, readonly) OIDAuthState *authState;
 
@@ -55,6 +62,10 @@ typedef void (^GIDGoogleUserCompletion)(GIDGoogleUser *_Nullable user, NSError *
 - (instancetype)initWithAuthState:(OIDAuthState *)authState
                       profileData:(nullable GIDProfileData *)profileData;
 
+// Whether the access token or ID token expires soon enough to be refreshed by
+// |refreshTokensIfNeededWithCompletion:|.
+- (BOOL)needsTokenRefresh;
+
 // Update the auth state and profile data.
 - (void)updateWithTokenResponse:(OIDTokenResponse *)tokenResponse
           authorizationResponse:(OIDAuthorizationResponse *)authorizationResponse
@@ -34,13 +34,7 @@
   }
 
   // If not failing, fall back to the real serialization path.
-  NSData *jsonData = [NSJSONSerialization dataWithJSONObject:jsonObject
-                                                 options:0
-                                                   error:error];
-  if (!jsonData) {
-      return nil;
-  }
-  return [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+  return [[[GIDJSONSerializerImpl alloc] init] stringWithJSONObject:jsonObject error:error];
 }
 
 @end
@@ -20,7 +20,24 @@ NS_ASSUME_NONNULL_BEGIN
 
 extern NSString *const kGIDJSONSerializationErrorDescription;
 
+/**
+ * A `GIDJSONSerializer` that streams the JSON text directly into a single UTF-8 buffer.
+ *
+ * Supports `NSDictionary` (with `NSString` keys), `NSArray`, `NSString`, `NSNumber` and `NSNull`
+ * values. The output matches `NSJSONSerialization` with no writing options.
+ */
 @interface GIDJSONSerializerImpl : NSObject <GIDJSONSerializer>
+
+/**
+ * Serializes the given dictionary into UTF-8 encoded `JSON` bytes.
+ *
+ * @param jsonObject The dictionary to be serialized.
+ * @param error A pointer to an `NSError` object to be populated upon failure.
+ * @return The `JSON` bytes, or `nil` if the dictionary contains an unsupported value.
+ */
+- (nullable NSData *)dataWithJSONObject:(NSDictionary<NSString *, id> *)jsonObject
+                                  error:(NSError *_Nullable *_Nullable)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -16,31 +16,279 @@
 
 #import "GoogleSignIn/Sources/GIDJSONSerializer/Implementation/GIDJSONSerializerImpl.h"
 
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDSignIn.h"
 
+NS_ASSUME_NONNULL_BEGIN
+
 NSString * const kGIDJSONSerializationErrorDescription =
     @"The provided object could not be serialized to a JSON string.";
 
+/** The initial capacity of the output buffer; large enough for typical claims requests. */
+static const size_t kInitialBufferCapacity = 128;
+
+/** The size of the on-stack scratch space used to transcode short strings to UTF-8. */
+static const size_t kStringScratchSize = 256;
+
+/** The maximum nesting depth accepted by the writer. */
+static const NSUInteger kMaxNestingDepth = 64;
+
+/** A growable byte buffer that the JSON text is streamed into. */
+typedef struct {
+  char *bytes;
+  size_t length;
+  size_t capacity;
+} GIDJSONBuffer;
+
+static BOOL GIDJSONBufferReserve(GIDJSONBuffer *buffer, size_t additional) {
+  if (buffer->capacity - buffer->length >= additional) {
+    return YES;
+  }
+  size_t capacity = buffer->capacity ?: kInitialBufferCapacity;
+  while (capacity - buffer->length < additional) {
+    capacity *= 2;
+  }
+  char *bytes = realloc(buffer->bytes, capacity);
+  if (!bytes) {
+    return NO;
+  }
+  buffer->bytes = bytes;
+  buffer->capacity = capacity;
+  return YES;
+}
+
+static BOOL GIDJSONBufferAppend(GIDJSONBuffer *buffer, const char *bytes, size_t length) {
+  if (!GIDJSONBufferReserve(buffer, length)) {
+    return NO;
+  }
+  memcpy(buffer->bytes + buffer->length, bytes, length);
+  buffer->length += length;
+  return YES;
+}
+
+static BOOL GIDJSONBufferAppendByte(GIDJSONBuffer *buffer, char byte) {
+  if (!GIDJSONBufferReserve(buffer, 1)) {
+    return NO;
+  }
+  buffer->bytes[buffer->length++] = byte;
+  return YES;
+}
+
+/** Appends `utf8` as a quoted JSON string, escaping the same characters as NSJSONSerialization. */
+static BOOL GIDJSONWriteEscapedUTF8(GIDJSONBuffer *buffer, const char *utf8, size_t length) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  // Worst case every byte becomes a six byte `\u00XX` escape, plus the two quotes.
+  if (!GIDJSONBufferReserve(buffer, length * 6 + 2)) {
+    return NO;
+  }
+  char *out = buffer->bytes + buffer->length;
+  *out++ = '"';
+  for (size_t i = 0; i < length; i++) {
+    unsigned char c = (unsigned char)utf8[i];
+    switch (c) {
+      case '"':  *out++ = '\\'; *out++ = '"';  break;
+      case '\\': *out++ = '\\'; *out++ = '\\'; break;
+      case '/':  *out++ = '\\'; *out++ = '/';  break;
+      case '\b': *out++ = '\\'; *out++ = 'b';  break;
+      case '\f': *out++ = '\\'; *out++ = 'f';  break;
+      case '\n': *out++ = '\\'; *out++ = 'n';  break;
+      case '\r': *out++ = '\\'; *out++ = 'r';  break;
+      case '\t': *out++ = '\\'; *out++ = 't';  break;
+      default:
+        if (c < 0x20) {
+          *out++ = '\\';
+          *out++ = 'u';
+          *out++ = '0';
+          *out++ = '0';
+          *out++ = kHexDigits[c >> 4];
+          *out++ = kHexDigits[c & 0xF];
+        } else {
+          *out++ = (char)c;
+        }
+        break;
+    }
+  }
+  *out++ = '"';
+  buffer->length = (size_t)(out - buffer->bytes);
+  return YES;
+}
+
+static BOOL GIDJSONWriteString(GIDJSONBuffer *buffer, NSString *string) {
+  // ASCII backed strings expose their bytes directly, so nothing needs transcoding. The length
+  // check rejects strings with embedded NULs or multi-byte characters.
+  const char *direct = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingUTF8);
+  if (direct) {
+    size_t directLength = strlen(direct);
+    if (directLength == string.length) {
+      return GIDJSONWriteEscapedUTF8(buffer, direct, directLength);
+    }
+  }
+
+  NSUInteger maxLength = [string maxLengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+  char scratch[kStringScratchSize];
+  char *utf8 = maxLength <= kStringScratchSize ? scratch : malloc(maxLength);
+  if (!utf8) {
+    return NO;
+  }
+  NSUInteger usedLength = 0;
+  NSRange remaining = NSMakeRange(0, 0);
+  BOOL converted = [string getBytes:utf8
+                          maxLength:maxLength
+                         usedLength:&usedLength
+                           encoding:NSUTF8StringEncoding
+                            options:0
+                              range:NSMakeRange(0, string.length)
+                     remainingRange:&remaining];
+  // An unpaired surrogate stops the conversion early; such a string has no UTF-8 representation.
+  BOOL success = (converted || string.length == 0) && remaining.length == 0 &&
+      GIDJSONWriteEscapedUTF8(buffer, utf8, usedLength);
+  if (utf8 != scratch) {
+    free(utf8);
+  }
+  return success;
+}
+
+static BOOL GIDJSONWriteNumber(GIDJSONBuffer *buffer, NSNumber *number) {
+  if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+    return number.boolValue ? GIDJSONBufferAppend(buffer, "true", 4)
+                            : GIDJSONBufferAppend(buffer, "false", 5);
+  }
+  char digits[32];
+  int length;
+  switch (number.objCType[0]) {
+    case 'c':
+    case 's':
+    case 'i':
+    case 'l':
+    case 'q':
+      length = snprintf(digits, sizeof(digits), "%lld", number.longLongValue);
+      break;
+    case 'C':
+    case 'S':
+    case 'I':
+    case 'L':
+    case 'Q':
+      length = snprintf(digits, sizeof(digits), "%llu", number.unsignedLongLongValue);
+      break;
+    default: {
+      // NaN and infinity have no JSON representation.
+      if (!isfinite(number.doubleValue)) {
+        return NO;
+      }
+      // `-[NSNumber stringValue]` is not JSON number syntax for every value (1e20 becomes
+      // "1e+20"), so let NSJSONSerialization format floating point values, which are rare in the
+      // objects the SDK serializes, and copy its text from between the array brackets.
+      NSData *data = [NSJSONSerialization dataWithJSONObject:@[ number ] options:0 error:NULL];
+      return data.length > 2 &&
+          GIDJSONBufferAppend(buffer, (const char *)data.bytes + 1, data.length - 2);
+    }
+  }
+  return length > 0 && GIDJSONBufferAppend(buffer, digits, (size_t)length);
+}
+
+static BOOL GIDJSONWriteValue(GIDJSONBuffer *buffer, id value, NSUInteger depth) {
+  if ([value isKindOfClass:[NSString class]]) {
+    return GIDJSONWriteString(buffer, value);
+  }
+  if ([value isKindOfClass:[NSNumber class]]) {
+    return GIDJSONWriteNumber(buffer, value);
+  }
+  if ([value isKindOfClass:[NSNull class]]) {
+    return GIDJSONBufferAppend(buffer, "null", 4);
+  }
+  if (depth >= kMaxNestingDepth) {
+    return NO;
+  }
+  if ([value isKindOfClass:[NSDictionary class]]) {
+    if (!GIDJSONBufferAppendByte(buffer, '{')) {
+      return NO;
+    }
+    __block BOOL success = YES;
+    __block BOOL first = YES;
+    [(NSDictionary *)value enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+      success = [key isKindOfClass:[NSString class]] &&
+          (first || GIDJSONBufferAppendByte(buffer, ',')) &&
+          GIDJSONWriteString(buffer, key) &&
+          GIDJSONBufferAppendByte(buffer, ':') &&
+          GIDJSONWriteValue(buffer, object, depth + 1);
+      first = NO;
+      *stop = !success;
+    }];
+    return success && GIDJSONBufferAppendByte(buffer, '}');
+  }
+  if ([value isKindOfClass:[NSArray class]]) {
+    if (!GIDJSONBufferAppendByte(buffer, '[')) {
+      return NO;
+    }
+    BOOL first = YES;
+    for (id element in (NSArray *)value) {
+      if (!(first || GIDJSONBufferAppendByte(buffer, ',')) ||
+          !GIDJSONWriteValue(buffer, element, depth + 1)) {
+        return NO;
+      }
+      first = NO;
+    }
+    return GIDJSONBufferAppendByte(buffer, ']');
+  }
+  return NO;
+}
+
+/**
+ * Streams `jsonObject` into `buffer`. On failure the buffer is freed and `error` is populated.
+ */
+static BOOL GIDJSONWriteRootObject(GIDJSONBuffer *buffer,
+                                   NSDictionary<NSString *, id> *jsonObject,
+                                   NSError *_Nullable *_Nullable error) {
+  if ([jsonObject isKindOfClass:[NSDictionary class]] &&
+      GIDJSONWriteValue(buffer, jsonObject, 0)) {
+    return YES;
+  }
+  free(buffer->bytes);
+  *buffer = (GIDJSONBuffer){0};
+  if (error) {
+    // Report the same underlying error NSJSONSerialization uses for objects it cannot write.
+    NSError *underlyingError =
+        [NSError errorWithDomain:NSCocoaErrorDomain
+                            code:NSPropertyListWriteInvalidError
+                        userInfo:@{ NSDebugDescriptionErrorKey : @"Invalid value in JSON write" }];
+    *error = [NSError errorWithDomain:kGIDSignInErrorDomain
+                                 code:kGIDSignInErrorCodeJSONSerializationFailure
+                             userInfo:@{
+                               NSLocalizedDescriptionKey:kGIDJSONSerializationErrorDescription,
+                                    NSUnderlyingErrorKey:underlyingError
+                             }];
+  }
+  return NO;
+}
+
 @implementation GIDJSONSerializerImpl
 
 - (nullable NSString *)stringWithJSONObject:(NSDictionary<NSString *, id> *)jsonObject
                                       error:(NSError *_Nullable *_Nullable)error {
-  NSError *serializationError;
-  NSData *jsonData = [NSJSONSerialization dataWithJSONObject:jsonObject
-                                                     options:0
-                                                       error:&serializationError];
-  if (!jsonData) {
-    if (error) {
-      *error = [NSError errorWithDomain:kGIDSignInErrorDomain
-                                   code:kGIDSignInErrorCodeJSONSerializationFailure
-                               userInfo:@{
-                            NSLocalizedDescriptionKey:kGIDJSONSerializationErrorDescription,
-                                 NSUnderlyingErrorKey:serializationError
-                               }];
-    }
+  GIDJSONBuffer buffer = {0};
+  if (!GIDJSONWriteRootObject(&buffer, jsonObject, error)) {
     return nil;
   }
-  return [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+  // Hand the buffer over to the string rather than copying it.
+  return [[NSString alloc] initWithBytesNoCopy:buffer.bytes
+                                        length:buffer.length
+                                      encoding:NSUTF8StringEncoding
+                                  freeWhenDone:YES];
+}
+
+- (nullable NSData *)dataWithJSONObject:(NSDictionary<NSString *, id> *)jsonObject
+                                  error:(NSError *_Nullable *_Nullable)error {
+  GIDJSONBuffer buffer = {0};
+  if (!GIDJSONWriteRootObject(&buffer, jsonObject, error)) {
+    return nil;
+  }
+  return [NSData dataWithBytesNoCopy:buffer.bytes length:buffer.length freeWhenDone:YES];
 }
 
 @end
+
+NS_ASSUME_NONNULL_END
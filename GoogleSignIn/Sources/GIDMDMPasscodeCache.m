@@ -22,8 +22,10 @@
 #import <Security/Security.h>
 #import <UIKit/UIKit.h>
 
+#import "GoogleSignIn/Sources/GIDJSONSerializer/Implementation/GIDJSONSerializerImpl.h"
 #import "GoogleSignIn/Sources/GIDMDMPasscodeState.h"
 #import "GoogleSignIn/Sources/GIDMDMPasscodeState_Private.h"
+#import "GoogleSignIn/Sources/NSData+GIDBase64URL.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -285,12 +287,8 @@ static const int64_t kObtainKeychainInfoWaitTime = 3 * NSEC_PER_SEC;
   if (_keychainInfo) {
     infoDict[kKeychainKey] = _keychainInfo;
   }
-  NSData *data = [NSJSONSerialization dataWithJSONObject:infoDict
-                                                 options:0
-                                                   error:NULL];
-  NSString *string = [data base64EncodedStringWithOptions:0];
-  string = [string stringByReplacingOccurrencesOfString:@"/" withString:@"_"];
-  string = [string stringByReplacingOccurrencesOfString:@"+" withString:@"-"];
+  NSData *data = [[[GIDJSONSerializerImpl alloc] init] dataWithJSONObject:infoDict error:NULL];
+  NSString *string = [data gid_base64URLEncodedString];
   return string ?: @"e30=";  // Use encoded "{}" in case of error.
 }
 
@@ -14,6 +14,7 @@
 
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDProfileData.h"
 
+#import "GoogleSignIn/Sources/GIDEqualObjects.h"
 #import "GoogleSignIn/Sources/GIDProfileData_Private.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -102,6 +103,27 @@ static NSString *const kOldImageURLStringKey = @"picture";
   return NO;
 }
 
+#pragma mark - NSObject
+
+- (BOOL)isEqual:(id)object {
+  if (self == object) {
+    return YES;
+  }
+  if (![object isKindOfClass:[GIDProfileData class]]) {
+    return NO;
+  }
+  GIDProfileData *other = (GIDProfileData *)object;
+  return GIDEqualObjects(_email, other.email) &&
+         GIDEqualObjects(_name, other.name) &&
+         GIDEqualObjects(_givenName, other.givenName) &&
+         GIDEqualObjects(_familyName, other.familyName) &&
+         GIDEqualObjects(_imageURL, other.imageURL);
+}
+
+- (NSUInteger)hash {
+  return _email.hash ^ _name.hash ^ _imageURL.hash;
+}
+
 #pragma mark - NSSecureCoding
 
 + (BOOL)supportsSecureCoding {
@@ -21,6 +21,9 @@ NS_ASSUME_NONNULL_BEGIN
 // Private |GIDProfileData| methods that are used in this SDK.
 @interface GIDProfileData ()
 
+// The URL of the profile image, without any size options.
+@property(nonatomic, readonly, nullable) NSURL *imageURL;
+
 // Initialize with profile attributes.
 - (instancetype)initWithEmail:(NSString *)email
                          name:(NSString *)name
@@ -22,13 +22,19 @@
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDSignInResult.h"
 
 #import "GoogleSignIn/Sources/GIDAuthStateMigration/GIDAuthStateMigration.h"
+#import "GoogleSignIn/Sources/GIDAuthStateStore/API/GIDAuthStateStore.h"
+#import "GoogleSignIn/Sources/GIDAuthStateStore/Implementation/GIDKeychainAuthStateStore.h"
+#import "GoogleSignIn/Sources/GIDAuthorizationRequestTemplate.h"
 #import "GoogleSignIn/Sources/GIDEMMSupport.h"
 #import "GoogleSignIn/Sources/GIDSignInInternalOptions.h"
 #import "GoogleSignIn/Sources/GIDSignInPreferences.h"
 #import "GoogleSignIn/Sources/GIDCallbackQueue.h"
+#import "GoogleSignIn/Sources/GIDCancellationToken_Private.h"
 #import "GoogleSignIn/Sources/GIDScopes.h"
 #import "GoogleSignIn/Sources/GIDSignInCallbackSchemes.h"
 #import "GoogleSignIn/Sources/GIDClaimsInternalOptions.h"
+#import "GoogleSignIn/Sources/GIDTokenRevocationQueue.h"
+#import "GoogleSignIn/Sources/GIDUserInfoRecord.h"
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
 #import <AppCheckCore/GACAppCheckToken.h>
 #import "GoogleSignIn/Sources/GIDAppCheck/Implementations/GIDAppCheck.h"
@@ -83,9 +89,6 @@ static NSString *const kTokenURLTemplate = @"https://%@/token";
 // The URL template for the URL to get user info.
 static NSString *const kUserInfoURLTemplate = @"https://%@/oauth2/v3/userinfo?access_token=%@";
 
-// The URL template for the URL to revoke the token.
-static NSString *const kRevokeTokenURLTemplate = @"https://%@/o/oauth2/revoke?token=%@";
-
 // Expected path in the URL scheme to be handled.
 static NSString *const kBrowserCallbackPath = @"/oauth2callback";
 
@@ -95,6 +98,13 @@ static NSString *const kEMMCallbackPath = @"/emmcallback";
 // The EMM support version
 static NSString *const kEMMVersion = @"1";
 
+// The kinds of URLs handled by |handleURL:|, keyed by their path.
+typedef NS_ENUM(NSInteger, GIDCallbackURLType) {
+  GIDCallbackURLTypeNone = 0,
+  GIDCallbackURLTypeBrowser,
+  GIDCallbackURLTypeEMM,
+};
+
 // The error code for Google Identity.
 NSErrorDomain const kGIDSignInErrorDomain = @"com.google.GIDSignIn";
 
@@ -120,11 +130,18 @@ static NSString *const kKeychainError = @"keychain error";
 // Error string for user cancelations.
 static NSString *const kUserCanceledError = @"The user canceled the sign-in flow.";
 
+// Error string for requests that did not complete before their deadline.
+static NSString *const kTimedOutError = @"The request did not complete before its timeout.";
+
 NSString *const kAppHasRunBeforeKey = @"GID_AppHasRunBefore";
 
 // Maximum retry interval in seconds for the fetcher.
 static const NSTimeInterval kFetcherMaxRetryInterval = 15.0;
 
+// The shortest timeout in seconds given to a fetch with a deadline, since a timeout of zero would
+// mean the system default instead. The deadline itself still stops the fetch.
+static const NSTimeInterval kMinimumFetchTimeoutInterval = 1.0;
+
 // The delay before the new sign-in flow can be presented after the existing one is cancelled.
 static const NSTimeInterval kPresentationDelayAfterCancel = 1.0;
 
@@ -132,9 +149,10 @@ static const NSTimeInterval kPresentationDelayAfterCancel = 1.0;
 static NSString *const kAudienceParameter = @"audience";
 // See b/11669751 .
 static NSString *const kOpenIDRealmParameter = @"openid.realm";
-static NSString *const kIncludeGrantedScopesParameter = @"include_granted_scopes";
-static NSString *const kLoginHintParameter = @"login_hint";
-static NSString *const kHostedDomainParameter = @"hd";
+
+// Parameters of the token endpoint response.
+static NSString *const kRefreshTokenParameter = @"refresh_token";
+static NSString *const kScopeParameter = @"scope";
 
 // Parameter for requesting the token claims.
 static NSString *const kClaimsParameter = @"claims";
@@ -154,6 +172,16 @@ static NSString *const kConfigServerClientIDKey = @"GIDServerClientID";
 static NSString *const kConfigHostedDomainKey = @"GIDHostedDomain";
 static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 
+// The parts of an auth flow's auth state that need to be written to the keychain.
+typedef NS_ENUM(NSInteger, GIDAuthFlowPersistence) {
+  // The whole auth state, as after a sign-in.
+  kGIDAuthFlowPersistenceAuthSession = 0,
+  // Only the token response, as after refreshing a restored auth state.
+  kGIDAuthFlowPersistenceTokenResponse,
+  // Nothing, as the auth state is unchanged since it was restored.
+  kGIDAuthFlowPersistenceNone,
+};
+
 // The callback queue used for authentication flow.
 @interface GIDAuthFlow : GIDCallbackQueue
 
@@ -161,18 +189,75 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 @property(nonatomic, strong, nullable) NSError *error;
 @property(nonatomic, copy, nullable) NSString *emmSupport;
 @property(nonatomic, nullable) GIDProfileData *profileData;
+@property(nonatomic) GIDAuthFlowPersistence persistence;
+// The options of the sign-in flow this auth flow completes.
+@property(nonatomic, nullable) GIDSignInInternalOptions *options;
+// Whether every request waiting for the flow was cancelled, so its remaining work is skipped.
+@property(nonatomic, readonly, getter=isAbandoned) BOOL abandoned;
 
 @end
 
 @implementation GIDAuthFlow
+
+- (BOOL)isAbandoned {
+  return self.options.flowCancellationToken.isCancelled;
+}
+
 @end
 
+// Returns an auth state with the grant and tokens of |authState|, which later updates to
+// |authState| don't change. It is built from the responses of |authState|, which are immutable,
+// rather than by archiving it.
+static OIDAuthState *GIDAuthStateSnapshot(OIDAuthState *authState) {
+  OIDAuthorizationResponse *authorizationResponse = authState.lastAuthorizationResponse;
+  OIDTokenResponse *tokenResponse = authState.lastTokenResponse;
+  if (!authorizationResponse) {
+    // Auth states without an authorization response aren't created by the sign-in flows.
+    return authState;
+  }
+  OIDAuthState *snapshot =
+      [[OIDAuthState alloc] initWithAuthorizationResponse:authorizationResponse
+                                            tokenResponse:nil
+                                     registrationResponse:authState.lastRegistrationResponse];
+  if (tokenResponse) {
+    // A refresh response may omit the refresh token and scope, which the auth state keeps from an
+    // earlier response, so carry them over before applying it.
+    NSMutableDictionary<NSString *, NSString *> *keptParameters = [NSMutableDictionary dictionary];
+    keptParameters[kRefreshTokenParameter] = authState.refreshToken;
+    keptParameters[kScopeParameter] = authState.scope;
+    if (keptParameters.count) {
+      [snapshot updateWithTokenResponse:[[OIDTokenResponse alloc]
+                                            initWithRequest:tokenResponse.request
+                                                 parameters:keptParameters]
+                                  error:nil];
+    }
+    [snapshot updateWithTokenResponse:tokenResponse error:nil];
+  }
+  if (authState.authorizationError) {
+    [snapshot updateWithAuthorizationError:authState.authorizationError];
+  }
+  return snapshot;
+}
+
+// Calls |block| on the main queue once |deadline| passes.
+static void GIDDispatchAtDeadline(NSDate *deadline, dispatch_block_t block) {
+  NSTimeInterval timeout = MAX([deadline timeIntervalSinceNow], 0);
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), block);
+}
+
 @implementation GIDSignIn {
   // This value is used when sign-in flows are resumed via the handling of a URL. Its value is
   // set when a sign-in flow is begun via |signInWithOptions:| when the options passed don't
   // represent a sign in continuation.
   GIDSignInInternalOptions *_currentOptions;
+  // The options of the requests that joined a flow in progress instead of starting their own,
+  // keyed by the options the flow was started with.
+  NSMapTable<GIDSignInInternalOptions *, NSMutableArray<GIDSignInInternalOptions *> *>
+      *_joinedOptions;
   GIDClaimsInternalOptions *_claimsInternalOptions;
+  // The precomputed parts of the authorization request for the most recently used configuration.
+  GIDAuthorizationRequestTemplate *_requestTemplate;
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
   GIDAppCheck *_appCheck API_AVAILABLE(ios(14));
 #endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
@@ -180,10 +265,18 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   OIDServiceConfiguration *_appAuthConfiguration;
   // AppAuth external user-agent session state.
   id<OIDExternalUserAgentSession> _currentAuthorizationFlow;
+  // The options the current authorization flow was presented with, which a restart carries on.
+  GIDSignInInternalOptions *_currentAuthorizationFlowOptions;
   // Flag to indicate that the auth flow is restarting.
   BOOL _restarting;
-  // Keychain manager for GTMAppAuth
-  GTMKeychainStore *_keychainStore;
+  // Persists the auth state, in the keychain unless another store was given.
+  id<GIDAuthStateStore> _authStateStore;
+  // Tracks the migration of auth state saved by older versions of the SDK, which runs in the
+  // background. Keychain access waits for it to finish.
+  dispatch_group_t _authStateMigrationGroup;
+  // The serial queue all auth state store accesses run on, so that reads and removals are ordered
+  // after the writes started before them.
+  dispatch_queue_t _authStateStoreQueue;
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
   // The class used to manage presenting the loading screen for fetching app check tokens.
   GIDTimedLoader *_timedLoader;
@@ -199,17 +292,23 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 // For SFSafariViewController invoked via AppAuth, this method is used on iOS 10.
 // For the Device Policy App (EMM flow) this method is used on all iOS versions.
 - (BOOL)handleURL:(NSURL *)url {
-  // Check if the callback path matches the expected one for a URL from Safari/Chrome/SafariVC.
-  if ([url.path isEqual:kBrowserCallbackPath]) {
-    if ([_currentAuthorizationFlow resumeExternalUserAgentFlowWithURL:url]) {
-      _currentAuthorizationFlow = nil;
-      return YES;
-    }
-    return NO;
-  }
-  // Check if the callback path matches the expected one for a URL from Google Device Policy app.
-  if ([url.path isEqual:kEMMCallbackPath]) {
-    return [self handleDevicePolicyAppURL:url];
+  switch ([GIDSignIn callbackURLTypeForPath:url.path]) {
+    case GIDCallbackURLTypeBrowser:
+      // The callback path matches the expected one for a URL from Safari/Chrome/SafariVC. Only
+      // URLs with a scheme declared in Info.plist can be redirects, so reject everything else
+      // before handing the URL to AppAuth.
+      if ([GIDSignInCallbackSchemes isRegisteredURLScheme:url.scheme] &&
+          [_currentAuthorizationFlow resumeExternalUserAgentFlowWithURL:url]) {
+        _currentAuthorizationFlow = nil;
+        _currentAuthorizationFlowOptions = nil;
+        return YES;
+      }
+      return NO;
+    case GIDCallbackURLTypeEMM:
+      // The callback path matches the expected one for a URL from Google Device Policy app.
+      return [self handleDevicePolicyAppURL:url];
+    case GIDCallbackURLTypeNone:
+      break;
   }
   return NO;
 }
@@ -224,8 +323,56 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 
 - (void)restorePreviousSignInWithCompletion:(nullable void (^)(GIDGoogleUser *_Nullable user,
                                                                NSError *_Nullable error))completion {
-  [self signInWithOptions:[GIDSignInInternalOptions silentOptionsWithCompletion:
-                           ^(GIDSignInResult *signInResult, NSError *error) {
+  [self restorePreviousSignInWithDeadline:nil
+                        cancellationToken:[[GIDCancellationToken alloc] init]
+                               completion:completion];
+}
+
+- (void)restorePreviousSignInWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                                        completion:
+    (nullable void (^)(GIDGoogleUser *_Nullable user, NSError *_Nullable error))completion {
+  [self restorePreviousSignInWithDeadline:nil
+                        cancellationToken:cancellationToken
+                               completion:completion];
+}
+
+- (void)restorePreviousSignInWithTimeout:(NSTimeInterval)timeout
+                              completion:(nullable void (^)(GIDGoogleUser *_Nullable user,
+                                                            NSError *_Nullable error))completion {
+  [self restorePreviousSignInWithTimeout:timeout
+                       cancellationToken:[[GIDCancellationToken alloc] init]
+                              completion:completion];
+}
+
+- (void)restorePreviousSignInWithTimeout:(NSTimeInterval)timeout
+                       cancellationToken:(GIDCancellationToken *)cancellationToken
+                              completion:(nullable void (^)(GIDGoogleUser *_Nullable user,
+                                                            NSError *_Nullable error))completion {
+  [self restorePreviousSignInWithDeadline:[NSDate dateWithTimeIntervalSinceNow:timeout]
+                        cancellationToken:cancellationToken
+                               completion:completion];
+}
+
+// Restores the previous sign-in, failing once |deadline| passes unless it is nil, and cancels it
+// once |cancellationToken| is cancelled.
+- (void)restorePreviousSignInWithDeadline:(nullable NSDate *)deadline
+                        cancellationToken:(GIDCancellationToken *)cancellationToken
+                               completion:(nullable void (^)(GIDGoogleUser *_Nullable user,
+                                                             NSError *_Nullable error))completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
+  GIDSignInInternalOptions *options = [self restoreOptionsWithDeadline:deadline
+                                                            completion:completion];
+  [self signInWithOptions:options cancellationToken:cancellationToken];
+}
+
+// Creates the options of a silent flow that restores the previous sign-in.
+- (GIDSignInInternalOptions *)restoreOptionsWithDeadline:(nullable NSDate *)deadline
+                                              completion:
+    (nullable void (^)(GIDGoogleUser *_Nullable user, NSError *_Nullable error))completion {
+  GIDSignInInternalOptions *options = [GIDSignInInternalOptions silentOptionsWithCompletion:
+      ^(GIDSignInResult *signInResult, NSError *error) {
     if (!completion) {
       return;
     }
@@ -234,7 +381,46 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     } else {
       completion(nil, error);
     }
-  }]];
+  }];
+  options.deadline = deadline;
+  return options;
+}
+
+- (void)restorePreviousSignInWithRestoredUserHandler:
+            (void (^)(GIDGoogleUser *user, BOOL tokensAreFresh))restoredUserHandler
+                                          completion:
+            (nullable void (^)(GIDGoogleUser *_Nullable user, NSError *_Nullable error))completion {
+  [self restorePreviousSignInWithRestoredUserHandler:restoredUserHandler
+                                   cancellationToken:[[GIDCancellationToken alloc] init]
+                                          completion:completion];
+}
+
+- (void)restorePreviousSignInWithRestoredUserHandler:
+            (void (^)(GIDGoogleUser *user, BOOL tokensAreFresh))restoredUserHandler
+                                   cancellationToken:(GIDCancellationToken *)cancellationToken
+                                          completion:
+            (nullable void (^)(GIDGoogleUser *_Nullable user, NSError *_Nullable error))completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
+  GIDSignInInternalOptions *options = [self restoreOptionsWithDeadline:nil completion:completion];
+  // Restoring without a refresh sets |currentUser|, so the restore below refreshes the tokens of
+  // that same user in place rather than replacing it. It also reuses the auth state loaded here,
+  // found or not, rather than reading the store again.
+  if (!_currentUser) {
+    options.restoredAuthState = [self loadAuthState];
+    [self restoreUserWithAuthState:options.restoredAuthState];
+  }
+  if (_currentUser) {
+    GIDGoogleUser *user = _currentUser;
+    BOOL tokensAreFresh = ![user needsTokenRefresh];
+    dispatch_async(dispatch_get_main_queue(), ^{
+      if (!cancellationToken.isCancelled) {
+        restoredUserHandler(user, tokensAreFresh);
+      }
+    });
+  }
+  [self signInWithOptions:options cancellationToken:cancellationToken];
 }
 
 - (BOOL)restorePreviousSignInNoRefresh {
@@ -243,19 +429,21 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   }
 
   // Try retrieving an authorization object from the keychain.
-  OIDAuthState *authState = [self loadAuthState];
+  [self restoreUserWithAuthState:[self loadAuthState]];
+  return _currentUser != nil;
+}
+
+// Makes the user of |authState|, if any, the current user without refreshing the access token.
+- (void)restoreUserWithAuthState:(nullable OIDAuthState *)authState {
   if (!authState) {
-    return NO;
+    return;
   }
-
-  // Restore current user without refreshing the access token.
   OIDIDToken *idToken =
       [[OIDIDToken alloc] initWithIDTokenString:authState.lastTokenResponse.idToken];
   GIDProfileData *profileData = [self profileDataWithIDToken:idToken];
 
   GIDGoogleUser *user = [[GIDGoogleUser alloc] initWithAuthState:authState profileData:profileData];
   self.currentUser = user;
-  return YES;
 }
 
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
@@ -336,6 +524,25 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                                      nonce:(nullable NSString *)nonce
                                     claims:(nullable NSSet<GIDClaim *> *)claims
                                 completion:(nullable GIDSignInCompletion)completion {
+  [self signInWithPresentingViewController:presentingViewController
+                                      hint:hint
+                          additionalScopes:additionalScopes
+                                     nonce:nonce
+                                    claims:claims
+                         cancellationToken:[[GIDCancellationToken alloc] init]
+                                completion:completion];
+}
+
+- (void)signInWithPresentingViewController:(UIViewController *)presentingViewController
+                                      hint:(nullable NSString *)hint
+                          additionalScopes:(nullable NSArray<NSString *> *)additionalScopes
+                                     nonce:(nullable NSString *)nonce
+                                    claims:(nullable NSSet<GIDClaim *> *)claims
+                         cancellationToken:(GIDCancellationToken *)cancellationToken
+                                completion:(nullable GIDSignInCompletion)completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
   GIDSignInInternalOptions *options =
       [GIDSignInInternalOptions defaultOptionsWithConfiguration:_configuration
                                        presentingViewController:presentingViewController
@@ -345,7 +552,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                                                           nonce:nonce
                                                          claims:claims
                                                      completion:completion];
-  [self signInWithOptions:options];
+  [self signInWithOptions:options cancellationToken:cancellationToken];
 }
 
 - (void)signInWithPresentingViewController:(UIViewController *)presentingViewController
@@ -357,7 +564,11 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 
 - (void)addScopes:(NSArray<NSString *> *)scopes
     presentingViewController:(UIViewController *)presentingViewController
+           cancellationToken:(GIDCancellationToken *)cancellationToken
                   completion:(nullable GIDSignInCompletion)completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
   GIDConfiguration *configuration = self.currentUser.configuration;
   GIDSignInInternalOptions *options =
       [GIDSignInInternalOptions defaultOptionsWithConfiguration:configuration
@@ -384,11 +595,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     NSError *error = [NSError errorWithDomain:kGIDSignInErrorDomain
                                          code:kGIDSignInErrorCodeScopesAlreadyGranted
                                      userInfo:nil];
-    if (completion) {
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(nil, error);
-      });
-    }
+    [self completeSignInWithOptions:options result:nil error:error];
     return;
   }
 
@@ -396,7 +603,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   [grantedScopes unionSet:requestedScopes];
   options.scopes = [grantedScopes allObjects];
 
-  [self signInWithOptions:options];
+  [self signInWithOptions:options cancellationToken:cancellationToken];
 }
 
 #elif TARGET_OS_OSX
@@ -483,6 +690,25 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                              nonce:(nullable NSString *)nonce
                             claims:(nullable NSSet<GIDClaim *> *)claims
                         completion:(nullable GIDSignInCompletion)completion {
+  [self signInWithPresentingWindow:presentingWindow
+                              hint:hint
+                  additionalScopes:additionalScopes
+                             nonce:nonce
+                            claims:claims
+                 cancellationToken:[[GIDCancellationToken alloc] init]
+                        completion:completion];
+}
+
+- (void)signInWithPresentingWindow:(NSWindow *)presentingWindow
+                              hint:(nullable NSString *)hint
+                  additionalScopes:(nullable NSArray<NSString *> *)additionalScopes
+                             nonce:(nullable NSString *)nonce
+                            claims:(nullable NSSet<GIDClaim *> *)claims
+                 cancellationToken:(GIDCancellationToken *)cancellationToken
+                        completion:(nullable GIDSignInCompletion)completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
   GIDSignInInternalOptions *options =
       [GIDSignInInternalOptions defaultOptionsWithConfiguration:_configuration
                                                presentingWindow:presentingWindow
@@ -492,12 +718,16 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                                                           nonce:nonce
                                                          claims:claims
                                                      completion:completion];
-  [self signInWithOptions:options];
+  [self signInWithOptions:options cancellationToken:cancellationToken];
 }
 
 - (void)addScopes:(NSArray<NSString *> *)scopes
- presentingWindow:(NSWindow *)presentingWindow
-       completion:(nullable GIDSignInCompletion)completion {
+     presentingWindow:(NSWindow *)presentingWindow
+    cancellationToken:(GIDCancellationToken *)cancellationToken
+           completion:(nullable GIDSignInCompletion)completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
   GIDConfiguration *configuration = self.currentUser.configuration;
   GIDSignInInternalOptions *options =
       [GIDSignInInternalOptions defaultOptionsWithConfiguration:configuration
@@ -524,11 +754,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     NSError *error = [NSError errorWithDomain:kGIDSignInErrorDomain
                                          code:kGIDSignInErrorCodeScopesAlreadyGranted
                                      userInfo:nil];
-    if (completion) {
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(nil, error);
-      });
-    }
+    [self completeSignInWithOptions:options result:nil error:error];
     return;
   }
 
@@ -536,7 +762,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   [grantedScopes unionSet:requestedScopes];
   options.scopes = [grantedScopes allObjects];
 
-  [self signInWithOptions:options];
+  [self signInWithOptions:options cancellationToken:cancellationToken];
 }
 
 #endif // TARGET_OS_OSX
@@ -551,6 +777,52 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 }
 
 - (void)disconnectWithCompletion:(nullable GIDDisconnectCompletion)completion {
+  [self disconnectWithDeadline:nil
+             cancellationToken:[[GIDCancellationToken alloc] init]
+                    completion:completion];
+}
+
+- (void)disconnectWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                             completion:(nullable GIDDisconnectCompletion)completion {
+  [self disconnectWithDeadline:nil cancellationToken:cancellationToken completion:completion];
+}
+
+- (void)disconnectWithTimeout:(NSTimeInterval)timeout
+                   completion:(nullable GIDDisconnectCompletion)completion {
+  [self disconnectWithTimeout:timeout
+            cancellationToken:[[GIDCancellationToken alloc] init]
+                   completion:completion];
+}
+
+- (void)disconnectWithTimeout:(NSTimeInterval)timeout
+            cancellationToken:(GIDCancellationToken *)cancellationToken
+                   completion:(nullable GIDDisconnectCompletion)completion {
+  [self disconnectWithDeadline:[NSDate dateWithTimeIntervalSinceNow:timeout]
+             cancellationToken:cancellationToken
+                    completion:completion];
+}
+
+// Disconnects the current user, failing once |deadline| passes unless it is nil, and stops once
+// |cancellationToken| is cancelled.
+- (void)disconnectWithDeadline:(nullable NSDate *)deadline
+             cancellationToken:(GIDCancellationToken *)cancellationToken
+                    completion:(nullable GIDDisconnectCompletion)completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
+  // Cancelled by the caller or by the deadline, without cancelling the caller's token.
+  GIDCancellationToken *disconnectCancellationToken = [[GIDCancellationToken alloc] init];
+  id<NSObject> registration = [cancellationToken addCancellationHandler:^{
+    [disconnectCancellationToken cancel];
+  }];
+  // Calls the completion unless the disconnect was cancelled. The caller's token may outlive the
+  // disconnect, so it only keeps its handler until then. Must be called on the main queue.
+  void (^finish)(NSError *_Nullable) = ^(NSError *_Nullable error) {
+    if (completion && !disconnectCancellationToken.isCancelled) {
+      completion(error);
+    }
+    [cancellationToken removeCancellationHandler:registration];
+  };
   OIDAuthState *authState = _currentUser.authState;
   if (!authState) {
     // Even the user is not signed in right now, we still need to remove any token saved in the
@@ -566,37 +838,66 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   if (!token) {
     [self signOut];
     // Nothing to do here, consider the operation successful.
-    if (completion) {
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(nil);
-      });
-    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+      finish(nil);
+    });
     return;
   }
-  NSString *revokeURLString = [NSString stringWithFormat:kRevokeTokenURLTemplate,
-      [GIDSignInPreferences googleAuthorizationServer], token];
-  // Append logging parameter
-  revokeURLString = [NSString stringWithFormat:@"%@&%@=%@&%@=%@",
-                     revokeURLString,
-                     kSDKVersionLoggingParameter,
-                     GIDVersion(),
-                     kEnvironmentLoggingParameter,
-                     GIDEnvironment()];
-  NSURL *revokeURL = [NSURL URLWithString:revokeURLString];
-  [self startFetchURL:revokeURL
-              fromAuthState:authState
-                withComment:@"GIDSignIn: revoke tokens"
-      withCompletionHandler:^(NSData *data, NSError *error) {
+  NSURLRequest *request =
+      [NSURLRequest requestWithURL:[GIDTokenRevocationQueue revokeURLForToken:token]];
+  GTMSessionFetcher *fetcher = [self fetcherWithRequest:request
+                                          fromAuthState:authState
+                                               deadline:deadline
+                                            withComment:@"GIDSignIn: revoke tokens"];
+  // Set on the main queue, where both the fetch and the deadline call back.
+  __block BOOL fetched = NO;
+  [fetcher beginFetchWithCompletionHandler:^(NSData *data, NSError *error) {
+    fetched = YES;
     // Revoking an already revoked token seems always successful, which helps us here.
     if (!error) {
       [self signOut];
     }
-    if (completion) {
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(error);
-      });
-    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+      finish(error);
+    });
   }];
+  // A stopped fetch doesn't call its completion, so the user stays signed in.
+  __weak GTMSessionFetcher *weakFetcher = fetcher;
+  [disconnectCancellationToken addCancellationHandler:^{
+    [weakFetcher stopFetching];
+  }];
+  if (deadline) {
+    GIDDispatchAtDeadline(deadline, ^{
+      if (fetched || disconnectCancellationToken.isCancelled) {
+        return;
+      }
+      [disconnectCancellationToken cancel];
+      if (completion) {
+        completion([self errorWithString:kTimedOutError code:kGIDSignInErrorCodeTimedOut]);
+      }
+      [cancellationToken removeCancellationHandler:registration];
+    });
+  }
+}
+
+- (void)disconnectInBackgroundWithCompletion:(nullable void (^)(void))completion {
+  OIDAuthState *authState = _currentUser.authState;
+  if (!authState) {
+    authState = [self loadAuthState];
+  }
+  // Prefer the refresh token, since the access token may expire before it can be revoked. Revoking
+  // either one revokes the grant.
+  NSString *token = authState.refreshToken;
+  if (!token) {
+    token = authState.lastTokenResponse.accessToken;
+  }
+  if (token) {
+    [_tokenRevocationQueue revokeToken:token completion:completion];
+  } else if (completion) {
+    // Nothing to revoke, consider the operation successful.
+    dispatch_async(dispatch_get_main_queue(), completion);
+  }
+  [self signOut];
 }
 
 #pragma mark - Custom getters and setters
@@ -656,9 +957,26 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 
 - (instancetype)initWithKeychainStore:(GTMKeychainStore *)keychainStore
             authStateMigrationService:(GIDAuthStateMigration *)authStateMigrationService {
+  GIDKeychainAuthStateStore *authStateStore =
+      [[GIDKeychainAuthStateStore alloc] initWithKeychainStore:keychainStore];
+  return [self initWithAuthStateStore:authStateStore
+            authStateMigrationService:authStateMigrationService];
+}
+
+- (instancetype)initWithAuthStateStore:(id<GIDAuthStateStore>)authStateStore
+             authStateMigrationService:(GIDAuthStateMigration *)authStateMigrationService {
   self = [super init];
   if (self) {
-    _keychainStore = keychainStore;
+    _authStateStore = authStateStore;
+    _authStateMigrationGroup = dispatch_group_create();
+    _authStateStoreQueue = dispatch_queue_create("com.google.googlesignin.GIDAuthStateStoreQueue",
+                                                 DISPATCH_QUEUE_SERIAL);
+    _joinedOptions = [NSMapTable strongToStrongObjectsMapTable];
+    _tokenRevocationQueue = [[GIDTokenRevocationQueue alloc]
+        initWithAuthStateStore:authStateStore
+                    storeQueue:_authStateStoreQueue
+               storeReadyGroup:_authStateMigrationGroup
+                fetcherService:nil];
     _claimsInternalOptions = [[GIDClaimsInternalOptions alloc] init];
 
     // Get the bundle of the current executable.
@@ -684,10 +1002,17 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     _appAuthConfiguration = [[OIDServiceConfiguration alloc]
                              initWithAuthorizationEndpoint:[NSURL URLWithString:authorizationEnpointURL]
                              tokenEndpoint:[NSURL URLWithString:tokenEndpointURL]];
-    // Perform migration of auth state from old versions of the SDK if needed.
-    [authStateMigrationService migrateIfNeededWithTokenURL:_appAuthConfiguration.tokenEndpoint
-                                              callbackPath:kBrowserCallbackPath
-                                            isFreshInstall:isFreshInstall];
+    // Perform migration of auth state from old versions of the SDK if needed. It touches the
+    // keychain, so it is kept off the calling thread.
+    NSURL *tokenEndpoint = _appAuthConfiguration.tokenEndpoint;
+    dispatch_group_async(_authStateMigrationGroup,
+                         dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+      [authStateMigrationService migrateIfNeededWithTokenURL:tokenEndpoint
+                                                callbackPath:kBrowserCallbackPath
+                                              isFreshInstall:isFreshInstall];
+    });
+    // Revoke the tokens left over from users disconnected in the background before a relaunch.
+    [_tokenRevocationQueue resume];
   }
   return self;
 }
@@ -708,6 +1033,18 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 
 // Does sanity check for parameters and then authenticates if necessary.
 - (void)signInWithOptions:(GIDSignInInternalOptions *)options {
+  // Callers that ask for the same flow as the one in progress, such as several subsystems restoring
+  // the previous sign-in at launch, share its result rather than replacing it.
+  GIDSignInInternalOptions *flowOptions = _currentOptions;
+  NSMutableArray<GIDSignInInternalOptions *> *joinedOptions =
+      flowOptions ? [_joinedOptions objectForKey:flowOptions] : nil;
+  if (joinedOptions && [options isEquivalentToOptions:flowOptions]) {
+    [joinedOptions addObject:options];
+    [self abandonSignInWithOptions:flowOptions whenCancelled:options.cancellationToken];
+    [self timeOutSignInWithOptions:options joinedToOptions:flowOptions];
+    return;
+  }
+
   // Options for continuation are not the options we want to cache. The purpose of caching the
   // options in the first place is to provide continuation flows with a starting place from which to
   // derive suitable options for the continuation!
@@ -731,9 +1068,8 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     [self assertValidPresentingViewController];
 
     // If the application does not support the required URL schemes tell the developer so.
-    GIDSignInCallbackSchemes *schemes =
-        [[GIDSignInCallbackSchemes alloc] initWithClientIdentifier:options.configuration.clientID];
-    NSArray<NSString *> *unsupportedSchemes = [schemes unsupportedSchemes];
+    NSArray<NSString *> *unsupportedSchemes =
+        [self requestTemplateForConfiguration:options.configuration].unsupportedSchemes;
     if (unsupportedSchemes.count != 0) {
       // NOLINTNEXTLINE(google-objc-avoid-throwing-exception)
       [NSException raise:NSInvalidArgumentException
@@ -742,20 +1078,23 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     }
   }
 
+  if (!options.continuation) {
+    [_joinedOptions setObject:[NSMutableArray array] forKey:options];
+    [self abandonSignInWithOptions:options whenCancelled:options.cancellationToken];
+    [self timeOutSignInWithOptions:options joinedToOptions:options];
+  }
+
   // If this is a non-interactive flow, use cached authentication if possible.
   if (!options.interactive && _currentUser) {
-    [_currentUser refreshTokensIfNeededWithCompletion:^(GIDGoogleUser *unused, NSError *error) {
+    [_currentUser refreshTokensIfNeededWithCancellationToken:options.flowCancellationToken
+                                                  completion:^(GIDGoogleUser *unused,
+                                                               NSError *error) {
       if (error) {
         [self authenticateWithOptions:options];
       } else {
-        if (options.completion) {
-          self->_currentOptions = nil;
-          dispatch_async(dispatch_get_main_queue(), ^{
-            GIDSignInResult *signInResult =
-                [[GIDSignInResult alloc] initWithGoogleUser:self->_currentUser serverAuthCode:nil];
-            options.completion(signInResult, nil);
-          });
-        }
+        GIDSignInResult *signInResult =
+            [[GIDSignInResult alloc] initWithGoogleUser:self->_currentUser serverAuthCode:nil];
+        [self completeSignInWithOptions:options result:signInResult error:nil];
       }
     }];
   } else {
@@ -768,12 +1107,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                               validatedJSONStringForClaims:options.claims
                                                      error:&claimsError];
       if (claimsError) {
-        if (options.completion) {
-          _currentOptions = nil;
-          dispatch_async(dispatch_get_main_queue(), ^{
-            options.completion(nil, claimsError);
-          });
-        }
+        [self completeSignInWithOptions:options result:nil error:claimsError];
         return;
       }
     }
@@ -781,6 +1115,106 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   }
 }
 
+// Starts the flow of |options| and cancels it once |cancellationToken| is cancelled.
+- (void)signInWithOptions:(GIDSignInInternalOptions *)options
+        cancellationToken:(GIDCancellationToken *)cancellationToken {
+  [self signInWithOptions:options];
+  GIDCancellationToken *requestCancellationToken = options.cancellationToken;
+  id<NSObject> registration = [cancellationToken addCancellationHandler:^{
+    [requestCancellationToken cancel];
+  }];
+  // The caller's token may outlive the request, so it only keeps the handler until then.
+  options.finishHandler = ^{
+    [cancellationToken removeCancellationHandler:registration];
+  };
+}
+
+// Abandons the flow started with |flowOptions| once |cancellationToken| is cancelled, unless
+// another request is still waiting for the flow by then.
+- (void)abandonSignInWithOptions:(GIDSignInInternalOptions *)flowOptions
+                   whenCancelled:(GIDCancellationToken *)cancellationToken {
+  __weak GIDSignIn *weakSelf = self;
+  __weak GIDSignInInternalOptions *weakFlowOptions = flowOptions;
+  [cancellationToken addCancellationHandler:^{
+    // The flow is only driven from the main queue.
+    dispatch_block_t abandon = ^{
+      [weakSelf abandonSignInIfCancelledWithOptions:weakFlowOptions];
+    };
+    if ([NSThread isMainThread]) {
+      abandon();
+    } else {
+      dispatch_async(dispatch_get_main_queue(), abandon);
+    }
+  }];
+}
+
+// Abandons the flow started with |flowOptions| if every request waiting for it was cancelled, so
+// that an equivalent request starts a new flow rather than joining this one.
+- (void)abandonSignInIfCancelledWithOptions:(nullable GIDSignInInternalOptions *)flowOptions {
+  if (!flowOptions.cancellationToken.isCancelled) {
+    return;
+  }
+  for (GIDSignInInternalOptions *joinedOptions in [_joinedOptions objectForKey:flowOptions]) {
+    if (!joinedOptions.cancellationToken.isCancelled) {
+      return;
+    }
+  }
+  [_joinedOptions removeObjectForKey:flowOptions];
+  if (flowOptions == _currentOptions) {
+    _currentOptions = nil;
+  }
+  [flowOptions.flowCancellationToken cancel];
+}
+
+// Returns the deadline of work shared by the requests waiting for the flow started with
+// |flowOptions|, which is the latest of their deadlines, or nil if any of them has none. The shared
+// work then doesn't fail a request before its own deadline, by which each request times out anyway.
+- (nullable NSDate *)sharedDeadlineForSignInWithOptions:(GIDSignInInternalOptions *)flowOptions {
+  NSDate *deadline = flowOptions.deadline;
+  if (!deadline) {
+    return nil;
+  }
+  for (GIDSignInInternalOptions *joinedOptions in [_joinedOptions objectForKey:flowOptions]) {
+    if (!joinedOptions.deadline) {
+      return nil;
+    }
+    deadline = [deadline laterDate:joinedOptions.deadline];
+  }
+  return deadline;
+}
+
+// Fails the request made with |options| with a timeout error once its deadline passes, unless the
+// flow started with |flowOptions| has completed it by then. The request is cancelled, so the flow
+// is abandoned unless another request is still waiting for it.
+- (void)timeOutSignInWithOptions:(GIDSignInInternalOptions *)options
+                 joinedToOptions:(GIDSignInInternalOptions *)flowOptions {
+  if (!options.deadline) {
+    return;
+  }
+  __weak GIDSignIn *weakSelf = self;
+  GIDDispatchAtDeadline(options.deadline, ^{
+    GIDSignIn *strongSelf = weakSelf;
+    if (!strongSelf || options.cancellationToken.isCancelled) {
+      return;
+    }
+    // A completed flow is no longer in |_joinedOptions|, and its completions are already queued.
+    NSArray<GIDSignInInternalOptions *> *joinedOptions =
+        [strongSelf->_joinedOptions objectForKey:flowOptions];
+    if (!joinedOptions || (options != flowOptions &&
+                           [joinedOptions indexOfObjectIdenticalTo:options] == NSNotFound)) {
+      return;
+    }
+    [options.cancellationToken cancel];
+    if (options.completion) {
+      options.completion(nil, [strongSelf errorWithString:kTimedOutError
+                                                     code:kGIDSignInErrorCodeTimedOut]);
+    }
+    if (options.finishHandler) {
+      options.finishHandler();
+    }
+  });
+}
+
 #pragma mark - Authentication flow
 
 - (void)authenticateInteractivelyWithOptions:(GIDSignInInternalOptions *)options {
@@ -794,7 +1228,12 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   [self authorizationRequestWithOptions:options
                              completion:^(OIDAuthorizationRequest * _Nullable request,
                                           NSError * _Nullable error) {
-    self->_currentAuthorizationFlow =
+    GIDCancellationToken *flowCancellationToken = options.flowCancellationToken;
+    // The flow may have been abandoned while the App Check token was fetched.
+    if (flowCancellationToken.isCancelled) {
+      return;
+    }
+    id<OIDExternalUserAgentSession> session =
         [OIDAuthorizationService presentAuthorizationRequest:request
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
                                     presentingViewController:options.presentingViewController
@@ -804,9 +1243,27 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                                                     callback:
                                                       ^(OIDAuthorizationResponse *_Nullable authorizationResponse,
                                                         NSError *_Nullable error) {
+      // An abandoned flow's session is cancelled, and its error is no one's to handle.
+      if (flowCancellationToken.isCancelled) {
+        return;
+      }
       [self processAuthorizationResponse:authorizationResponse
                                    error:error
-                              emmSupport:emmSupport];
+                              emmSupport:emmSupport
+                                 options:options];
+    }];
+    self->_currentAuthorizationFlow = session;
+    self->_currentAuthorizationFlowOptions = options;
+    __weak GIDSignIn *weakSelf = self;
+    __weak id<OIDExternalUserAgentSession> weakSession = session;
+    [flowCancellationToken addCancellationHandler:^{
+      GIDSignIn *strongSelf = weakSelf;
+      id<OIDExternalUserAgentSession> strongSession = weakSession;
+      if (strongSelf && strongSession && strongSelf->_currentAuthorizationFlow == strongSession) {
+        strongSelf->_currentAuthorizationFlow = nil;
+        strongSelf->_currentAuthorizationFlowOptions = nil;
+        [strongSession cancel];
+      }
     }];
   }];
 }
@@ -829,9 +1286,9 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       if (!_timedLoader) {
         _timedLoader = [[GIDTimedLoader alloc] initWithPresentingViewController:presentingVC];
       }
-      [_timedLoader startTiming];
-      [self->_appCheck getLimitedUseTokenWithCompletion:^(GACAppCheckToken * _Nullable token,
-                                                          NSError * _Nullable error) {
+      BOOL tokenIsReady =
+          [self->_appCheck getLimitedUseTokenWithCompletion:^(GACAppCheckToken * _Nullable token,
+                                                              NSError * _Nullable error) {
         if (token) {
           additionalParameters[kClientAssertionTypeParameter] = kClientAssertionTypeParameterValue;
           additionalParameters[kClientAssertionParameter] = token.token;
@@ -851,6 +1308,11 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
           completion(request, error);
         }
       }];
+      // A prefetched token was taken for this request, so there is nothing to show a loader for.
+      // The completion is called asynchronously on the main queue, after the loader has started.
+      if (!tokenIsReady) {
+        [_timedLoader startTiming];
+      }
     }
   }
 #endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
@@ -894,48 +1356,33 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   emmSupport = nil;
 #endif // TARGET_OS_MACCATALYST || TARGET_OS_OSX
 
-  NSMutableDictionary<NSString *, NSString *> *additionalParameters =
-      [[NSMutableDictionary alloc] init];
-  additionalParameters[kIncludeGrantedScopesParameter] = @"true";
-  if (options.configuration.serverClientID) {
-    additionalParameters[kAudienceParameter] = options.configuration.serverClientID;
-  }
-  if (options.loginHint) {
-    additionalParameters[kLoginHintParameter] = options.loginHint;
-  }
-  if (options.configuration.hostedDomain) {
-    additionalParameters[kHostedDomainParameter] = options.configuration.hostedDomain;
-  }
-  if (options.claimsAsJSON) {
-    additionalParameters[kClaimsParameter] = options.claimsAsJSON;
-  }
-
-#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
-  [additionalParameters addEntriesFromDictionary:
-      [GIDEMMSupport parametersWithParameters:options.extraParams
-                                   emmSupport:emmSupport
-                       isPasscodeInfoRequired:NO]];
-#elif TARGET_OS_OSX || TARGET_OS_MACCATALYST
-  [additionalParameters addEntriesFromDictionary:options.extraParams];
-#endif // TARGET_OS_OSX || TARGET_OS_MACCATALYST
-  additionalParameters[kSDKVersionLoggingParameter] = GIDVersion();
-  additionalParameters[kEnvironmentLoggingParameter] = GIDEnvironment();
-
-  return additionalParameters;
+  return [[self requestTemplateForConfiguration:options.configuration]
+      additionalParametersWithOptions:options
+                           emmSupport:emmSupport];
 }
 
 - (NSURL *)redirectURLWithOptions:(GIDSignInInternalOptions *)options {
-  GIDSignInCallbackSchemes *schemes =
-      [[GIDSignInCallbackSchemes alloc] initWithClientIdentifier:options.configuration.clientID];
-  NSURL *redirectURL = [NSURL URLWithString:[NSString stringWithFormat:@"%@:%@",
-                                             [schemes clientIdentifierScheme],
-                                             kBrowserCallbackPath]];
-  return redirectURL;
+  return [self requestTemplateForConfiguration:options.configuration].redirectURL;
 }
 
+// Returns the request template for |configuration|, building it only if the configuration changed
+// since the last sign-in.
+- (GIDAuthorizationRequestTemplate *)requestTemplateForConfiguration:
+    (GIDConfiguration *)configuration {
+  if (![_requestTemplate isValidForConfiguration:configuration]) {
+    _requestTemplate = [[GIDAuthorizationRequestTemplate alloc]
+        initWithConfiguration:configuration
+                 callbackPath:kBrowserCallbackPath];
+  }
+  return _requestTemplate;
+}
+
+// Completes the interactive flow presented with |options| with the authorization response. A
+// continuation completes the requests of the flow it carries on.
 - (void)processAuthorizationResponse:(OIDAuthorizationResponse *)authorizationResponse
                                error:(NSError *)error
-                          emmSupport:(NSString *)emmSupport {
+                          emmSupport:(NSString *)emmSupport
+                             options:(GIDSignInInternalOptions *)options {
   if (_restarting) {
     // The auth flow is restarting, so the work here would be performed in the next round.
     _restarting = NO;
@@ -944,6 +1391,8 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 
   GIDAuthFlow *authFlow = [[GIDAuthFlow alloc] init];
   authFlow.emmSupport = emmSupport;
+  // Read from the flow rather than |_currentOptions|, which another flow may have replaced since.
+  authFlow.options = options.flowOptions;
 
   if (authorizationResponse) {
     if (authorizationResponse.authorizationCode.length) {
@@ -1002,26 +1451,33 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     return;
   }
 
-  // Try retrieving an authorization object from the keychain.
-  OIDAuthState *authState = [self loadAuthState];
+  // Try retrieving an authorization object from the keychain, unless the caller already did.
+  OIDAuthState *authState =
+      options.hasRestoredAuthState ? options.restoredAuthState : [self loadAuthState];
 
   if (![authState isAuthorized]) {
     // No valid auth in keychain, per documentation/spec, notify callback of failure.
     NSError *error = [NSError errorWithDomain:kGIDSignInErrorDomain
                                          code:kGIDSignInErrorCodeHasNoAuthInKeychain
                                      userInfo:nil];
-    if (options.completion) {
-      _currentOptions = nil;
-      dispatch_async(dispatch_get_main_queue(), ^{
-        options.completion(nil, error);
-      });
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+    if (@available(iOS 14.0, *)) {
+      // Without a previous sign-in the user has to sign in interactively next, which needs a
+      // limited use token, so start fetching one now.
+      if ([_appCheck isPrepared] || _configureAppCheckCalled) {
+        [_appCheck prefetchLimitedUseToken];
+      }
     }
+#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+    [self completeSignInWithOptions:options result:nil error:error];
     return;
   }
 
   // Complete the auth flow using saved auth in keychain.
   GIDAuthFlow *authFlow = [[GIDAuthFlow alloc] init];
   authFlow.authState = authState;
+  authFlow.persistence = kGIDAuthFlowPersistenceNone;
+  authFlow.options = options;
   [self maybeFetchToken:authFlow];
   [self addDecodeIdTokenCallback:authFlow];
   [self addSaveAuthCallback:authFlow];
@@ -1032,18 +1488,19 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 - (void)maybeFetchToken:(GIDAuthFlow *)authFlow {
   OIDAuthState *authState = authFlow.authState;
   // Do nothing if we have an auth flow error or a restored access token that isn't near expiration.
-  if (authFlow.error ||
+  if (authFlow.error || authFlow.isAbandoned ||
       (authState.lastTokenResponse.accessToken &&
         [authState.lastTokenResponse.accessTokenExpirationDate timeIntervalSinceNow] >
         kMinimumRestoredAccessTokenTimeToExpire)) {
     return;
   }
   NSMutableDictionary<NSString *, NSString *> *additionalParameters = [@{} mutableCopy];
-  if (_currentOptions.configuration.serverClientID) {
-    additionalParameters[kAudienceParameter] = _currentOptions.configuration.serverClientID;
+  GIDConfiguration *configuration = authFlow.options.configuration;
+  if (configuration.serverClientID) {
+    additionalParameters[kAudienceParameter] = configuration.serverClientID;
   }
-  if (_currentOptions.configuration.openIDRealm) {
-    additionalParameters[kOpenIDRealmParameter] = _currentOptions.configuration.openIDRealm;
+  if (configuration.openIDRealm) {
+    additionalParameters[kOpenIDRealmParameter] = configuration.openIDRealm;
   }
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
   NSDictionary<NSString *, NSObject *> *params =
@@ -1062,7 +1519,11 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       authState.lastAuthorizationResponse.authorizationCode) {
     tokenRequest = [authState.lastAuthorizationResponse
         tokenExchangeRequestWithAdditionalParameters:additionalParameters];
+    authFlow.persistence = kGIDAuthFlowPersistenceAuthSession;
   } else {
+    if (authFlow.persistence == kGIDAuthFlowPersistenceNone) {
+      authFlow.persistence = kGIDAuthFlowPersistenceTokenResponse;
+    }
     [additionalParameters
         addEntriesFromDictionary:authState.lastTokenResponse.request.additionalParameters];
     tokenRequest = [authState tokenRefreshRequestWithAdditionalParameters:additionalParameters];
@@ -1097,17 +1558,37 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   [authFlow addCallback:^() {
     GIDAuthFlow *handlerAuthFlow = weakAuthFlow;
     OIDAuthState *authState = handlerAuthFlow.authState;
-    if (authState && !handlerAuthFlow.error) {
-      if (![self saveAuthState:authState]) {
+    if (authState && !handlerAuthFlow.error && !handlerAuthFlow.isAbandoned) {
+      GIDAuthFlowPersistence persistence = handlerAuthFlow.persistence;
+      BOOL saved = YES;
+      if (persistence != kGIDAuthFlowPersistenceNone && self.persistsAuthStateAsynchronously) {
+        [self saveAuthStateInBackground:authState
+                      tokenResponseOnly:persistence == kGIDAuthFlowPersistenceTokenResponse];
+      } else {
+        switch (persistence) {
+          case kGIDAuthFlowPersistenceAuthSession:
+            saved = [self saveAuthState:authState];
+            break;
+          case kGIDAuthFlowPersistenceTokenResponse:
+            saved = [self saveTokenResponseOfAuthState:authState];
+            break;
+          case kGIDAuthFlowPersistenceNone:
+            break;
+        }
+      }
+      if (!saved) {
         handlerAuthFlow.error = [self errorWithString:kKeychainError
                                                  code:kGIDSignInErrorCodeKeychain];
         return;
       }
 
-      if (self->_currentOptions.addScopesFlow) {
+      if (handlerAuthFlow.options.addScopesFlow) {
+        // Keep a profile loaded after a sign-in that deferred it.
+        GIDProfileData *profileData =
+            handlerAuthFlow.profileData ?: self->_currentUser.profile;
         [self->_currentUser updateWithTokenResponse:authState.lastTokenResponse
                               authorizationResponse:authState.lastAuthorizationResponse
-                                        profileData:handlerAuthFlow.profileData];
+                                        profileData:profileData];
       } else {
         GIDGoogleUser *user = [[GIDGoogleUser alloc] initWithAuthState:authState
                                                            profileData:handlerAuthFlow.profileData];
@@ -1124,7 +1605,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   [authFlow addCallback:^() {
     GIDAuthFlow *handlerAuthFlow = weakAuthFlow;
     OIDAuthState *authState = handlerAuthFlow.authState;
-    if (!authState || handlerAuthFlow.error) {
+    if (!authState || handlerAuthFlow.error || handlerAuthFlow.isAbandoned) {
       return;
     }
     OIDIDToken *idToken =
@@ -1134,71 +1615,246 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       handlerAuthFlow.profileData = [self profileDataWithIDToken:idToken];
     }
 
-    // If we can't retrieve profile data from the ID token, make a userInfo request to fetch them.
-    if (!handlerAuthFlow.profileData) {
+    // If we can't retrieve profile data from the ID token, make a userInfo request to fetch them,
+    // unless the profile is to be loaded later.
+    if (!handlerAuthFlow.profileData && !self.defersProfileLoading) {
       [handlerAuthFlow wait];
-      NSURL *infoURL = [NSURL URLWithString:
-          [NSString stringWithFormat:kUserInfoURLTemplate,
-              [GIDSignInPreferences googleUserInfoServer],
-              authState.lastTokenResponse.accessToken]];
-      [self startFetchURL:infoURL
-                  fromAuthState:authState
-                    withComment:@"GIDSignIn: fetch basic profile info"
-          withCompletionHandler:^(NSData *data, NSError *error) {
-        if (data && !error) {
-          NSError *jsonDeserializationError;
-          NSDictionary<NSString *, NSString *> *profileDict =
-              [NSJSONSerialization JSONObjectWithData:data
-                                              options:NSJSONReadingMutableContainers
-                                                error:&jsonDeserializationError];
-          if (profileDict) {
-            handlerAuthFlow.profileData = [[GIDProfileData alloc]
-                initWithEmail:idToken.claims[kBasicProfileEmailKey]
-                          name:profileDict[kBasicProfileNameKey]
-                    givenName:profileDict[kBasicProfileGivenNameKey]
-                    familyName:profileDict[kBasicProfileFamilyNameKey]
-                      imageURL:[NSURL URLWithString:profileDict[kBasicProfilePictureKey]]];
-          }
-        }
+      // The fetch is shared by every request waiting for the flow, including those that join
+      // before it starts, so it is only given a deadline once it starts.
+      GIDSignInInternalOptions *flowOptions = handlerAuthFlow.options;
+      __weak GIDSignIn *weakSelf = self;
+      NSDate *_Nullable (^deadlineProvider)(void) = ^NSDate *_Nullable {
+        return [weakSelf sharedDeadlineForSignInWithOptions:flowOptions];
+      };
+      GIDCancellationToken *fetchCancellationToken =
+          [self fetchProfileDataWithAuthState:authState
+                                      idToken:idToken
+                             deadlineProvider:deadlineProvider
+                                   completion:^(GIDProfileData *profileData, NSError *error) {
+        handlerAuthFlow.profileData = profileData;
         if (error) {
           handlerAuthFlow.error = error;
         }
         [handlerAuthFlow next];
       }];
+      [handlerAuthFlow.options.flowCancellationToken addCancellationHandler:^{
+        [fetchCancellationToken cancel];
+      }];
+    }
+  }];
+}
+
+- (GIDCancellationToken *)fetchProfileDataWithAuthState:(OIDAuthState *)authState
+                                                idToken:(nullable OIDIDToken *)idToken
+                                             completion:
+    (void (^)(GIDProfileData *_Nullable profileData, NSError *_Nullable error))completion {
+  return [self fetchProfileDataWithAuthState:authState
+                                     idToken:idToken
+                            deadlineProvider:nil
+                                  completion:completion];
+}
+
+// Fetches the basic profile like |fetchProfileDataWithAuthState:idToken:completion:|, fitting the
+// fetch and its retries before the deadline |deadlineProvider| returns when the fetch starts,
+// unless it is nil or returns nil.
+- (GIDCancellationToken *)fetchProfileDataWithAuthState:(OIDAuthState *)authState
+                                                idToken:(nullable OIDIDToken *)idToken
+                                       deadlineProvider:
+    (nullable NSDate *_Nullable (^)(void))deadlineProvider
+                                             completion:
+    (void (^)(GIDProfileData *_Nullable profileData, NSError *_Nullable error))completion {
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  NSString *userID = idToken.subject;
+  if (!userID) {
+    [self fetchProfileDataWithAuthState:authState
+                                idToken:idToken
+                           cachedRecord:nil
+                               deadline:deadlineProvider ? deadlineProvider() : nil
+                      cancellationToken:cancellationToken
+                             completion:completion];
+    return cancellationToken;
+  }
+  // The saved profile is read on the store queue rather than blocking the caller on the keychain,
+  // and the fetch is started back on the main queue.
+  dispatch_async(_authStateStoreQueue, ^{
+    [self waitForAuthStateMigration];
+    GIDUserInfoRecord *savedRecord = [self->_authStateStore retrieveUserInfoRecordWithError:nil];
+    GIDUserInfoRecord *cachedRecord =
+        [savedRecord.userID isEqualToString:userID] ? savedRecord : nil;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      [self fetchProfileDataWithAuthState:authState
+                                  idToken:idToken
+                             cachedRecord:cachedRecord
+                                 deadline:deadlineProvider ? deadlineProvider() : nil
+                        cancellationToken:cancellationToken
+                               completion:completion];
+    });
+  });
+  return cancellationToken;
+}
+
+// Fetches the basic profile, revalidating |cachedRecord| if it is given, unless
+// |cancellationToken| has been cancelled by then.
+- (void)fetchProfileDataWithAuthState:(OIDAuthState *)authState
+                              idToken:(nullable OIDIDToken *)idToken
+                         cachedRecord:(nullable GIDUserInfoRecord *)cachedRecord
+                             deadline:(nullable NSDate *)deadline
+                    cancellationToken:(GIDCancellationToken *)cancellationToken
+                           completion:
+    (void (^)(GIDProfileData *_Nullable profileData, NSError *_Nullable error))completion {
+  if (cancellationToken.isCancelled) {
+    return;
+  }
+  NSURL *infoURL = [NSURL URLWithString:
+      [NSString stringWithFormat:kUserInfoURLTemplate,
+          [GIDSignInPreferences googleUserInfoServer],
+          authState.lastTokenResponse.accessToken]];
+  NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:infoURL];
+  NSString *userID = idToken.subject;
+  if (cachedRecord) {
+    // The validators are handled here rather than by the URL cache, which doesn't outlive it.
+    request.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    [cachedRecord addValidatorsToRequest:request];
+  }
+  GTMSessionFetcher *fetcher = [self fetcherWithRequest:request
+                                          fromAuthState:authState
+                                               deadline:deadline
+                                            withComment:@"GIDSignIn: fetch basic profile info"];
+  __weak GTMSessionFetcher *weakFetcher = fetcher;
+  [fetcher beginFetchWithCompletionHandler:^(NSData *data, NSError *error) {
+    if (cancellationToken.isCancelled) {
+      return;
+    }
+    if (cachedRecord && [error.domain isEqualToString:kGTMSessionFetcherStatusDomain] &&
+        error.code == GTMSessionFetcherStatusNotModified) {
+      completion(cachedRecord.profileData, nil);
+      return;
+    }
+    GIDProfileData *profileData;
+    if (data && !error) {
+      NSError *jsonDeserializationError;
+      NSDictionary<NSString *, NSString *> *profileDict =
+          [NSJSONSerialization JSONObjectWithData:data
+                                          options:0
+                                            error:&jsonDeserializationError];
+      if ([profileDict isKindOfClass:[NSDictionary class]]) {
+        profileData = [[GIDProfileData alloc]
+            initWithEmail:idToken.claims[kBasicProfileEmailKey]
+                      name:profileDict[kBasicProfileNameKey]
+                givenName:profileDict[kBasicProfileGivenNameKey]
+                familyName:profileDict[kBasicProfileFamilyNameKey]
+                  imageURL:[NSURL URLWithString:profileDict[kBasicProfilePictureKey]]];
+      }
     }
+    if (profileData && userID) {
+      [self saveProfileData:profileData
+                  forUserID:userID
+               withResponse:weakFetcher.response];
+    }
+    completion(profileData, error);
+  }];
+  [cancellationToken addCancellationHandler:^{
+    [weakFetcher stopFetching];
   }];
 }
 
+// Saves |profileData| along with the validators of the userinfo |response| it was parsed from, if
+// it has any.
+- (void)saveProfileData:(GIDProfileData *)profileData
+              forUserID:(NSString *)userID
+           withResponse:(nullable NSURLResponse *)response {
+  if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+    return;
+  }
+  NSString *entityTag;
+  NSString *lastModified;
+  // Header names are case-insensitive, but |allHeaderFields| keeps them as received.
+  NSDictionary *headers = ((NSHTTPURLResponse *)response).allHeaderFields;
+  for (NSString *name in headers) {
+    if ([name caseInsensitiveCompare:@"ETag"] == NSOrderedSame) {
+      entityTag = headers[name];
+    } else if ([name caseInsensitiveCompare:@"Last-Modified"] == NSOrderedSame) {
+      lastModified = headers[name];
+    }
+  }
+  if (!entityTag && !lastModified) {
+    return;
+  }
+  GIDUserInfoRecord *record = [[GIDUserInfoRecord alloc] initWithUserID:userID
+                                                            profileData:profileData
+                                                              entityTag:entityTag
+                                                           lastModified:lastModified];
+  dispatch_async(_authStateStoreQueue, ^{
+    [self waitForAuthStateMigration];
+    [self->_authStateStore saveUserInfoRecord:record error:nil];
+  });
+}
+
 // Adds a callback to the auth flow to complete the flow by calling the sign-in callback.
 - (void)addCompletionCallback:(GIDAuthFlow *)authFlow {
   __weak GIDAuthFlow *weakAuthFlow = authFlow;
   [authFlow addCallback:^() {
     GIDAuthFlow *handlerAuthFlow = weakAuthFlow;
-    if (self->_currentOptions.completion) {
-      GIDSignInCompletion completion = self->_currentOptions.completion;
-      self->_currentOptions = nil;
-      dispatch_async(dispatch_get_main_queue(), ^{
-        if (handlerAuthFlow.error) {
-          completion(nil, handlerAuthFlow.error);
-        } else {
-          OIDAuthState *authState = handlerAuthFlow.authState;
-          NSString *_Nullable serverAuthCode =
-              [authState.lastTokenResponse.additionalParameters[@"server_code"] copy];
-          GIDSignInResult *signInResult =
-              [[GIDSignInResult alloc] initWithGoogleUser:self->_currentUser
-                                           serverAuthCode:serverAuthCode];
-          completion(signInResult, nil);
-        }
-      });
+    GIDSignInInternalOptions *options = handlerAuthFlow.options;
+    if (!options) {
+      return;
+    }
+    if (handlerAuthFlow.error) {
+      [self completeSignInWithOptions:options result:nil error:handlerAuthFlow.error];
+    } else {
+      OIDAuthState *authState = handlerAuthFlow.authState;
+      NSString *_Nullable serverAuthCode =
+          [authState.lastTokenResponse.additionalParameters[@"server_code"] copy];
+      GIDSignInResult *signInResult =
+          [[GIDSignInResult alloc] initWithGoogleUser:self->_currentUser
+                                       serverAuthCode:serverAuthCode];
+      [self completeSignInWithOptions:options result:signInResult error:nil];
     }
   }];
 }
 
-- (void)startFetchURL:(NSURL *)URL
-            fromAuthState:(OIDAuthState *)authState
-              withComment:(NSString *)comment
-    withCompletionHandler:(void (^)(NSData *, NSError *))handler {
-  NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:URL];
+// Calls the completion of the sign-in flow started with |options|, and those of the requests that
+// joined it, with the same result on the main queue, skipping the requests that were cancelled.
+- (void)completeSignInWithOptions:(GIDSignInInternalOptions *)options
+                           result:(nullable GIDSignInResult *)signInResult
+                            error:(nullable NSError *)error {
+  NSMutableArray<GIDSignInInternalOptions *> *requests = [NSMutableArray arrayWithObject:options];
+  NSArray<GIDSignInInternalOptions *> *joinedOptions = [_joinedOptions objectForKey:options];
+  if (joinedOptions) {
+    [requests addObjectsFromArray:joinedOptions];
+    [_joinedOptions removeObjectForKey:options];
+  }
+  if (options == _currentOptions) {
+    _currentOptions = nil;
+  }
+  dispatch_async(dispatch_get_main_queue(), ^{
+    for (GIDSignInInternalOptions *request in requests) {
+      // Checked here rather than above, so a request cancelled in the meantime isn't completed.
+      if (request.completion && !request.cancellationToken.isCancelled) {
+        request.completion(signInResult, error);
+      }
+      if (request.finishHandler) {
+        request.finishHandler();
+      }
+    }
+  });
+}
+
+// Creates a fetcher for |request| from the fetcher service of |authState|'s session, if any. With a
+// |deadline|, the request times out and retries stop by then.
+- (GTMSessionFetcher *)fetcherWithRequest:(NSURLRequest *)request
+                            fromAuthState:(OIDAuthState *)authState
+                                 deadline:(nullable NSDate *)deadline
+                              withComment:(NSString *)comment {
+  NSTimeInterval maxRetryInterval = kFetcherMaxRetryInterval;
+  if (deadline) {
+    NSTimeInterval timeoutInterval =
+        MAX([deadline timeIntervalSinceNow], kMinimumFetchTimeoutInterval);
+    NSMutableURLRequest *timedRequest = [request mutableCopy];
+    timedRequest.timeoutInterval = timeoutInterval;
+    request = timedRequest;
+    maxRetryInterval = MIN(maxRetryInterval, timeoutInterval);
+  }
   GTMSessionFetcher *fetcher;
   GTMAuthSession *authorization = [[GTMAuthSession alloc] initWithAuthState:authState];
   id<GTMSessionFetcherServiceProtocol> fetcherService = authorization.fetcherService;
@@ -1208,9 +1864,9 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
     fetcher = [GTMSessionFetcher fetcherWithRequest:request];
   }
   fetcher.retryEnabled = YES;
-  fetcher.maxRetryInterval = kFetcherMaxRetryInterval;
+  fetcher.maxRetryInterval = maxRetryInterval;
   fetcher.comment = comment;
-  [fetcher beginFetchWithCompletionHandler:handler];
+  return fetcher;
 }
 
 // Parse incoming URL from the Google Device Policy app.
@@ -1223,12 +1879,13 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   if (![@"restart_auth" isEqualToString:actionString]) {
     return NO;
   }
+  GIDSignInInternalOptions *options = _currentAuthorizationFlowOptions;
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
-  if (!_currentOptions.presentingViewController) {
+  if (!options.presentingViewController) {
     return NO;
   }
 #elif TARGET_OS_OSX
-  if (!_currentOptions.presentingWindow) {
+  if (!options.presentingWindow) {
     return NO;
   }
 #endif // TARGET_OS_OSX
@@ -1238,6 +1895,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   _restarting = YES;
   [_currentAuthorizationFlow cancel];
   _currentAuthorizationFlow = nil;
+  _currentAuthorizationFlowOptions = nil;
   _restarting = NO;
   NSDictionary<NSString *, NSString *> *extraParameters = @{ kEMMRestartAuthParameter : @"1" };
   // In iOS 13 the presentation of ASWebAuthenticationSession needs an anchor window,
@@ -1246,14 +1904,30 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
   dispatch_after(dispatch_time(DISPATCH_TIME_NOW,
                  (int64_t)(kPresentationDelayAfterCancel * NSEC_PER_SEC)),
                  dispatch_get_main_queue(), ^{
-    [self signInWithOptions:[self->_currentOptions optionsWithExtraParameters:extraParameters
-                                                              forContinuation:YES]];
+    [self signInWithOptions:[options optionsWithExtraParameters:extraParameters
+                                                forContinuation:YES]];
   });
   return YES;
 }
 
 #pragma mark - Helpers
 
+// Classifies a URL path handled by |handleURL:| with a single hash lookup.
++ (GIDCallbackURLType)callbackURLTypeForPath:(nullable NSString *)path {
+  static NSDictionary<NSString *, NSNumber *> *callbackURLTypes;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    callbackURLTypes = @{
+      kBrowserCallbackPath : @(GIDCallbackURLTypeBrowser),
+      kEMMCallbackPath : @(GIDCallbackURLTypeEMM),
+    };
+  });
+  if (!path) {
+    return GIDCallbackURLTypeNone;
+  }
+  return (GIDCallbackURLType)callbackURLTypes[path].integerValue;
+}
+
 - (NSError *)errorWithString:(NSString *)errorString code:(GIDSignInErrorCode)code {
   if (errorString == nil) {
     errorString = @"Unknown error";
@@ -1304,19 +1978,101 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 }
 
 - (void)removeAllKeychainEntries {
-  [_keychainStore removeAuthSessionWithError:nil];
+  [self waitForAuthStateMigration];
+  dispatch_sync(_authStateStoreQueue, ^{
+    [self->_authStateStore removeAuthStateWithError:nil];
+  });
 }
 
+// The auth state is persisted in two parts. The whole auth state is written when the grant
+// changes, such as on sign-in or when adding scopes. Refreshing the tokens of a restored auth state
+// only writes the much smaller token response, which is applied on top of the auth state when
+// loading.
 - (BOOL)saveAuthState:(OIDAuthState *)authState {
-  GTMAuthSession *authorization = [[GTMAuthSession alloc] initWithAuthState:authState];
-  NSError *error;
-  [_keychainStore saveAuthSession:authorization error:&error];
-  return error == nil;
+  [self waitForAuthStateMigration];
+  __block BOOL saved;
+  dispatch_sync(_authStateStoreQueue, ^{
+    saved = [self->_authStateStore saveAuthState:authState error:nil];
+  });
+  return saved;
+}
+
+- (BOOL)saveTokenResponseOfAuthState:(OIDAuthState *)authState {
+  [self waitForAuthStateMigration];
+  __block BOOL saved;
+  dispatch_sync(_authStateStoreQueue, ^{
+    saved = [self writeTokenResponseOfAuthState:authState];
+  });
+  return saved;
+}
+
+// Saves a snapshot of |authState| after any pending writes, without waiting for it to be written.
+// Later changes to |authState| are not part of the snapshot. A failure is reported to the
+// |persistenceErrorHandler|.
+- (void)saveAuthStateInBackground:(OIDAuthState *)authState
+                tokenResponseOnly:(BOOL)tokenResponseOnly {
+  // The store only archives the snapshot, so it is saved as it is now even if the tokens are
+  // refreshed in the meantime.
+  OIDAuthState *snapshot = GIDAuthStateSnapshot(authState);
+  dispatch_async(_authStateStoreQueue, ^{
+    [self waitForAuthStateMigration];
+    BOOL saved = tokenResponseOnly ?
+        [self writeTokenResponseOfAuthState:snapshot] :
+        [self->_authStateStore saveAuthState:snapshot error:nil];
+    if (saved) {
+      return;
+    }
+    NSError *error = [self errorWithString:kKeychainError code:kGIDSignInErrorCodeKeychain];
+    dispatch_async(dispatch_get_main_queue(), ^{
+      void (^handler)(NSError *) = self.persistenceErrorHandler;
+      if (handler) {
+        handler(error);
+      }
+    });
+  });
+}
+
+// Writes the token response of |authState|, or the whole auth state if its grant changed. Must be
+// called on |_authStateStoreQueue|.
+- (BOOL)writeTokenResponseOfAuthState:(OIDAuthState *)authState {
+  OIDTokenResponse *tokenResponse = authState.lastTokenResponse;
+  // A rotated refresh token no longer matches the one in the saved auth state, so save both.
+  if (!tokenResponse ||
+      (tokenResponse.refreshToken &&
+       ![tokenResponse.refreshToken isEqualToString:tokenResponse.request.refreshToken])) {
+    return [_authStateStore saveAuthState:authState error:nil];
+  }
+  return [_authStateStore saveTokenResponse:tokenResponse error:nil];
 }
 
 - (OIDAuthState *)loadAuthState {
-  GTMAuthSession *authorization = [_keychainStore retrieveAuthSessionWithError:nil];
-  return authorization.authState;
+  [self waitForAuthStateMigration];
+  __block OIDAuthState *authState;
+  __block OIDTokenResponse *tokenResponse;
+  dispatch_sync(_authStateStoreQueue, ^{
+    authState = [self->_authStateStore retrieveAuthStateWithError:nil];
+    tokenResponse = authState ? [self->_authStateStore retrieveTokenResponseWithError:nil] : nil;
+  });
+  if (!tokenResponse.accessToken) {
+    return authState;
+  }
+  // Only apply a token response refreshed from this auth state's grant that is newer than the one
+  // in the auth state.
+  NSDate *savedExpirationDate = authState.lastTokenResponse.accessTokenExpirationDate;
+  if (authState.refreshToken &&
+      [tokenResponse.request.refreshToken isEqualToString:authState.refreshToken] &&
+      (!savedExpirationDate ||
+       [tokenResponse.accessTokenExpirationDate compare:savedExpirationDate] ==
+           NSOrderedDescending)) {
+    [authState updateWithTokenResponse:tokenResponse error:nil];
+  }
+  return authState;
+}
+
+// Blocks until the migration of legacy auth state started at initialization has finished. Once it
+// has, this returns immediately.
+- (void)waitForAuthStateMigration {
+  dispatch_group_wait(_authStateMigrationGroup, DISPATCH_TIME_FOREVER);
 }
 
 // Generates user profile from OIDIDToken.
@@ -21,6 +21,7 @@
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDSignIn.h"
 
 #import "GoogleSignIn/Sources/GIDScopes.h"
+#import "GoogleSignIn/Sources/GIDSignInButtonImages.h"
 #import "GoogleSignIn/Sources/GIDSignInInternalOptions.h"
 #import "GoogleSignIn/Sources/GIDSignInStrings.h"
 #import "GoogleSignIn/Sources/GIDSignIn_Private.h"
@@ -33,17 +34,16 @@ NS_ASSUME_NONNULL_BEGIN
 // Standard accessibility identifier.
 static NSString *const kAccessibilityIdentifier = @"GIDSignInButton";
 
+// Posted on the main queue, by the class, after the shared text metrics have been invalidated.
+static NSString *const kTextMetricsDidChangeNotification =
+    @"GIDSignInButtonTextMetricsDidChangeNotification";
+
 // The name of the font for button text.
 static NSString *const kFontNameRobotoBold = @"Roboto-Bold";
 
 // Button text font size.
 static const CGFloat kFontSize = 14;
 
-#pragma mark - Icon Constants
-
-// The name of the image for the Google "G"
-static NSString *const kGoogleImageName = @"google";
-
 // Keys used for NSCoding.
 static NSString *const kStyleKey = @"style";
 static NSString *const kColorSchemeKey = @"color_scheme";
@@ -77,7 +77,13 @@ static const CGFloat kDropShadowAlpha = 24.0 / 100.0;
 static const CGFloat kDropShadowBlur = 2;
 static const CGFloat kDropShadowYOffset = 2;
 
-static const CGFloat kDisabledIconAlpha = 40.0 / 100.0;
+// The width of the left part of the background image that is never stretched; it covers the
+// container for the "G".
+static const CGFloat kBackgroundImageLeftCap = 48;
+
+// The width of the right part of the background image that is never stretched; it covers the
+// rounded corners and the shadows.
+static const CGFloat kBackgroundImageRightCap = 6;
 
 #pragma mark - Colors
 
@@ -134,13 +140,87 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
                          alpha:(CGFloat)(((colorValue & 0x000000ff) >> 0) / 255.0f)];
 }
 
-#pragma mark - UIImage Category Forward Declaration
+#pragma mark - Background Rendering
 
-@interface UIImage (GIDAdditions_Private)
+// Draws the button background, its shadows and, for the dark color scheme, the container for the
+// "G" into a context of the given size.
+static void drawButtonBackground(CGContextRef context,
+                                 CGSize size,
+                                 GIDSignInButtonColorScheme colorScheme,
+                                 GIDSignInButtonState buttonState) {
+  CGContextSaveGState(context);
 
-- (UIImage *)gid_imageWithBlendMode:(CGBlendMode)blendMode color:(UIColor *)color;
+  // Normalize the coordinate system of our graphics context
+  // (0,0) -----> +x
+  // |
+  // |
+  // \/ +y
+  CGContextScaleCTM(context, 1, -1);
+  CGContextTranslateCTM(context, 0, -size.height);
 
-@end
+  // Get the colors for the current state and configuration
+  UIColor *background = colorForStyleState(colorScheme,
+                                           buttonState,
+                                           kGIDSignInButtonStyleColorBackground);
+
+  // Create rounded rectangle for button background/outline
+  CGMutablePathRef path = CGPathCreateMutable();
+  CGPathAddRoundedRect(path,
+                       NULL,
+                       CGRectInset(CGRectMake(0, 0, size.width, size.height),
+                                   kBorderWidth,
+                                   kBorderWidth),
+                       kCornerRadius,
+                       kCornerRadius);
+
+  // Fill the background and apply halo shadow
+  CGContextSaveGState(context);
+  CGContextAddPath(context, path);
+  CGContextSetFillColorWithColor(context, background.CGColor);
+  // If we're not in the disabled state, we want a shadow
+  if (buttonState != kGIDSignInButtonStateDisabled) {
+    // Draw halo shadow around button
+    CGContextSetShadowWithColor(context,
+                                CGSizeMake(0, 0),
+                                kHaloShadowBlur,
+                                [UIColor colorWithWhite:0 alpha:kHaloShadowAlpha].CGColor);
+  }
+  CGContextFillPath(context);
+  CGContextRestoreGState(context);
+
+  if (buttonState != kGIDSignInButtonStateDisabled) {
+    // Fill the background again to apply drop shadow
+    CGContextSaveGState(context);
+    CGContextAddPath(context, path);
+    CGContextSetFillColorWithColor(context, background.CGColor);
+    CGContextSetShadowWithColor(context,
+                                CGSizeMake(0, kDropShadowYOffset),
+                                kDropShadowBlur,
+                                [UIColor colorWithWhite:0 alpha:kDropShadowAlpha].CGColor);
+    CGContextFillPath(context);
+    CGContextRestoreGState(context);
+  }
+
+  if (colorScheme == kGIDSignInButtonColorSchemeDark &&
+      buttonState != kGIDSignInButtonStateDisabled) {
+    // Create rounded rectangle container for the "G"
+    CGMutablePathRef gContainerPath = CGPathCreateMutable();
+    CGPathAddRoundedRect(gContainerPath,
+                         NULL,
+                         CGRectInset(CGRectMake(0, 0, kButtonHeight, kButtonHeight),
+                                     kBorderWidth + 1,
+                                     kBorderWidth + 1),
+                         kCornerRadius,
+                         kCornerRadius);
+    CGContextAddPath(context, gContainerPath);
+    CGContextSetFillColorWithColor(context, [UIColor whiteColor].CGColor);
+    CGContextFillPath(context);
+    CGPathRelease(gContainerPath);
+  }
+
+  CGPathRelease(path);
+  CGContextRestoreGState(context);
+}
 
 #pragma mark - GIDSignInButton Private Properties
 
@@ -155,6 +235,14 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
 
 @implementation GIDSignInButton {
   UIImageView *_icon;
+  // Displays the pre-rendered background for the current color scheme and state.
+  CALayer *_backgroundLayer;
+  UILabel *_textLabel;
+  // The cached minimum width for the current style and text, or 0 if it needs measuring.
+  CGFloat _minWidth;
+  // Created once and updated in place by `updateConstraints`.
+  NSLayoutConstraint *_widthConstraint;
+  NSLayoutConstraint *_heightConstraint;
 }
 
 #pragma mark - Object lifecycle
@@ -181,19 +269,30 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
   _colorScheme = kGIDSignInButtonColorSchemeLight;
   _buttonState = kGIDSignInButtonStateNormal;
 
+  // Pre-rendered background, below the icon and text. Swapping its contents must not animate.
+  _backgroundLayer = [CALayer layer];
+  _backgroundLayer.actions = @{
+    @"contents" : [NSNull null],
+    @"contentsCenter" : [NSNull null],
+    @"contentsScale" : [NSNull null],
+    @"bounds" : [NSNull null],
+    @"position" : [NSNull null],
+  };
+  [self.layer insertSublayer:_backgroundLayer atIndex:0];
+
   // Icon for branding image:
   _icon = [[UIImageView alloc] initWithFrame:kIconFrame];
   _icon.contentMode = UIViewContentModeCenter;
   _icon.userInteractionEnabled = NO;
   [self addSubview:_icon];
 
-  // Load font for "Sign in with Google" text
-  [NSBundle gid_registerFonts];
+  // Label for the "Sign in with Google" text:
+  _textLabel = [[UILabel alloc] initWithFrame:CGRectZero];
+  _textLabel.userInteractionEnabled = NO;
+  _textLabel.isAccessibilityElement = NO;
+  [self addSubview:_textLabel];
 
   // Setup normal/highlighted state transitions:
-  [self addTarget:self
-                action:@selector(setNeedsDisplay)
-      forControlEvents:UIControlEventAllTouchEvents];
   [self addTarget:self
                 action:@selector(switchToPressed)
       forControlEvents:UIControlEventTouchDown |
@@ -206,10 +305,39 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
                        UIControlEventTouchCancel |
                        UIControlEventTouchUpInside];
 
+  // Text metrics change with the locale. The font has a fixed size, so the preferred content size
+  // does not affect them.
+  [GIDSignInButton observeTextMetricsChanges];
+  [[NSNotificationCenter defaultCenter] addObserver:self
+                                           selector:@selector(textMetricsDidChange:)
+                                               name:kTextMetricsDidChangeNotification
+                                             object:[GIDSignInButton class]];
+
   // Update the icon, etc.
   [self updateUI];
 }
 
+// Registers the single observer that invalidates the shared text metrics when the locale changes
+// and then tells every button, on the main queue, to update.
++ (void)observeTextMetricsChanges {
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+    [center addObserverForName:NSCurrentLocaleDidChangeNotification
+                        object:nil
+                         queue:[NSOperationQueue mainQueue]
+                    usingBlock:^(NSNotification *notification) {
+      [GIDSignInButton invalidateTextMetrics];
+      [center postNotificationName:kTextMetricsDidChangeNotification
+                            object:[GIDSignInButton class]];
+    }];
+  });
+}
+
+- (void)textMetricsDidChange:(NSNotification *)notification {
+  [self updateUI];
+}
+
 #pragma mark - NSCoding
 
 - (nullable instancetype)initWithCoder:(NSCoder *)aDecoder {
@@ -225,6 +353,8 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
     if ([aDecoder containsValueForKey:kButtonState]) {
       _buttonState = [aDecoder decodeIntegerForKey:kButtonState];
     }
+    // The decoded settings change what is rendered.
+    [self updateUI];
   }
   return self;
 }
@@ -244,6 +374,9 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
 #pragma mark - UI
 
 - (void)updateUI {
+  // The style or text may have changed.
+  _minWidth = 0;
+
   // Reload the icon.
   [self loadIcon];
 
@@ -251,28 +384,56 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
   // Get localized button text from bundle.
   self.accessibilityLabel = [self buttonText];
 
+  // Update the text label; its color only depends on whether the button is disabled.
+  _textLabel.hidden = _style == kGIDSignInButtonStyleIconOnly;
+  _textLabel.text = self.accessibilityLabel;
+  _textLabel.font = [[self class] buttonTextFont];
+  [self updateTextColor];
+  [self updateBackground];
+
   // Force constrain frame sizes:
   [self setFrame:self.frame];
 
   [self setNeedsUpdateConstraints];
-  [self setNeedsDisplay];
+  [self setNeedsLayout];
 }
 
-- (void)loadIcon {
-  NSString *resourceName = kGoogleImageName;
-  NSBundle *gidBundle = [NSBundle gid_frameworkBundle];
-  NSString *resourcePath = [gidBundle pathForResource:resourceName ofType:@"png"];
-  UIImage *image = [UIImage imageWithContentsOfFile:resourcePath];
-
-  if (_buttonState == kGIDSignInButtonStateDisabled) {
-    _icon.image = [image gid_imageWithBlendMode:kCGBlendModeMultiply
-                                          color:[UIColor colorWithWhite:0
-                                                                  alpha:kDisabledIconAlpha]];
+- (void)updateTextColor {
+  _textLabel.textColor = colorForStyleState(_colorScheme,
+                                            _buttonState,
+                                            kGIDSignInButtonStyleColorForeground);
+}
+
+- (void)updateBackground {
+  CGFloat scale = [self renderingScale];
+  BOOL stretchable = _style != kGIDSignInButtonStyleIconOnly;
+  UIImage *image = [[self class] backgroundImageForColorScheme:_colorScheme
+                                                   buttonState:_buttonState
+                                                   stretchable:stretchable
+                                                         scale:scale];
+  _backgroundLayer.contents = (__bridge id)image.CGImage;
+  _backgroundLayer.contentsScale = image.scale;
+  if (stretchable) {
+    // Only the single column between the caps is stretched horizontally.
+    CGFloat width = image.size.width;
+    _backgroundLayer.contentsCenter =
+        CGRectMake(kBackgroundImageLeftCap / width, 0, 1 / width, 1);
   } else {
-    _icon.image = image;
+    _backgroundLayer.contentsCenter = CGRectMake(0, 0, 1, 1);
   }
 }
 
+- (void)loadIcon {
+  BOOL disabled = _buttonState == kGIDSignInButtonStateDisabled;
+  _icon.image = [GIDSignInButtonImages googleIconForScale:[self renderingScale] disabled:disabled];
+}
+
+// The scale to render cached images at; before the button is in a window, the main screen's.
+- (CGFloat)renderingScale {
+  CGFloat scale = self.traitCollection.displayScale;
+  return scale > 0 ? scale : [UIScreen mainScreen].scale;
+}
+
 #pragma mark - State Transitions
 
 - (void)switchToPressed {
@@ -322,8 +483,15 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
   if (buttonState == _buttonState) {
     return;
   }
+  GIDSignInButtonState previousState = _buttonState;
   _buttonState = buttonState;
-  [self setNeedsDisplay];
+  // Touch transitions only swap the cached background; the text color only changes when entering
+  // or leaving the disabled state.
+  [self updateBackground];
+  if (previousState == kGIDSignInButtonStateDisabled ||
+      buttonState == kGIDSignInButtonStateDisabled) {
+    [self updateTextColor];
+  }
 }
 
 - (void)setFrame:(CGRect)frame {
@@ -334,18 +502,22 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
   }
   [super setFrame:frame];
   [self setNeedsUpdateConstraints];
-  [self setNeedsDisplay];
 }
 
 #pragma mark - Helpers
 
 - (CGFloat)minWidth {
+  if (_minWidth > 0) {
+    return _minWidth;
+  }
   if (_style == kGIDSignInButtonStyleIconOnly) {
-    return kIconWidth + (kBorderWidth * 2);
+    _minWidth = kIconWidth + (kBorderWidth * 2);
+    return _minWidth;
   }
   NSString *text = [self buttonText];
   CGSize textSize = [[self class] textSize:text withFont:[[self class] buttonTextFont]];
-  return ceil(kIconWidth + (kTextPadding * 2) + textSize.width + (kBorderWidth * 2));
+  _minWidth = ceil(kIconWidth + (kTextPadding * 2) + textSize.width + (kBorderWidth * 2));
+  return _minWidth;
 }
 
 - (BOOL)isConstraint:(NSLayoutConstraint *)constraintA
@@ -374,6 +546,7 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
 }
 
 - (void)updateConstraints {
+  CGFloat minWidth = [self minWidth];
   NSLayoutRelation widthConstraintRelation;
   // For icon style, we want to ensure a fixed width
   if (_style == kGIDSignInButtonStyleIconOnly) {
@@ -381,38 +554,50 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
   } else {
     widthConstraintRelation = NSLayoutRelationGreaterThanOrEqual;
   }
-  // Define a width constraint ensuring that we don't go below our minimum width
-  NSLayoutConstraint *widthConstraint =
-      [NSLayoutConstraint constraintWithItem:self
-                                   attribute:NSLayoutAttributeWidth
-                                   relatedBy:widthConstraintRelation
-                                      toItem:nil
-                                   attribute:NSLayoutAttributeNotAnAttribute
-                                  multiplier:1.0
-                                    constant:[self minWidth]];
-  widthConstraint.identifier = @"buttonWidth - auto generated by GIDSignInButton";
+  // Define a width constraint ensuring that we don't go below our minimum width. The relation of a
+  // constraint can't be changed, so it is only recreated when the style changes it.
+  if (!_widthConstraint || _widthConstraint.relation != widthConstraintRelation) {
+    if (_widthConstraint.active) {
+      [self removeConstraint:_widthConstraint];
+    }
+    _widthConstraint =
+        [NSLayoutConstraint constraintWithItem:self
+                                     attribute:NSLayoutAttributeWidth
+                                     relatedBy:widthConstraintRelation
+                                        toItem:nil
+                                     attribute:NSLayoutAttributeNotAnAttribute
+                                    multiplier:1.0
+                                      constant:minWidth];
+    _widthConstraint.identifier = @"buttonWidth - auto generated by GIDSignInButton";
+  }
+  _widthConstraint.constant = minWidth;
   // Define a height constraint using our constant height
-  NSLayoutConstraint *heightConstraint =
-      [NSLayoutConstraint constraintWithItem:self
-                                   attribute:NSLayoutAttributeHeight
-                                   relatedBy:NSLayoutRelationEqual
-                                      toItem:nil
-                                   attribute:NSLayoutAttributeNotAnAttribute
-                                  multiplier:1.0
-                                    constant:kButtonHeight];
-  heightConstraint.identifier = @"buttonHeight - auto generated by GIDSignInButton";
-  // By default, add our width and height constraints
-  BOOL addWidthConstraint = YES;
-  BOOL addHeightConstraint = YES;
+  if (!_heightConstraint) {
+    _heightConstraint =
+        [NSLayoutConstraint constraintWithItem:self
+                                     attribute:NSLayoutAttributeHeight
+                                     relatedBy:NSLayoutRelationEqual
+                                        toItem:nil
+                                     attribute:NSLayoutAttributeNotAnAttribute
+                                    multiplier:1.0
+                                      constant:kButtonHeight];
+    _heightConstraint.identifier = @"buttonHeight - auto generated by GIDSignInButton";
+  }
+  // By default, install our width and height constraints
+  BOOL installWidthConstraint = YES;
+  BOOL installHeightConstraint = YES;
 
   for (NSLayoutConstraint *constraint in self.constraints) {
-    // If it is equivalent to our width or height constraint, don't add ours later
-    if ([self isConstraint:constraint equalToConstraint:widthConstraint]) {
-      addWidthConstraint = NO;
+    if (constraint == _widthConstraint || constraint == _heightConstraint) {
+      continue;
+    }
+    // If it is equivalent to our width or height constraint, don't install ours
+    if ([self isConstraint:constraint equalToConstraint:_widthConstraint]) {
+      installWidthConstraint = NO;
       continue;
     }
-    if ([self isConstraint:constraint equalToConstraint:heightConstraint]) {
-      addHeightConstraint = NO;
+    if ([self isConstraint:constraint equalToConstraint:_heightConstraint]) {
+      installHeightConstraint = NO;
       continue;
     }
     if (constraint.firstItem == self) {
@@ -422,140 +607,98 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
       }
       // If it is a width constraint of any relation, remove it if it will conflict with ours
       if (constraint.firstAttribute == NSLayoutAttributeWidth &&
-          (constraint.constant < [self minWidth] || _style == kGIDSignInButtonStyleIconOnly)) {
+          (constraint.constant < minWidth || _style == kGIDSignInButtonStyleIconOnly)) {
         [self removeConstraint:constraint];
       }
     }
   }
 
-  if (addWidthConstraint) {
-    [self addConstraint:widthConstraint];
-  }
-  if (addHeightConstraint) {
-    [self addConstraint:heightConstraint];
-  }
+  [self installConstraint:_widthConstraint installed:installWidthConstraint];
+  [self installConstraint:_heightConstraint installed:installHeightConstraint];
   [super updateConstraints];
 }
 
-#pragma mark - Rendering
+- (void)installConstraint:(NSLayoutConstraint *)constraint installed:(BOOL)installed {
+  if (installed && !constraint.active) {
+    [self addConstraint:constraint];
+  } else if (!installed && constraint.active) {
+    [self removeConstraint:constraint];
+  }
+}
 
-- (void)drawRect:(CGRect)rect {
-  [super drawRect:rect];
+#pragma mark - Rendering
 
-  CGContextRef context = UIGraphicsGetCurrentContext();
-  CGContextRetain(context);
+- (void)layoutSubviews {
+  [super layoutSubviews];
+  _backgroundLayer.frame = self.bounds;
 
-  if (context == NULL) {
+  if (_style == kGIDSignInButtonStyleIconOnly) {
     return;
   }
-
-  // Draw the button background
-  [self drawButtonBackground:context];
-
-  // Draw the text
-  [self drawButtonText:context];
-
-  CGContextRelease(context);
-  context = NULL;
+  // Position the button text to the right of the icon, vertically centered.
+  CGSize textSize = [[self class] textSize:_textLabel.text withFont:_textLabel.font];
+  CGFloat textLeft = kIconWidth + kTextPadding;
+  CGFloat textTop = round((self.bounds.size.height - textSize.height) / 2);
+  _textLabel.frame = CGRectMake(textLeft, textTop, ceil(textSize.width), ceil(textSize.height));
 }
 
-#pragma mark - Button Background Rendering
-
-- (void)drawButtonBackground:(CGContextRef)context {
-  CGContextSaveGState(context);
-
-  // Normalize the coordinate system of our graphics context
-  // (0,0) -----> +x
-  // |
-  // |
-  // \/ +y
-  CGContextScaleCTM(context, 1, -1);
-  CGContextTranslateCTM(context, 0, -self.bounds.size.height);
-
-  // Get the colors for the current state and configuration
-  UIColor *background = colorForStyleState(_colorScheme,
-                                           _buttonState,
-                                           kGIDSignInButtonStyleColorBackground);
-
-  // Create rounded rectangle for button background/outline
-  CGMutablePathRef path = CGPathCreateMutable();
-  CGPathAddRoundedRect(path,
-                       NULL,
-                       CGRectInset(self.bounds, kBorderWidth, kBorderWidth),
-                       kCornerRadius,
-                       kCornerRadius);
-
-  // Fill the background and apply halo shadow
-  CGContextSaveGState(context);
-  CGContextAddPath(context, path);
-  CGContextSetFillColorWithColor(context, background.CGColor);
-  // If we're not in the disabled state, we want a shadow
-  if (_buttonState != kGIDSignInButtonStateDisabled) {
-    // Draw halo shadow around button
-    CGContextSetShadowWithColor(context,
-                                CGSizeMake(0, 0),
-                                kHaloShadowBlur,
-                                [UIColor colorWithWhite:0 alpha:kHaloShadowAlpha].CGColor);
+- (void)traitCollectionDidChange:(nullable UITraitCollection *)previousTraitCollection {
+  [super traitCollectionDidChange:previousTraitCollection];
+  if (previousTraitCollection.displayScale != self.traitCollection.displayScale) {
+    [self loadIcon];
+    [self updateBackground];
   }
-  CGContextFillPath(context);
-  CGContextRestoreGState(context);
+}
 
-  if (_buttonState != kGIDSignInButtonStateDisabled) {
-    // Fill the background again to apply drop shadow
-    CGContextSaveGState(context);
-    CGContextAddPath(context, path);
-    CGContextSetFillColorWithColor(context, background.CGColor);
-    CGContextSetShadowWithColor(context,
-                                CGSizeMake(0, kDropShadowYOffset),
-                                kDropShadowBlur,
-                                [UIColor colorWithWhite:0 alpha:kDropShadowAlpha].CGColor);
-    CGContextFillPath(context);
-    CGContextRestoreGState(context);
+// Returns the shared background image for the given configuration, rendering it on first use.
+// Stretchable images are rendered at their minimum width and only stretch between the caps.
++ (UIImage *)backgroundImageForColorScheme:(GIDSignInButtonColorScheme)colorScheme
+                               buttonState:(GIDSignInButtonState)buttonState
+                               stretchable:(BOOL)stretchable
+                                     scale:(CGFloat)scale {
+  static NSMutableDictionary<NSNumber *, UIImage *> *images;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    images = [NSMutableDictionary dictionary];
+  });
+
+  // Pack the configuration into a small integer so that the key is a tagged pointer and building
+  // it does not allocate. The scale is kept to a hundredth, which distinguishes all screen scales.
+  NSUInteger configuration =
+      (colorScheme * kNumGIDSignInButtonStates + buttonState) * 2 + (stretchable ? 1 : 0);
+  NSNumber *key = @((configuration << 16) | ((NSUInteger)lround(scale * 100) & 0xFFFF));
+  @synchronized(images) {
+    UIImage *image = images[key];
+    if (image) {
+      return image;
+    }
   }
 
-  if (_colorScheme == kGIDSignInButtonColorSchemeDark &&
-      _buttonState != kGIDSignInButtonStateDisabled) {
-    // Create rounded rectangle container for the "G"
-    CGMutablePathRef gContainerPath = CGPathCreateMutable();
-    CGPathAddRoundedRect(gContainerPath,
-                         NULL,
-                         CGRectInset(CGRectMake(0, 0, kButtonHeight, kButtonHeight),
-                                     kBorderWidth + 1,
-                                     kBorderWidth + 1),
-                         kCornerRadius,
-                         kCornerRadius);
-    CGContextAddPath(context, gContainerPath);
-    CGContextSetFillColorWithColor(context, [UIColor whiteColor].CGColor);
-    CGContextFillPath(context);
-    CGPathRelease(gContainerPath);
+  CGFloat width = stretchable ? kBackgroundImageLeftCap + 1 + kBackgroundImageRightCap
+                              : kIconWidth + (kBorderWidth * 2);
+  CGSize size = CGSizeMake(width, kButtonHeight);
+  UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat defaultFormat];
+  format.scale = scale;
+  format.opaque = NO;
+  UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:size
+                                                                             format:format];
+  UIImage *image = [renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+    drawButtonBackground(context.CGContext, size, colorScheme, buttonState);
+  }];
+
+  @synchronized(images) {
+    images[key] = image;
   }
-
-  CGPathRelease(path);
-  CGContextRestoreGState(context);
+  return image;
 }
 
-#pragma mark - Text Rendering
-
-- (void)drawButtonText:(CGContextRef)context {
-  if (_style == kGIDSignInButtonStyleIconOnly) {
-    return;
-  }
+#pragma mark - Resource Prefetching
 
-  NSString *text = self.accessibilityLabel;
-
-  UIColor *foregroundColor = colorForStyleState(_colorScheme,
-                                                _buttonState,
-                                                kGIDSignInButtonStyleColorForeground);
-  UIFont *font = [[self class] buttonTextFont];
-  CGSize textSize = [[self class] textSize:text withFont:font];
-
-  // Draw the button text at the right position with the right color.
-  CGFloat textLeft = kIconWidth + kTextPadding;
-  CGFloat textTop = round((self.bounds.size.height - textSize.height) / 2);
-
-  [text drawAtPoint:CGPointMake(textLeft, textTop)
-      withAttributes:@{ NSFontAttributeName : font,
-                        NSForegroundColorAttributeName : foregroundColor }];
++ (void)prefetchResources {
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+    // Resolving the font registers it, so buttons created later only look up the cached font.
+    [self buttonTextFont];
+  });
 }
 
 #pragma mark - Button Text Selection / Localization
@@ -571,78 +714,57 @@ static UIColor *colorForStyleState(GIDSignInButtonColorScheme style,
 }
 
 + (UIFont *)buttonTextFont {
-  UIFont *font = [UIFont fontWithName:kFontNameRobotoBold size:kFontSize];
-  if (!font) {
-    font = [UIFont boldSystemFontOfSize:kFontSize];
-  }
+  // The fonts are registered on first use, or earlier by `prefetchResources`. Either way the lookup
+  // by name only happens once; a concurrent caller waits for the first one to finish.
+  static UIFont *font;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    [NSBundle gid_registerFonts];
+    font = [UIFont fontWithName:kFontNameRobotoBold size:kFontSize];
+    if (!font) {
+      font = [UIFont boldSystemFontOfSize:kFontSize];
+    }
+  });
   return font;
 }
 
-+ (CGSize)textSize:(NSString *)text withFont:(UIFont *)font {
-  return [text boundingRectWithSize:CGSizeMake(CGFLOAT_MAX, CGFLOAT_MAX)
-                            options:0
-                         attributes:@{ NSFontAttributeName : font }
-                            context:nil].size;
+#pragma mark - Text Measurement
+
+// Measured text sizes shared by all buttons, keyed by text and font. The text already depends on
+// the locale and style.
+static NSMutableDictionary<NSString *, NSValue *> *textSizes(void) {
+  static NSMutableDictionary<NSString *, NSValue *> *sizes;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    sizes = [NSMutableDictionary dictionary];
+  });
+  return sizes;
 }
 
-@end
-
-#pragma mark - UIImage GIDAdditions_Private Category
-
-@implementation UIImage (GIDAdditions_Private)
-
-- (UIImage *)gid_imageWithBlendMode:(CGBlendMode)blendMode color:(UIColor *)color {
-  CGSize size = [self size];
-  CGRect rect = CGRectMake(0.0f, 0.0f, size.width, size.height);
-
-  UIGraphicsBeginImageContextWithOptions(rect.size, NO, 0.0);
-  CGContextRef context = UIGraphicsGetCurrentContext();
-  CGContextSetShouldAntialias(context, true);
-  CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
-
-  CGContextScaleCTM(context, 1, -1);
-  CGContextTranslateCTM(context, 0, -rect.size.height);
-
-  CGContextClipToMask(context, rect, self.CGImage);
-  CGContextDrawImage(context, rect, self.CGImage);
-
-  CGContextSetBlendMode(context, blendMode);
-
-  CGFloat alpha = 1.0;
-  if (blendMode == kCGBlendModeMultiply) {
-    CGFloat red, green, blue;
-    BOOL success = [color getRed:&red green:&green blue:&blue alpha:&alpha];
-    if (success) {
-      color = [UIColor colorWithRed:red green:green blue:blue alpha:1.0];
-    } else {
-      CGFloat grayscale;
-      success = [color getWhite:&grayscale alpha:&alpha];
-      if (success) {
-        color = [UIColor colorWithWhite:grayscale alpha:1.0];
-      }
++ (CGSize)textSize:(NSString *)text withFont:(UIFont *)font {
+  NSMutableDictionary<NSString *, NSValue *> *sizes = textSizes();
+  NSString *key = [NSString stringWithFormat:@"%@|%g|%@", font.fontName, font.pointSize, text];
+  @synchronized(sizes) {
+    NSValue *size = sizes[key];
+    if (size) {
+      return size.CGSizeValue;
     }
   }
-
-  CGContextSetFillColorWithColor(context, color.CGColor);
-  CGContextFillRect(context, rect);
-
-  if (blendMode == kCGBlendModeMultiply && alpha != 1.0) {
-    // Modulate by the alpha.
-    color = [UIColor colorWithRed:1.0 green:1.0 blue:1.0 alpha:alpha];
-    CGContextSetBlendMode(context, kCGBlendModeDestinationIn);
-    CGContextSetFillColorWithColor(context, color.CGColor);
-    CGContextFillRect(context, rect);
+  CGSize size = [text boundingRectWithSize:CGSizeMake(CGFLOAT_MAX, CGFLOAT_MAX)
+                                   options:0
+                                attributes:@{ NSFontAttributeName : font }
+                                   context:nil].size;
+  @synchronized(sizes) {
+    sizes[key] = [NSValue valueWithCGSize:size];
   }
+  return size;
+}
 
-  UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
-  UIGraphicsEndImageContext();
-
-  if (self.capInsets.bottom > 0 || self.capInsets.top > 0 ||
-      self.capInsets.left > 0 || self.capInsets.left > 0) {
-    image = [image resizableImageWithCapInsets:self.capInsets];
++ (void)invalidateTextMetrics {
+  NSMutableDictionary<NSString *, NSValue *> *sizes = textSizes();
+  @synchronized(sizes) {
+    [sizes removeAllObjects];
   }
-
-  return image;
 }
 
 @end
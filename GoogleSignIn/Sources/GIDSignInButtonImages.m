@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <TargetConditionals.h>
+
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+
+#import "GoogleSignIn/Sources/GIDSignInButtonImages.h"
+
+#import "GoogleSignIn/Sources/NSBundle+GID3PAdditions.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// The name of the image for the Google "G"
+static NSString *const kGoogleImageName = @"google";
+
+static const CGFloat kDisabledIconAlpha = 40.0 / 100.0;
+
+#pragma mark - UIImage Category Forward Declaration
+
+@interface UIImage (GIDAdditions_Private)
+
+- (UIImage *)gid_imageWithBlendMode:(CGBlendMode)blendMode color:(UIColor *)color;
+
+@end
+
+#pragma mark -
+
+@implementation GIDSignInButtonImages
+
++ (nullable UIImage *)googleIconForScale:(CGFloat)scale disabled:(BOOL)disabled {
+  static NSMutableDictionary<NSString *, UIImage *> *icons;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    icons = [NSMutableDictionary dictionary];
+  });
+
+  NSString *key = [NSString stringWithFormat:@"%g-%d", scale, disabled];
+  @synchronized(icons) {
+    UIImage *icon = icons[key];
+    if (icon) {
+      return icon;
+    }
+  }
+
+  // Decode outside of the lock; a racing caller at worst decodes the same icon twice.
+  UIImage *icon;
+  if (disabled) {
+    icon = [[self googleIconForScale:scale disabled:NO]
+        gid_imageWithBlendMode:kCGBlendModeMultiply
+                         color:[UIColor colorWithWhite:0 alpha:kDisabledIconAlpha]];
+  } else {
+    NSBundle *bundle = [NSBundle gid_frameworkBundle];
+    UITraitCollection *traits = [UITraitCollection traitCollectionWithDisplayScale:scale];
+    icon = [UIImage imageNamed:kGoogleImageName
+                                   inBundle:bundle
+              compatibleWithTraitCollection:traits];
+  }
+  if (!icon) {
+    return nil;
+  }
+
+  @synchronized(icons) {
+    icons[key] = icon;
+  }
+  return icon;
+}
+
+@end
+
+#pragma mark - UIImage GIDAdditions_Private Category
+
+@implementation UIImage (GIDAdditions_Private)
+
+- (UIImage *)gid_imageWithBlendMode:(CGBlendMode)blendMode color:(UIColor *)color {
+  CGSize size = [self size];
+  CGRect rect = CGRectMake(0.0f, 0.0f, size.width, size.height);
+
+  UIGraphicsBeginImageContextWithOptions(rect.size, NO, self.scale);
+  CGContextRef context = UIGraphicsGetCurrentContext();
+  CGContextSetShouldAntialias(context, true);
+  CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+
+  CGContextScaleCTM(context, 1, -1);
+  CGContextTranslateCTM(context, 0, -rect.size.height);
+
+  CGContextClipToMask(context, rect, self.CGImage);
+  CGContextDrawImage(context, rect, self.CGImage);
+
+  CGContextSetBlendMode(context, blendMode);
+
+  CGFloat alpha = 1.0;
+  if (blendMode == kCGBlendModeMultiply) {
+    CGFloat red, green, blue;
+    BOOL success = [color getRed:&red green:&green blue:&blue alpha:&alpha];
+    if (success) {
+      color = [UIColor colorWithRed:red green:green blue:blue alpha:1.0];
+    } else {
+      CGFloat grayscale;
+      success = [color getWhite:&grayscale alpha:&alpha];
+      if (success) {
+        color = [UIColor colorWithWhite:grayscale alpha:1.0];
+      }
+    }
+  }
+
+  CGContextSetFillColorWithColor(context, color.CGColor);
+  CGContextFillRect(context, rect);
+
+  if (blendMode == kCGBlendModeMultiply && alpha != 1.0) {
+    // Modulate by the alpha.
+    color = [UIColor colorWithRed:1.0 green:1.0 blue:1.0 alpha:alpha];
+    CGContextSetBlendMode(context, kCGBlendModeDestinationIn);
+    CGContextSetFillColorWithColor(context, color.CGColor);
+    CGContextFillRect(context, rect);
+  }
+
+  UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+  UIGraphicsEndImageContext();
+
+  if (self.capInsets.bottom > 0 || self.capInsets.top > 0 ||
+      self.capInsets.left > 0 || self.capInsets.left > 0) {
+    image = [image resizableImageWithCapInsets:self.capInsets];
+  }
+
+  return image;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
@@ -21,6 +21,15 @@ NS_ASSUME_NONNULL_BEGIN
 // A utility class for dealing with callback schemes.
 @interface GIDSignInCallbackSchemes : NSObject
 
+// The lowercase URL schemes declared in the host app's Info.plist. Read from the main bundle once
+// per process and shared by all instances; a new set is returned only after the cache has been
+// invalidated.
++ (NSSet<NSString *> *)registeredURLSchemes;
+
+// Indicates whether |scheme| is declared in the host app's Info.plist, ignoring case. URLs with any
+// other scheme cannot be sign-in callbacks.
++ (BOOL)isRegisteredURLScheme:(nullable NSString *)scheme;
+
 // Please call the designated initializer.
 - (instancetype)init NS_UNAVAILABLE;
 
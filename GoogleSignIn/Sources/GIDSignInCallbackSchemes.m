@@ -12,12 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#import "GoogleSignIn/Sources/GIDSignInCallbackSchemes.h"
+#import "GoogleSignIn/Sources/GIDSignInCallbackSchemes_Private.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+// The cached result of |relevantURLSchemes|, guarded by the class.
+static NSSet<NSString *> *gRegisteredURLSchemes;
+
 @implementation GIDSignInCallbackSchemes {
   NSString *_clientIdentifier;
+  NSString *_clientIdentifierScheme;
 }
 
 /**
@@ -40,6 +44,31 @@ NS_ASSUME_NONNULL_BEGIN
   return result;
 }
 
++ (NSSet<NSString *> *)registeredURLSchemes {
+  @synchronized([GIDSignInCallbackSchemes class]) {
+    if (!gRegisteredURLSchemes) {
+      gRegisteredURLSchemes = [NSSet setWithArray:[self relevantURLSchemes]];
+    }
+    return gRegisteredURLSchemes;
+  }
+}
+
++ (BOOL)isRegisteredURLScheme:(nullable NSString *)scheme {
+  if (!scheme) {
+    return NO;
+  }
+  NSSet<NSString *> *registeredURLSchemes = [self registeredURLSchemes];
+  // Schemes usually arrive in the registered case already, so try that before lowercasing.
+  return [registeredURLSchemes containsObject:scheme] ||
+      [registeredURLSchemes containsObject:scheme.lowercaseString];
+}
+
++ (void)invalidateRegisteredURLSchemes {
+  @synchronized([GIDSignInCallbackSchemes class]) {
+    gRegisteredURLSchemes = nil;
+  }
+}
+
 - (instancetype)initWithClientIdentifier:(NSString *)clientIdentifier {
   self = [super init];
   if (self) {
@@ -49,10 +78,14 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (NSString *)clientIdentifierScheme {
-  NSArray *clientIdentifierParts = [_clientIdentifier componentsSeparatedByString:@"."];
-  NSString *reversedClientIdentifier =
-      [[clientIdentifierParts reverseObjectEnumerator].allObjects componentsJoinedByString:@"."];
-  return reversedClientIdentifier.lowercaseString;
+  // The client identifier is immutable, so the reversed form only needs computing once.
+  if (!_clientIdentifierScheme) {
+    NSArray *clientIdentifierParts = [_clientIdentifier componentsSeparatedByString:@"."];
+    NSString *reversedClientIdentifier =
+        [[clientIdentifierParts reverseObjectEnumerator].allObjects componentsJoinedByString:@"."];
+    _clientIdentifierScheme = reversedClientIdentifier.lowercaseString;
+  }
+  return _clientIdentifierScheme;
 }
 
 - (NSArray *)allSchemes {
@@ -65,20 +98,21 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (NSMutableArray *)unsupportedSchemes {
-  NSMutableArray *unsupportedSchemes = [NSMutableArray arrayWithArray:[self allSchemes]];
-  NSArray *supportedSchemes = [[self class] relevantURLSchemes];
-  [unsupportedSchemes removeObjectsInArray:supportedSchemes];
+  NSMutableArray *unsupportedSchemes = [NSMutableArray array];
+  NSSet<NSString *> *supportedSchemes = [[self class] registeredURLSchemes];
+  for (NSString *scheme in [self allSchemes]) {
+    if (![supportedSchemes containsObject:scheme]) {
+      [unsupportedSchemes addObject:scheme];
+    }
+  }
   return unsupportedSchemes;
 }
 
 - (BOOL)URLSchemeIsCallbackScheme:(NSURL *)URL {
-  NSString *incomingURLScheme = URL.scheme.lowercaseString;
-  for (NSString *scheme in [self allSchemes]) {
-    if ([incomingURLScheme isEqual:scheme]) {
-      return YES;
-    }
-  }
-  return NO;
+  NSString *incomingURLScheme = URL.scheme;
+  NSString *clientIdentifierScheme = [self clientIdentifierScheme];
+  return incomingURLScheme && clientIdentifierScheme &&
+      [incomingURLScheme caseInsensitiveCompare:clientIdentifierScheme] == NSOrderedSame;
 }
 
 @end
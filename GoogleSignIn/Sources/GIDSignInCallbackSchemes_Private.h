@@ -0,0 +1,30 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDSignInCallbackSchemes.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Private |GIDSignInCallbackSchemes| methods that are only used by tests.
+@interface GIDSignInCallbackSchemes ()
+
+// Discards the cached |registeredURLSchemes| so that they are read again on next use. Only needed
+// when the Info.plist contents change, which happens in tests.
++ (void)invalidateRegisteredURLSchemes;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -24,8 +24,10 @@
 
 #import "GoogleSignIn/Sources/GIDSignIn_Private.h"
 
+@class GIDCancellationToken;
 @class GIDConfiguration;
 @class GIDSignInResult;
+@class OIDAuthState;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -58,6 +60,32 @@ NS_ASSUME_NONNULL_BEGIN
 /// The completion block to be called at the completion of the flow.
 @property(nonatomic, readonly, nullable) GIDSignInCompletion completion;
 
+/// The token of the request these options were created for, which cancels its completion.
+@property(nonatomic, readonly) GIDCancellationToken *cancellationToken;
+
+/// The token that is cancelled when the flow started with these options is abandoned, because every
+/// request waiting for it was cancelled.
+@property(nonatomic, readonly) GIDCancellationToken *flowCancellationToken;
+
+/// Called on the main queue once the request has completed or timed out, to release what only a
+/// pending request needs, such as its handler on the caller's cancellation token.
+@property(nonatomic, copy, nullable) dispatch_block_t finishHandler;
+
+/// The options the flow carried on by these options was started with, which is the receiver
+/// itself unless it is a continuation.
+@property(nonatomic, readonly) GIDSignInInternalOptions *flowOptions;
+
+/// The time by which the request must complete, after which it fails with a
+/// `kGIDSignInErrorCodeTimedOut` error, or `nil` if it has none.
+@property(nonatomic, copy, nullable) NSDate *deadline;
+
+/// The auth state a silent flow restores instead of loading it from the store, set by a caller
+/// that has already loaded it. Setting it, even to `nil`, sets `hasRestoredAuthState`.
+@property(nonatomic, nullable) OIDAuthState *restoredAuthState;
+
+/// Whether `restoredAuthState` was set, so the store doesn't need to be read again.
+@property(nonatomic, readonly) BOOL hasRestoredAuthState;
+
 /// The scopes to be used during the flow.
 @property(nonatomic, copy, nullable) NSArray<NSString *> *scopes;
 
@@ -116,6 +144,11 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)optionsWithExtraParameters:(NSDictionary *)extraParams
                            forContinuation:(BOOL)continuation;
 
+/// Whether the receiver requests the same flow as `options`, so that a single flow can complete
+/// both. Silent sign-ins are always equivalent to each other, while interactive ones must match in
+/// everything but their completion, cancellation tokens and deadline.
+- (BOOL)isEquivalentToOptions:(GIDSignInInternalOptions *)options;
+
 @end
 
 NS_ASSUME_NONNULL_END
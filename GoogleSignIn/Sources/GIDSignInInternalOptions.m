@@ -20,11 +20,17 @@
 #import <AppKit/AppKit.h>
 #endif
 
+#import "GoogleSignIn/Sources/GIDCancellationToken_Private.h"
+#import "GoogleSignIn/Sources/GIDEqualObjects.h"
 #import "GoogleSignIn/Sources/GIDScopes.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
-@implementation GIDSignInInternalOptions
+@implementation GIDSignInInternalOptions {
+  // The options of the flow a continuation carries on, or nil if the receiver started its flow.
+  GIDSignInInternalOptions *_Nullable _continuedOptions;
+}
+
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
 + (instancetype)defaultOptionsWithConfiguration:(nullable GIDConfiguration *)configuration
                        presentingViewController:(nullable UIViewController *)presentingViewController
@@ -60,6 +66,8 @@ NS_ASSUME_NONNULL_BEGIN
     options->_scopes = [GIDScopes scopesWithBasicProfile:scopes];
     options->_nonce = nonce;
     options->_claims = claims;
+    options->_cancellationToken = [[GIDCancellationToken alloc] init];
+    options->_flowCancellationToken = [[GIDCancellationToken alloc] init];
   }
   return options;
 }
@@ -126,10 +134,46 @@ NS_ASSUME_NONNULL_BEGIN
     options->_scopes = _scopes;
     options->_claims = _claims;
     options->_extraParams = [extraParams copy];
+    // A continuation carries on the same request and flow.
+    options->_cancellationToken = _cancellationToken;
+    options->_flowCancellationToken = _flowCancellationToken;
+    options->_deadline = _deadline;
+    options->_continuedOptions = continuation ? self.flowOptions : nil;
   }
   return options;
 }
 
+- (GIDSignInInternalOptions *)flowOptions {
+  return _continuedOptions ?: self;
+}
+
+- (void)setRestoredAuthState:(nullable OIDAuthState *)restoredAuthState {
+  _restoredAuthState = restoredAuthState;
+  _hasRestoredAuthState = YES;
+}
+
+- (BOOL)isEquivalentToOptions:(GIDSignInInternalOptions *)options {
+  if (_interactive != options.interactive ||
+      _continuation != options.continuation ||
+      _addScopesFlow != options.addScopesFlow) {
+    return NO;
+  }
+  if (!_interactive) {
+    return YES;
+  }
+  return _configuration == options.configuration &&
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+      _presentingViewController == options.presentingViewController &&
+#elif TARGET_OS_OSX
+      _presentingWindow == options.presentingWindow &&
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+      GIDEqualObjects(_loginHint, options.loginHint) &&
+      GIDEqualObjects(_scopes, options.scopes) &&
+      GIDEqualObjects(_nonce, options.nonce) &&
+      GIDEqualObjects(_claims, options.claims) &&
+      GIDEqualObjects(_extraParams, options.extraParams);
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -47,11 +47,12 @@ static NSString *const kAppleEnvironmentMacOSMacCatalyst = @"macos-cat";
 // The prefixed sdk version string to differentiate gid version values used with the legacy gpsdk
 // logging key.
 NSString* GIDVersion(void) {
-  return [NSString stringWithFormat:@"gid-%@", @STR(GID_SDK_VERSION)];
+  // Concatenated at compile time so no string is formatted per call.
+  return @"gid-" STR(GID_SDK_VERSION);
 }
 
-// Get the current Apple execution environment.
-NSString* GIDEnvironment(void) {
+// Computes the current Apple execution environment, which cannot change while the process runs.
+static NSString *GIDComputeEnvironment(void) {
   NSString *appleEnvironment = kAppleEnvironmentUnknown;
 
 #if TARGET_OS_MACCATALYST
@@ -80,6 +81,16 @@ NSString* GIDEnvironment(void) {
   return appleEnvironment;
 }
 
+// Get the current Apple execution environment.
+NSString* GIDEnvironment(void) {
+  static NSString *environment;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    environment = GIDComputeEnvironment();
+  });
+  return environment;
+}
+
 @implementation GIDSignInPreferences
 
 + (NSString *)googleAuthorizationServer {
@@ -27,14 +27,80 @@ static NSString * const kStringsTableName = @"GoogleSignIn";
 static NSString *const kStandardButtonText = @"Sign in";
 static NSString *const kWideButtonText = @"Sign in with Google";
 
+// The localization whose strings are used for keys missing from the preferred localization, if
+// the bundle does not declare one.
+static NSString *const kDefaultDevelopmentLocalization = @"en";
+
+// The strings table for the current localization, loaded on first use. The bundle's preferred
+// localizations are fixed for the life of the process, so it never needs reloading. Guarded by the
+// class.
+static NSDictionary<NSString *, NSString *> *gStringsTable;
+
+// Returns the compiled strings table of |bundle| for |localization|, or nil if there is none.
+static NSDictionary<NSString *, NSString *> *_Nullable GIDStringsTable(NSBundle *bundle,
+                                                                      NSString *localization) {
+  NSString *path = [bundle pathForResource:kStringsTableName
+                                    ofType:@"strings"
+                               inDirectory:nil
+                           forLocalization:localization];
+  NSData *data = path ? [NSData dataWithContentsOfFile:path
+                                               options:NSDataReadingMappedIfSafe
+                                                 error:nil]
+                      : nil;
+  if (!data) {
+    return nil;
+  }
+  id plist = [NSPropertyListSerialization propertyListWithData:data
+                                                       options:NSPropertyListImmutable
+                                                        format:NULL
+                                                         error:nil];
+  return [plist isKindOfClass:[NSDictionary class]] ? plist : nil;
+}
+
 @implementation GIDSignInStrings
 
 + (nullable NSString *)localizedStringForKey:(NSString *)key text:(NSString *)text {
-  NSBundle *frameworkBundle = [NSBundle gid_frameworkBundle];
-  if (frameworkBundle == nil) {
-    return text;
+  NSString *localizedString = [self stringsTable][key];
+  return localizedString ?: text;
+}
+
+// Returns the strings table for the bundle's preferred localization, with the development
+// localization's strings for any keys it is missing, as -[NSBundle localizedStringForKey:...]
+// does. The compiled tables are memory mapped and parsed once, after which each lookup is a single
+// hash lookup.
++ (NSDictionary<NSString *, NSString *> *)stringsTable {
+  @synchronized(self) {
+    if (gStringsTable) {
+      return gStringsTable;
+    }
+  }
+
+  NSBundle *bundle = [NSBundle gid_frameworkBundle];
+  NSDictionary<NSString *, NSString *> *table = @{};
+  if (bundle) {
+    NSString *developmentLocalization =
+        bundle.developmentLocalization ?: kDefaultDevelopmentLocalization;
+    NSString *preferredLocalization =
+        bundle.preferredLocalizations.firstObject ?: developmentLocalization;
+    NSDictionary<NSString *, NSString *> *preferredTable =
+        GIDStringsTable(bundle, preferredLocalization);
+    NSDictionary<NSString *, NSString *> *developmentTable =
+        [preferredLocalization isEqualToString:developmentLocalization]
+            ? nil
+            : GIDStringsTable(bundle, developmentLocalization);
+    if (preferredTable && developmentTable) {
+      NSMutableDictionary<NSString *, NSString *> *mergedTable = [developmentTable mutableCopy];
+      [mergedTable addEntriesFromDictionary:preferredTable];
+      table = [mergedTable copy];
+    } else {
+      table = preferredTable ?: developmentTable ?: @{};
+    }
+  }
+
+  @synchronized(self) {
+    gStringsTable = table;
   }
-  return [frameworkBundle localizedStringForKey:key value:text table:kStringsTableName];
+  return table;
 }
 
 + (nullable NSString *)signInString {
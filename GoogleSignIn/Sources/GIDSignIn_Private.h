@@ -26,11 +26,17 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class GIDCancellationToken;
 @class GIDGoogleUser;
+@class GIDProfileData;
 @class GIDSignInInternalOptions;
+@class OIDAuthState;
+@class OIDIDToken;
 @class GTMKeychainStore;
 @class GIDAppCheck;
 @class GIDAuthStateMigration;
+@class GIDTokenRevocationQueue;
+@protocol GIDAuthStateStore;
 
 /// User preference key to detect fresh install of the app.
 extern NSString *const kAppHasRunBeforeKey;
@@ -49,10 +55,17 @@ typedef void (^GIDDisconnectCompletion)(NSError *_Nullable error);
 /// Redeclare |currentUser| as readwrite for internal use.
 @property(nonatomic, readwrite, nullable) GIDGoogleUser *currentUser;
 
+/// The queue that revokes the tokens of users disconnected in the background.
+@property(nonatomic) GIDTokenRevocationQueue *tokenRevocationQueue;
+
 /// Private initializer taking a `GTMKeychainStore`.
 - (instancetype)initWithKeychainStore:(GTMKeychainStore *)keychainStore
             authStateMigrationService:(GIDAuthStateMigration *)authStateMigrationService;
 
+/// Private initializer taking the `GIDAuthStateStore` to persist the auth state with.
+- (instancetype)initWithAuthStateStore:(id<GIDAuthStateStore>)authStateStore
+             authStateMigrationService:(GIDAuthStateMigration *)authStateMigrationService;
+
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
 /// Private initializer taking a `GTMKeychainStore` and `GIDAppCheckProvider`.
 - (instancetype)initWithKeychainStore:(GTMKeychainStore *)keychainStore
@@ -72,6 +85,21 @@ API_AVAILABLE(ios(14));
 /// @return NO if there is no user restored from the keychain.
 - (BOOL)restorePreviousSignInNoRefresh;
 
+/// Fetches the basic profile of a user from the userinfo endpoint.
+///
+/// The last profile fetched is saved with its HTTP validators and, for the same user, revalidated
+/// with a conditional request, so an unchanged profile is returned without being downloaded again.
+///
+/// @param authState The auth state of the user.
+/// @param idToken The decoded ID token of the user, which provides the email address.
+/// @param completion The block that is called with the profile, or with an error if it could not be
+///     fetched.
+/// @return A token that stops the fetch.  The completion is not called once it is cancelled.
+- (GIDCancellationToken *)fetchProfileDataWithAuthState:(OIDAuthState *)authState
+                                                idToken:(nullable OIDIDToken *)idToken
+                                             completion:
+    (void (^)(GIDProfileData *_Nullable profileData, NSError *_Nullable error))completion;
+
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
 
 /// Starts an interactive consent flow on iOS to add scopes to the current user's grants.
@@ -83,10 +111,12 @@ API_AVAILABLE(ios(14));
 /// @param presentingViewController The view controller used to present `SFSafariViewController` on
 ///     iOS 9 and 10 and to supply `presentationContextProvider` for `ASWebAuthenticationSession` on
 ///     iOS 13+.
+/// @param cancellationToken The token that cancels the consent flow.
 /// @param completion The block that is called on completion.  This block will be called asynchronously
 ///     on the main queue.
 - (void)addScopes:(NSArray<NSString *> *)scopes
     presentingViewController:(UIViewController *)presentingViewController
+           cancellationToken:(GIDCancellationToken *)cancellationToken
                   completion:(nullable GIDSignInCompletion)completion
     NS_EXTENSION_UNAVAILABLE("The add scopes flow is not supported in App Extensions.");
 
@@ -100,11 +130,13 @@ API_AVAILABLE(ios(14));
 /// @param scopes An array of scopes to ask the user to consent to.
 /// @param presentingWindow The window used to supply `presentationContextProvider` for
 ///     `ASWebAuthenticationSession`.
+/// @param cancellationToken The token that cancels the consent flow.
 /// @param completion The block that is called on completion.  This block will be called asynchronously
 ///     on the main queue.
 - (void)addScopes:(NSArray<NSString *> *)scopes
-    presentingWindow:(NSWindow *)presentingWindow
-          completion:(nullable GIDSignInCompletion)completion;
+     presentingWindow:(NSWindow *)presentingWindow
+    cancellationToken:(GIDCancellationToken *)cancellationToken
+           completion:(nullable GIDSignInCompletion)completion;
 
 #endif
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A rolling estimate of how long a recurring operation takes, smoothed over recent samples.
+///
+/// The estimate tracks both the smoothed latency and its mean deviation, so that the prediction
+/// stays conservative while samples are noisy.
+@interface GIDLatencyEstimator : NSObject
+
+/// The number of samples added so far.
+@property(nonatomic, readonly) NSUInteger sampleCount;
+
+/// The exponentially weighted moving average of the samples, or 0 if there are none.
+@property(nonatomic, readonly) NSTimeInterval smoothedLatency;
+
+/// The exponentially weighted mean deviation of the samples, or 0 if there are none.
+@property(nonatomic, readonly) NSTimeInterval latencyDeviation;
+
+/// A latency that most operations are expected to complete within, or 0 if there are no samples.
+@property(nonatomic, readonly) NSTimeInterval predictedLatency;
+
+/// Records how long one operation took. Negative samples are ignored.
+- (void)addSample:(NSTimeInterval)latency;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDTimedLoader/GIDLatencyEstimator.h"
+
+#include <math.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The weight given to a new sample in the smoothed latency.
+static const double kSmoothingFactor = 0.125;
+/// The weight given to a new sample's deviation in the mean deviation.
+static const double kDeviationFactor = 0.25;
+/// How many mean deviations above the smoothed latency the prediction allows for.
+static const double kDeviationMultiplier = 2;
+
+@implementation GIDLatencyEstimator
+
+- (void)addSample:(NSTimeInterval)latency {
+  if (latency < 0 || isnan(latency)) {
+    return;
+  }
+  @synchronized(self) {
+    if (_sampleCount == 0) {
+      _smoothedLatency = latency;
+      _latencyDeviation = latency / 2;
+    } else {
+      NSTimeInterval error = fabs(latency - _smoothedLatency);
+      _latencyDeviation += kDeviationFactor * (error - _latencyDeviation);
+      _smoothedLatency += kSmoothingFactor * (latency - _smoothedLatency);
+    }
+    _sampleCount++;
+  }
+}
+
+- (NSTimeInterval)predictedLatency {
+  @synchronized(self) {
+    if (_sampleCount == 0) {
+      return 0;
+    }
+    return _smoothedLatency + kDeviationMultiplier * _latencyDeviation;
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -29,11 +29,31 @@ typedef NS_ENUM(NSUInteger, GIDTimedLoaderAnimationStatus) {
   GIDTimedLoaderAnimationStatusStopped,
 };
 
+/// The events reported by the timed loader while timing a load.
+typedef NS_ENUM(NSUInteger, GIDTimedLoaderEvent) {
+  /// The timed loader started timing.
+  GIDTimedLoaderEventStarted,
+  /// The loading activity indicator was presented.
+  GIDTimedLoaderEventPresented,
+  /// The work finished before the loading activity indicator was presented.
+  GIDTimedLoaderEventFinishedWithoutPresenting,
+  /// The work finished while the loading activity indicator was presented; the completion is held
+  /// until the indicator has been shown long enough.
+  GIDTimedLoaderEventFinishedWhilePresenting,
+  /// The completion passed to `stopTimingWithCompletion:` was invoked.
+  GIDTimedLoaderEventCompleted,
+};
+
 /// The minimum animation duration time for the timed loader's activity indicator.
 extern CFTimeInterval const kGIDTimedLoaderMinAnimationDuration;
 /// The maximum delay to wait before the time loader will display the loading activity indicator.
 extern CFTimeInterval const kGIDTimedLoaderMaxDelayBeforeAnimating;
+/// The shortest time the activity indicator is held once the loader has latency samples to go on.
+extern CFTimeInterval const kGIDTimedLoaderMinAdaptiveAnimationDuration;
+/// The longest the loader will defer presenting when the work is predicted to finish by then.
+extern CFTimeInterval const kGIDTimedLoaderMaxAdaptiveDelayBeforeAnimating;
 
+@class GIDLatencyEstimator;
 @class UIViewController;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -43,6 +63,11 @@ NS_ASSUME_NONNULL_BEGIN
 ///
 /// `GIDTimedLoader` will also only show its loading screen until
 /// `kGIDTimedLoaderMaxDelayBeforeAnimating` has expired.
+///
+/// Once loads have been timed, the delay and minimum duration adapt to the latency of recent loads:
+/// presenting is deferred, up to `kGIDTimedLoaderMaxAdaptiveDelayBeforeAnimating`, when the work is
+/// predicted to finish by then, and the indicator is held only as long as the work is predicted to
+/// take, but no less than `kGIDTimedLoaderMinAdaptiveAnimationDuration`.
 @interface GIDTimedLoader : NSObject
 
 /// Created this timed loading controller with the provided presenting view controller, which will
@@ -63,6 +88,26 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property(nonatomic) GIDTimedLoaderAnimationStatus animationStatus;
 
+/// The rolling estimate of how long the timed work takes, updated each time timing stops.
+@property(nonatomic, readonly) GIDLatencyEstimator *latencyEstimator;
+
+/// An optional handler invoked as each event happens, with the time elapsed since `startTiming`.
+@property(nonatomic, copy, nullable) void (^eventHandler)(GIDTimedLoaderEvent event,
+                                                          CFTimeInterval elapsed);
+
+/// The time the loader added on top of the work in the most recent load, i.e. the time between
+/// `stopTimingWithCompletion:` being called and its completion being invoked.
+@property(nonatomic, readonly) CFTimeInterval lastAddedLatency;
+
+/// The delay before presenting the activity indicator for a load predicted to take
+/// `predictedLatency`, or 0 if there is no prediction yet.
++ (CFTimeInterval)delayBeforeAnimatingForPredictedLatency:(CFTimeInterval)predictedLatency;
+
+/// The minimum duration to show the activity indicator for, when it is presented `elapsed` into a
+/// load predicted to take `predictedLatency`, or 0 if there is no prediction yet.
++ (CFTimeInterval)minAnimationDurationForPredictedLatency:(CFTimeInterval)predictedLatency
+                                                  elapsed:(CFTimeInterval)elapsed;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -22,17 +22,27 @@
 @import CoreMedia;
 #import "GoogleSignIn/Sources/GIDAppCheck/Implementations/GIDAppCheck.h"
 #import "GoogleSignIn/Sources/GIDAppCheck/UI/GIDActivityIndicatorViewController.h"
+#import "GoogleSignIn/Sources/GIDTimedLoader/GIDLatencyEstimator.h"
 
 CFTimeInterval const kGIDTimedLoaderMinAnimationDuration = 1.0;
 CFTimeInterval const kGIDTimedLoaderMaxDelayBeforeAnimating = 0.8;
+CFTimeInterval const kGIDTimedLoaderMinAdaptiveAnimationDuration = 0.4;
+CFTimeInterval const kGIDTimedLoaderMaxAdaptiveDelayBeforeAnimating = 1.5;
 
 @interface GIDTimedLoader ()
 
 @property(nonatomic, strong) UIViewController *presentingViewController;
 @property(nonatomic, strong) GIDActivityIndicatorViewController *loadingViewController;
 @property(nonatomic, strong, nullable) NSTimer *loadingTimer;
-/// Timestamp representing when the loading view controller was presented and started animating
+/// Timestamp representing when timing started
+@property(nonatomic) CFTimeInterval startTimeStamp;
+/// Timestamp representing when the loading view controller was presented and started animating, or
+/// 0 if it has not been presented during the current load
 @property(nonatomic) CFTimeInterval loadingTimeStamp;
+/// The minimum duration to show the loading view controller for during the current load
+@property(nonatomic) CFTimeInterval minAnimationDuration;
+@property(nonatomic, readwrite) GIDLatencyEstimator *latencyEstimator;
+@property(nonatomic, readwrite) CFTimeInterval lastAddedLatency;
 
 @end
 
@@ -43,6 +53,8 @@ CFTimeInterval const kGIDTimedLoaderMaxDelayBeforeAnimating = 0.8;
     _presentingViewController = presentingViewController;
     _loadingViewController = [[GIDActivityIndicatorViewController alloc] init];
     _animationStatus = GIDTimedLoaderAnimationStatusNotStarted;
+    _latencyEstimator = [[GIDLatencyEstimator alloc] init];
+    _minAnimationDuration = kGIDTimedLoaderMinAnimationDuration;
   }
   return self;
 }
@@ -53,11 +65,16 @@ CFTimeInterval const kGIDTimedLoaderMaxDelayBeforeAnimating = 0.8;
   }
 
   self.animationStatus = GIDTimedLoaderAnimationStatusAnimating;
-  self.loadingTimer = [NSTimer scheduledTimerWithTimeInterval:kGIDTimedLoaderMaxDelayBeforeAnimating
+  self.startTimeStamp = CACurrentMediaTime();
+  self.loadingTimeStamp = 0;
+  CFTimeInterval predictedLatency = self.latencyEstimator.predictedLatency;
+  CFTimeInterval delay = [GIDTimedLoader delayBeforeAnimatingForPredictedLatency:predictedLatency];
+  self.loadingTimer = [NSTimer scheduledTimerWithTimeInterval:delay
                                                        target:self
                                                      selector:@selector(presentLoadingViewController)
                                                      userInfo:nil
                                                       repeats:NO];
+  [self reportEvent:GIDTimedLoaderEventStarted];
 }
 
 - (void)presentLoadingViewController {
@@ -66,6 +83,11 @@ CFTimeInterval const kGIDTimedLoaderMaxDelayBeforeAnimating = 0.8;
   }
   self.animationStatus = GIDTimedLoaderAnimationStatusAnimating;
   self.loadingTimeStamp = CACurrentMediaTime();
+  CFTimeInterval elapsed = self.loadingTimeStamp - self.startTimeStamp;
+  self.minAnimationDuration =
+      [GIDTimedLoader minAnimationDurationForPredictedLatency:self.latencyEstimator.predictedLatency
+                                                      elapsed:elapsed];
+  [self reportEvent:GIDTimedLoaderEventPresented];
   dispatch_async(dispatch_get_main_queue(), ^{
     // Since this loading VC may be reused, the activity indicator may have been stopped; restart it
     self.loadingViewController.modalPresentationStyle = UIModalPresentationOverCurrentContext;
@@ -86,29 +108,68 @@ CFTimeInterval const kGIDTimedLoaderMaxDelayBeforeAnimating = 0.8;
   [self.loadingTimer invalidate];
   self.loadingTimer = nil;
 
+  CFTimeInterval stopTimeStamp = CACurrentMediaTime();
+  [self.latencyEstimator addSample:stopTimeStamp - self.startTimeStamp];
+  BOOL presented = self.loadingTimeStamp > 0;
+  [self reportEvent:presented ? GIDTimedLoaderEventFinishedWhilePresenting
+                              : GIDTimedLoaderEventFinishedWithoutPresenting];
+
   dispatch_time_t deadline = [self remainingDurationToAnimate];
   dispatch_after(deadline, dispatch_get_main_queue(), ^{
     self.animationStatus = GIDTimedLoaderAnimationStatusStopped;
-    [self.loadingViewController.activityIndicator stopAnimating];
-    [self.loadingViewController dismissViewControllerAnimated:YES completion:nil];
+    if (presented) {
+      [self.loadingViewController.activityIndicator stopAnimating];
+      [self.loadingViewController dismissViewControllerAnimated:YES completion:nil];
+    }
+    self.lastAddedLatency = CACurrentMediaTime() - stopTimeStamp;
+    [self reportEvent:GIDTimedLoaderEventCompleted];
     completion();
   });
 }
 
++ (CFTimeInterval)delayBeforeAnimatingForPredictedLatency:(CFTimeInterval)predictedLatency {
+  // Presenting just before the work is expected to finish would cost the user the full minimum
+  // animation duration, so wait a little longer when the work should be done by then.
+  if (predictedLatency > kGIDTimedLoaderMaxDelayBeforeAnimating &&
+      predictedLatency <= kGIDTimedLoaderMaxAdaptiveDelayBeforeAnimating) {
+    return predictedLatency;
+  }
+  return kGIDTimedLoaderMaxDelayBeforeAnimating;
+}
+
++ (CFTimeInterval)minAnimationDurationForPredictedLatency:(CFTimeInterval)predictedLatency
+                                                  elapsed:(CFTimeInterval)elapsed {
+  CFTimeInterval predictedRemaining = predictedLatency - elapsed;
+  // Without a prediction, or once the work is overdue, fall back to the full duration.
+  if (predictedLatency <= 0 || predictedRemaining <= 0) {
+    return kGIDTimedLoaderMinAnimationDuration;
+  }
+  return MIN(kGIDTimedLoaderMinAnimationDuration,
+             MAX(kGIDTimedLoaderMinAdaptiveAnimationDuration, predictedRemaining));
+}
+
+- (void)reportEvent:(GIDTimedLoaderEvent)event {
+  if (self.eventHandler) {
+    self.eventHandler(event, CACurrentMediaTime() - self.startTimeStamp);
+  }
+}
+
 - (dispatch_time_t)remainingDurationToAnimate {
-  // If we are not animating, then no need to wait
-  if (self.animationStatus != GIDTimedLoaderAnimationStatusAnimating) {
+  // If we are not animating, or the loading view controller was never presented, then no need to
+  // wait
+  if (self.animationStatus != GIDTimedLoaderAnimationStatusAnimating ||
+      self.loadingTimeStamp == 0) {
     return 0;
   }
 
   CFTimeInterval now = CACurrentMediaTime();
   CFTimeInterval durationWaited = now - self.loadingTimeStamp;
   // If we have already waited for the minimum animation duration, then no need to wait
-  if (durationWaited >= kGIDTimedLoaderMinAnimationDuration) {
+  if (durationWaited >= self.minAnimationDuration) {
     return 0;
   }
 
-  CFTimeInterval diff = kGIDTimedLoaderMinAnimationDuration - durationWaited;
+  CFTimeInterval diff = self.minAnimationDuration - durationWaited;
   int64_t diffNanos = diff * NSEC_PER_SEC;
   dispatch_time_t timeToWait = dispatch_time(DISPATCH_TIME_NOW, diffNanos);
   return timeToWait;
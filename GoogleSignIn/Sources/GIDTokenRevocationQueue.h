@@ -0,0 +1,66 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol GIDAuthStateStore;
+@protocol GTMSessionFetcherServiceProtocol;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Revokes tokens in the background.
+///
+/// Queued tokens are saved in an auth state store until they are revoked, so a revocation that
+/// fails, for example while offline, is retried with exponential backoff, including after the app
+/// restarts. Each pass revokes all the pending tokens at once, whichever accounts they belong to.
+@interface GIDTokenRevocationQueue : NSObject
+
+/// Creates a queue that saves the pending tokens in `authStateStore` on `storeQueue`.
+///
+/// @param authStateStore The store to save the pending tokens in.
+/// @param storeQueue The serial queue the store is accessed on. The revocation queue also keeps
+///     its own state on it.
+/// @param storeReadyGroup The optional group to wait for before the store is first read, such as
+///     a migration of the stored auth state.
+/// @param fetcherService The fetcher service to revoke the tokens with, or `nil` to use standalone
+///     fetchers.
+- (instancetype)initWithAuthStateStore:(id<GIDAuthStateStore>)authStateStore
+                            storeQueue:(dispatch_queue_t)storeQueue
+                       storeReadyGroup:(nullable dispatch_group_t)storeReadyGroup
+                        fetcherService:(nullable id<GTMSessionFetcherServiceProtocol>)fetcherService
+    NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Saves `token` for revocation and starts revoking the pending tokens.
+///
+/// This doesn't block the caller. The token is saved on the store queue ahead of anything queued
+/// on it afterwards, so the caller can remove its own copy through that queue right away.
+///
+/// @param token The access or refresh token to revoke.
+/// @param completion The optional block called on the main queue once the token is revoked, or is
+///     rejected by the server as invalid. It is not called if the app exits first.
+- (void)revokeToken:(NSString *)token completion:(nullable void (^)(void))completion;
+
+/// Starts revoking the saved tokens right away, such as those left over from a previous launch.
+- (void)resume;
+
+/// The URL of the request that revokes `token`.
++ (NSURL *)revokeURLForToken:(NSString *)token;
+
+@end
+
+NS_ASSUME_NONNULL_END
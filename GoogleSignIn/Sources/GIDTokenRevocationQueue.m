@@ -0,0 +1,203 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDTokenRevocationQueue.h"
+
+#import "GoogleSignIn/Sources/GIDAuthStateStore/API/GIDAuthStateStore.h"
+#import "GoogleSignIn/Sources/GIDSignInPreferences.h"
+
+#ifdef SWIFT_PACKAGE
+@import GTMSessionFetcherCore;
+#else
+#import <GTMSessionFetcher/GTMSessionFetcher.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+static NSString *const kRevokeTokenURLTemplate = @"https://%@/o/oauth2/revoke?token=%@";
+
+// The timeout of a revocation request, so that a stalled request doesn't hold up its pass and the
+// retries of the tokens that failed with it.
+static const NSTimeInterval kRevocationRequestTimeout = 15.0;
+
+// The delay before retrying after the first failed pass. It doubles with every failed pass.
+static const NSTimeInterval kInitialRetryDelay = 30.0;
+
+// The longest delay between two passes.
+static const NSTimeInterval kMaxRetryDelay = 60.0 * 60.0;
+
+// Whether a revocation that failed with |error| may succeed later. The server rejects tokens that
+// are already revoked or expired, which can't be revoked anymore either.
+static BOOL GIDIsTransientRevocationError(NSError *error) {
+  if ([error.domain isEqualToString:kGTMSessionFetcherStatusDomain]) {
+    return error.code == 429 || error.code >= 500;
+  }
+  return YES;
+}
+
+@implementation GIDTokenRevocationQueue {
+  id<GIDAuthStateStore> _authStateStore;
+  id<GTMSessionFetcherServiceProtocol> _fetcherService;
+  // The queue the store and all the state below are accessed on.
+  dispatch_queue_t _storeQueue;
+  // The group to wait for before the store is first read.
+  dispatch_group_t _storeReadyGroup;
+  // The tokens that are yet to be revoked, loaded from the store on first use.
+  NSMutableArray<NSString *> *_pendingTokens;
+  // The completions of the queued tokens, by token.
+  NSMutableDictionary<NSString *, NSMutableArray<void (^)(void)> *> *_completions;
+  // Whether a pass is in progress.
+  BOOL _revoking;
+  // The number of passes that failed in a row.
+  NSUInteger _failedPassCount;
+}
+
+- (instancetype)initWithAuthStateStore:(id<GIDAuthStateStore>)authStateStore
+                            storeQueue:(dispatch_queue_t)storeQueue
+                       storeReadyGroup:(nullable dispatch_group_t)storeReadyGroup
+                        fetcherService:
+                            (nullable id<GTMSessionFetcherServiceProtocol>)fetcherService {
+  self = [super init];
+  if (self) {
+    _authStateStore = authStateStore;
+    _fetcherService = fetcherService;
+    _storeQueue = storeQueue;
+    _storeReadyGroup = storeReadyGroup;
+    _completions = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (void)revokeToken:(NSString *)token completion:(nullable void (^)(void))completion {
+  dispatch_async(_storeQueue, ^{
+    NSMutableArray<NSString *> *pendingTokens = [self pendingTokens];
+    if (![pendingTokens containsObject:token]) {
+      [pendingTokens addObject:token];
+      [self->_authStateStore savePendingRevocations:pendingTokens error:nil];
+    }
+    if (completion) {
+      NSMutableArray<void (^)(void)> *completions = self->_completions[token];
+      if (!completions) {
+        completions = [NSMutableArray array];
+        self->_completions[token] = completions;
+      }
+      [completions addObject:[completion copy]];
+    }
+    // A new request is a good time to try again, whatever the backoff.
+    self->_failedPassCount = 0;
+    [self startPass];
+  });
+}
+
+- (void)resume {
+  dispatch_async(_storeQueue, ^{
+    [self startPass];
+  });
+}
+
++ (NSURL *)revokeURLForToken:(NSString *)token {
+  NSString *revokeURLString = [NSString stringWithFormat:kRevokeTokenURLTemplate,
+      [GIDSignInPreferences googleAuthorizationServer], token];
+  // Append logging parameter
+  revokeURLString = [NSString stringWithFormat:@"%@&%@=%@&%@=%@",
+                     revokeURLString,
+                     kSDKVersionLoggingParameter,
+                     GIDVersion(),
+                     kEnvironmentLoggingParameter,
+                     GIDEnvironment()];
+  return [NSURL URLWithString:revokeURLString];
+}
+
+#pragma mark - Private methods
+
+// Returns the pending tokens, reading them from the store the first time. Must be called on
+// |_storeQueue|.
+- (NSMutableArray<NSString *> *)pendingTokens {
+  if (!_pendingTokens) {
+    if (_storeReadyGroup) {
+      dispatch_group_wait(_storeReadyGroup, DISPATCH_TIME_FOREVER);
+    }
+    NSArray<NSString *> *savedTokens = [_authStateStore retrievePendingRevocationsWithError:nil];
+    _pendingTokens = savedTokens ? [savedTokens mutableCopy] : [NSMutableArray array];
+  }
+  return _pendingTokens;
+}
+
+// Revokes all the pending tokens, unless a pass is already in progress. Must be called on
+// |_storeQueue|.
+- (void)startPass {
+  NSArray<NSString *> *tokens = [[self pendingTokens] copy];
+  if (_revoking || !tokens.count) {
+    return;
+  }
+  _revoking = YES;
+  dispatch_group_t group = dispatch_group_create();
+  __block BOOL failed = NO;
+  for (NSString *token in tokens) {
+    dispatch_group_enter(group);
+    NSURLRequest *request = [NSURLRequest requestWithURL:[[self class] revokeURLForToken:token]
+                                             cachePolicy:NSURLRequestUseProtocolCachePolicy
+                                         timeoutInterval:kRevocationRequestTimeout];
+    GTMSessionFetcher *fetcher = _fetcherService ?
+        [_fetcherService fetcherWithRequest:request] :
+        [GTMSessionFetcher fetcherWithRequest:request];
+    fetcher.comment = @"GIDTokenRevocationQueue: revoke token";
+    [fetcher beginFetchWithCompletionHandler:^(NSData *data, NSError *error) {
+      dispatch_async(self->_storeQueue, ^{
+        if (error && GIDIsTransientRevocationError(error)) {
+          failed = YES;
+        } else {
+          [self finishToken:token];
+        }
+        dispatch_group_leave(group);
+      });
+    }];
+  }
+  dispatch_group_notify(group, _storeQueue, ^{
+    self->_revoking = NO;
+    if (!failed) {
+      self->_failedPassCount = 0;
+      // Revoke the tokens queued during the pass.
+      [self startPass];
+      return;
+    }
+    self->_failedPassCount++;
+    NSTimeInterval delay =
+        MIN(kInitialRetryDelay * pow(2, self->_failedPassCount - 1), kMaxRetryDelay);
+    __weak GIDTokenRevocationQueue *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                   self->_storeQueue, ^{
+      [weakSelf startPass];
+    });
+  });
+}
+
+// Removes |token| from the pending tokens and calls its completions. Must be called on
+// |_storeQueue|.
+- (void)finishToken:(NSString *)token {
+  NSMutableArray<NSString *> *pendingTokens = [self pendingTokens];
+  [pendingTokens removeObject:token];
+  [_authStateStore savePendingRevocations:pendingTokens error:nil];
+  NSArray<void (^)(void)> *completions = _completions[token];
+  [_completions removeObjectForKey:token];
+  for (void (^completion)(void) in completions) {
+    dispatch_async(dispatch_get_main_queue(), completion);
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
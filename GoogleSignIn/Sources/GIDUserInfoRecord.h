@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class GIDProfileData;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A userinfo response cached for revalidation, with the HTTP validators it was served with.
+///
+/// The record is bound to the user it was fetched for, so a record left over from another user is
+/// never sent to the server or returned as that user's profile.
+@interface GIDUserInfoRecord : NSObject <NSSecureCoding>
+
+/// The subject of the ID token of the user the profile belongs to.
+@property(nonatomic, readonly) NSString *userID;
+
+/// The profile parsed from the response.
+@property(nonatomic, readonly) GIDProfileData *profileData;
+
+/// The value of the `ETag` header of the response.
+@property(nonatomic, readonly, nullable) NSString *entityTag;
+
+/// The value of the `Last-Modified` header of the response.
+@property(nonatomic, readonly, nullable) NSString *lastModified;
+
+- (instancetype)initWithUserID:(NSString *)userID
+                   profileData:(GIDProfileData *)profileData
+                     entityTag:(nullable NSString *)entityTag
+                  lastModified:(nullable NSString *)lastModified NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Adds the conditional request headers for the record's validators to `request`.
+- (void)addValidatorsToRequest:(NSMutableURLRequest *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
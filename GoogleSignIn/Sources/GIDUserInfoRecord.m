@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "GoogleSignIn/Sources/GIDUserInfoRecord.h"
+
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDProfileData.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Key constants used for encode and decode.
+static NSString *const kUserIDKey = @"user_id";
+static NSString *const kProfileDataKey = @"profile_data";
+static NSString *const kEntityTagKey = @"entity_tag";
+static NSString *const kLastModifiedKey = @"last_modified";
+
+@implementation GIDUserInfoRecord
+
+- (instancetype)initWithUserID:(NSString *)userID
+                   profileData:(GIDProfileData *)profileData
+                     entityTag:(nullable NSString *)entityTag
+                  lastModified:(nullable NSString *)lastModified {
+  self = [super init];
+  if (self) {
+    _userID = [userID copy];
+    _profileData = profileData;
+    _entityTag = [entityTag copy];
+    _lastModified = [lastModified copy];
+  }
+  return self;
+}
+
+- (void)addValidatorsToRequest:(NSMutableURLRequest *)request {
+  if (_entityTag) {
+    [request setValue:_entityTag forHTTPHeaderField:@"If-None-Match"];
+  }
+  if (_lastModified) {
+    [request setValue:_lastModified forHTTPHeaderField:@"If-Modified-Since"];
+  }
+}
+
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding {
+  return YES;
+}
+
+- (nullable instancetype)initWithCoder:(NSCoder *)decoder {
+  NSString *userID = [decoder decodeObjectOfClass:[NSString class] forKey:kUserIDKey];
+  GIDProfileData *profileData = [decoder decodeObjectOfClass:[GIDProfileData class]
+                                                      forKey:kProfileDataKey];
+  if (!userID || !profileData) {
+    return nil;
+  }
+  return [self initWithUserID:userID
+                  profileData:profileData
+                    entityTag:[decoder decodeObjectOfClass:[NSString class] forKey:kEntityTagKey]
+                 lastModified:[decoder decodeObjectOfClass:[NSString class]
+                                                    forKey:kLastModifiedKey]];
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder {
+  [encoder encodeObject:_userID forKey:kUserIDKey];
+  [encoder encodeObject:_profileData forKey:kProfileDataKey];
+  [encoder encodeObject:_entityTag forKey:kEntityTagKey];
+  [encoder encodeObject:_lastModified forKey:kLastModifiedKey];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
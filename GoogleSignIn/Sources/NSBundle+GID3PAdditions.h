@@ -20,10 +20,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface NSBundle (GID3PAdditions)
 
-// Gets the bundle for the SDK framework.
+// Gets the bundle for the SDK framework. The bundle is resolved on first use and then reused.
 + (nullable NSBundle *)gid_frameworkBundle;
 
-// Registers fonts needed for the SDK to work. Okay to call multiple times.
+// Registers fonts needed for the SDK to work. Okay to call multiple times, from any thread.
 + (void)gid_registerFonts;
 
 @end
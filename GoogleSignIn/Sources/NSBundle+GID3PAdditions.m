@@ -33,15 +33,22 @@ NSString *const GoogleSignInBundleName = @"GoogleSignIn";
 @implementation NSBundle (GID3PAdditions)
 
 + (nullable NSBundle *)gid_frameworkBundle {
-  // Look for the resource bundle in the main bundle.
-  NSString *path = [[NSBundle mainBundle] pathForResource:GoogleSignInBundleName
-                                                   ofType:@"bundle"];
-  if (!path) {
-    // If we can't find the resource bundle in the main bundle, look for it in the framework bundle.
-    path = [[NSBundle bundleForClass:[GIDSignIn class]] pathForResource:GoogleSignInBundleName
-                                                                 ofType:@"bundle"];
-  }
-  return [NSBundle bundleWithPath:path];
+  // The bundle can't move while the app runs, so it is only searched for once.
+  static NSBundle *frameworkBundle;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    // Look for the resource bundle in the main bundle.
+    NSString *path = [[NSBundle mainBundle] pathForResource:GoogleSignInBundleName
+                                                     ofType:@"bundle"];
+    if (!path) {
+      // If we can't find the resource bundle in the main bundle, look for it in the framework
+      // bundle.
+      path = [[NSBundle bundleForClass:[GIDSignIn class]] pathForResource:GoogleSignInBundleName
+                                                                   ofType:@"bundle"];
+    }
+    frameworkBundle = path ? [NSBundle bundleWithPath:path] : nil;
+  });
+  return frameworkBundle;
 }
 
 + (void)gid_registerFonts {
@@ -0,0 +1,67 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GoogleSignIn/Sources/NSData+GIDBase64URL.h"
+
+#include <stdlib.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+static const char kBase64URLAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+@implementation NSData (GIDBase64URL)
+
+- (NSString *)gid_base64URLEncodedString {
+  const uint8_t *input = self.bytes;
+  NSUInteger length = self.length;
+  NSUInteger outputLength = (length + 2) / 3 * 4;
+  if (outputLength == 0) {
+    return @"";
+  }
+  char *output = malloc(outputLength);
+  if (!output) {
+    return @"";
+  }
+
+  char *out = output;
+  NSUInteger i = 0;
+  for (; i + 3 <= length; i += 3) {
+    uint32_t triple = (uint32_t)input[i] << 16 | (uint32_t)input[i + 1] << 8 | input[i + 2];
+    *out++ = kBase64URLAlphabet[(triple >> 18) & 0x3F];
+    *out++ = kBase64URLAlphabet[(triple >> 12) & 0x3F];
+    *out++ = kBase64URLAlphabet[(triple >> 6) & 0x3F];
+    *out++ = kBase64URLAlphabet[triple & 0x3F];
+  }
+  NSUInteger remainder = length - i;
+  if (remainder > 0) {
+    uint32_t triple = (uint32_t)input[i] << 16;
+    if (remainder == 2) {
+      triple |= (uint32_t)input[i + 1] << 8;
+    }
+    *out++ = kBase64URLAlphabet[(triple >> 18) & 0x3F];
+    *out++ = kBase64URLAlphabet[(triple >> 12) & 0x3F];
+    *out++ = remainder == 2 ? kBase64URLAlphabet[(triple >> 6) & 0x3F] : '=';
+    *out++ = '=';
+  }
+
+  return [[NSString alloc] initWithBytesNoCopy:output
+                                        length:outputLength
+                                      encoding:NSASCIIStringEncoding
+                                  freeWhenDone:YES];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A handle that cancels asynchronous requests, such as a sign-in or a token refresh.
+///
+/// Create a token and pass it to a method that takes a `cancellationToken`. Cancelling the token
+/// cancels every request it was passed to. A cancelled request doesn't call its completion. The
+/// work behind it, such as a browser session or a network fetch, stops once no other request is
+/// waiting for it.
+@interface GIDCancellationToken : NSObject
+
+/// Creates a token that is not cancelled.
+- (instancetype)init;
+
+/// Whether the token has been cancelled.
+@property(nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/// Cancels the requests the token was passed to.
+///
+/// Their completions are only guaranteed not to be called afterwards when this is called on the
+/// main queue. Called on another queue, a completion that is already being delivered on the main
+/// queue may still be called. Calling this more than once, or after the requests completed, has no
+/// effect.
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -25,6 +25,7 @@
 
 #import <GTMSessionFetcher/GTMSessionFetcher.h>
 
+@class GIDCancellationToken;
 @class GIDConfiguration;
 @class GIDSignInResult;
 @class GIDToken;
@@ -72,6 +73,44 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)refreshTokensIfNeededWithCompletion:(void (^)(GIDGoogleUser *_Nullable user,
                                                       NSError *_Nullable error))completion;
 
+/// Refreshes the user's tokens like `refreshTokensIfNeededWithCompletion:`, which can be cancelled
+/// with `cancellationToken`.
+///
+/// A cancelled request doesn't call its completion.  A refresh shared with other requests keeps
+/// running for them.
+///
+/// @param cancellationToken The token that cancels this request.
+/// @param completion A completion block that takes a `GIDGoogleUser` or an error if the attempt to
+///     refresh tokens was unsuccessful.  The block will be called asynchronously on the main queue.
+- (void)refreshTokensIfNeededWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                                        completion:(void (^)(GIDGoogleUser *_Nullable user,
+                                                             NSError *_Nullable error))completion
+    NS_SWIFT_NAME(refreshTokensIfNeeded(cancellationToken:completion:));
+
+/// Loads the user's basic profile if `profile` is `nil`, as it is when the ID token does not
+/// include it and `GIDSignIn.defersProfileLoading` is set.
+///
+/// The loaded profile is also set as `profile`.
+///
+/// @param completion The optional block that is called with the profile, or with an error if it
+///     could not be loaded.  The block will be called asynchronously on the main queue.
+- (void)loadProfileWithCompletion:(nullable void (^)(GIDProfileData *_Nullable profile,
+                                                     NSError *_Nullable error))completion;
+
+/// Loads the user's basic profile like `loadProfileWithCompletion:`, which can be cancelled with
+/// `cancellationToken`.
+///
+/// A cancelled request doesn't call its completion.  A load shared with other requests keeps
+/// running for them.
+///
+/// @param cancellationToken The token that cancels this request.
+/// @param completion The optional block that is called with the profile, or with an error if it
+///     could not be loaded.  The block will be called asynchronously on the main queue.
+- (void)loadProfileWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                              completion:(nullable void (^)(GIDProfileData *_Nullable profile,
+                                                            NSError *_Nullable error))completion
+    NS_SWIFT_NAME(loadProfile(cancellationToken:completion:));
+
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
 
 /// Starts an interactive consent flow on iOS to add new scopes to the user's `grantedScopes`.
@@ -91,6 +130,21 @@ NS_ASSUME_NONNULL_BEGIN
                                                 NSError *_Nullable error))completion
     NS_EXTENSION_UNAVAILABLE("The add scopes flow is not supported in App Extensions.");
 
+/// Starts an interactive consent flow on iOS like `addScopes:presentingViewController:completion:`,
+/// which can be cancelled with `cancellationToken`.
+///
+/// @param scopes The scopes to ask the user to consent to.
+/// @param presentingViewController The view controller used to present the authorization flow.
+/// @param cancellationToken The token that cancels the consent flow.
+/// @param completion The optional block that is called on completion.  This block will be called
+///     asynchronously on the main queue.
+- (void)addScopes:(NSArray<NSString *> *)scopes
+    presentingViewController:(UIViewController *)presentingViewController
+           cancellationToken:(GIDCancellationToken *)cancellationToken
+                  completion:(nullable void (^)(GIDSignInResult *_Nullable signInResult,
+                                                NSError *_Nullable error))completion
+    NS_EXTENSION_UNAVAILABLE("The add scopes flow is not supported in App Extensions.");
+
 #elif TARGET_OS_OSX
 
 /// Starts an interactive consent flow on macOS to add new scopes to the user's `grantedScopes`.
@@ -108,6 +162,21 @@ NS_ASSUME_NONNULL_BEGIN
           completion:(nullable void (^)(GIDSignInResult *_Nullable signInResult,
                                         NSError *_Nullable error))completion;
 
+/// Starts an interactive consent flow on macOS like `addScopes:presentingWindow:completion:`, which
+/// can be cancelled with `cancellationToken`.
+///
+/// @param scopes An array of scopes to ask the user to consent to.
+/// @param presentingWindow The window used to supply `presentationContextProvider` for
+///     `ASWebAuthenticationSession`.
+/// @param cancellationToken The token that cancels the consent flow.
+/// @param completion The optional block that is called on completion.  This block will be called
+///     asynchronously on the main queue.
+- (void)addScopes:(NSArray<NSString *> *)scopes
+     presentingWindow:(NSWindow *)presentingWindow
+    cancellationToken:(GIDCancellationToken *)cancellationToken
+           completion:(nullable void (^)(GIDSignInResult *_Nullable signInResult,
+                                         NSError *_Nullable error))completion;
+
 #endif
 
 @end
@@ -23,6 +23,7 @@
 #import <AppKit/AppKit.h>
 #endif
 
+@class GIDCancellationToken;
 @class GIDConfiguration;
 @class GIDGoogleUser;
 @class GIDSignInResult;
@@ -56,6 +57,8 @@ typedef NS_ERROR_ENUM(kGIDSignInErrorDomain, GIDSignInErrorCode) {
   kGIDSignInErrorCodeJSONSerializationFailure = -10,
   /// Indicates that the refresh token has expired and the user must be re-authorized.
   kGIDSignInErrorCodeRefreshTokenExpired = -11,
+  /// Indicates the request did not complete before its timeout.
+  kGIDSignInErrorCodeTimedOut = -12,
 };
 
 /// This class is used to sign in users with their Google account and manage their session.
@@ -73,6 +76,29 @@ typedef NS_ERROR_ENUM(kGIDSignInErrorDomain, GIDSignInErrorCode) {
 /// The active configuration for this instance of `GIDSignIn`.
 @property(nonatomic, nullable) GIDConfiguration *configuration;
 
+/// Whether signing in skips fetching the basic profile when the ID token does not include it.
+///
+/// Fetching the profile takes an extra request before sign-in completes. When this is `YES`,
+/// `GIDGoogleUser.profile` stays `nil` in that case until it is loaded with
+/// `-[GIDGoogleUser loadProfileWithCompletion:]`. Defaults to `NO`.
+@property(nonatomic) BOOL defersProfileLoading;
+
+/// Whether sign-in completes before the signed-in user has been saved to the keychain.
+///
+/// When this is `YES`, `currentUser` is set and the completion is called as soon as the tokens
+/// are validated, and the user is saved in the background. If saving fails, the user stays signed
+/// in for this session and `persistenceErrorHandler` is called. Later calls to `signOut`,
+/// `disconnectWithCompletion:` and `restorePreviousSignInWithCompletion:` wait for pending saves,
+/// so they never act on stale saved state. Defaults to `NO`.
+@property(nonatomic) BOOL persistsAuthStateAsynchronously;
+
+/// Called on the main queue with a `kGIDSignInErrorCodeKeychain` error when saving a signed-in user
+/// in the background fails.
+///
+/// Only used when `persistsAuthStateAsynchronously` is `YES`, since sign-in otherwise fails with
+/// that error.
+@property(nonatomic, copy, nullable) void (^persistenceErrorHandler)(NSError *error);
+
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
 
 /// Configures `GIDSignIn` for use.
@@ -131,6 +157,88 @@ NS_SWIFT_NAME(configureDebugProvider(withAPIKey:completion:));
 - (void)restorePreviousSignInWithCompletion:(nullable void (^)(GIDGoogleUser *_Nullable user,
                                                                NSError *_Nullable error))completion;
 
+/// Attempts to restore a previous user sign-in like `restorePreviousSignInWithCompletion:`, which
+/// can be cancelled with `cancellationToken`.
+///
+/// A cancelled restore doesn't call its completion.  Its token refresh keeps running if another
+/// restore still waits for it.
+///
+/// @param cancellationToken The token that cancels the restore.
+/// @param completion The block that is called on completion.  This block will be called
+///     asynchronously on the main queue.
+- (void)restorePreviousSignInWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                                        completion:
+    (nullable void (^)(GIDGoogleUser *_Nullable user, NSError *_Nullable error))completion
+    NS_SWIFT_NAME(restorePreviousSignIn(cancellationToken:completion:));
+
+/// Attempts to restore a previous user sign-in without interaction, failing if it takes longer than
+/// `timeout`.
+///
+/// The timeout covers every step of the restore, and each network request is given what is left of
+/// it as its own timeout.  Once the timeout passes, the completion is called with a
+/// `kGIDSignInErrorCodeTimedOut` error and the restore is cancelled, unless another restore is
+/// still waiting for its result.
+///
+/// @param timeout The time in seconds the restore may take.
+/// @param completion The block that is called on completion.  This block will be called
+///     asynchronously on the main queue.
+- (void)restorePreviousSignInWithTimeout:(NSTimeInterval)timeout
+                              completion:(nullable void (^)(GIDGoogleUser *_Nullable user,
+                                                            NSError *_Nullable error))completion
+    NS_SWIFT_NAME(restorePreviousSignIn(timeout:completion:));
+
+/// Attempts to restore a previous user sign-in like `restorePreviousSignInWithTimeout:completion:`,
+/// which can also be cancelled with `cancellationToken`.
+///
+/// @param timeout The time in seconds the restore may take.
+/// @param cancellationToken The token that cancels the restore.
+/// @param completion The block that is called on completion.  This block will be called
+///     asynchronously on the main queue.
+- (void)restorePreviousSignInWithTimeout:(NSTimeInterval)timeout
+                       cancellationToken:(GIDCancellationToken *)cancellationToken
+                              completion:(nullable void (^)(GIDGoogleUser *_Nullable user,
+                                                            NSError *_Nullable error))completion
+    NS_SWIFT_NAME(restorePreviousSignIn(timeout:cancellationToken:completion:));
+
+/// Attempts to restore a previous user sign-in without interaction, without waiting for its tokens
+/// to be refreshed.
+///
+/// The saved user is passed to `restoredUserHandler` as soon as it is read from the keychain, so
+/// signed-in UI can be shown right away. Its tokens are then refreshed in the background if they
+/// have expired, updating the same `GIDGoogleUser`, and `completion` is called as with
+/// `restorePreviousSignInWithCompletion:`.
+///
+/// @param restoredUserHandler The block that is called with the saved user and whether its tokens
+///     are fresh, meaning they will not be refreshed. It is not called if there is no saved user.
+///     This block will be called asynchronously on the main queue.
+/// @param completion The block that is called once the tokens have been refreshed, or with an error
+///     if the user could not be restored. This block will be called asynchronously on the main
+///     queue.
+- (void)restorePreviousSignInWithRestoredUserHandler:
+            (void (^)(GIDGoogleUser *user, BOOL tokensAreFresh))restoredUserHandler
+                                          completion:
+            (nullable void (^)(GIDGoogleUser *_Nullable user, NSError *_Nullable error))completion
+    NS_SWIFT_NAME(restorePreviousSignIn(restoredUserHandler:completion:));
+
+/// Attempts to restore a previous user sign-in like
+/// `restorePreviousSignInWithRestoredUserHandler:completion:`, which can be cancelled with
+/// `cancellationToken`.
+///
+/// Once the restore is cancelled, neither `restoredUserHandler` nor `completion` is called.
+///
+/// @param restoredUserHandler The block that is called with the saved user and whether its tokens
+///     are fresh.  This block will be called asynchronously on the main queue.
+/// @param cancellationToken The token that cancels the restore.
+/// @param completion The block that is called once the tokens have been refreshed, or with an error
+///     if the user could not be restored. This block will be called asynchronously on the main
+///     queue.
+- (void)restorePreviousSignInWithRestoredUserHandler:
+            (void (^)(GIDGoogleUser *user, BOOL tokensAreFresh))restoredUserHandler
+                                   cancellationToken:(GIDCancellationToken *)cancellationToken
+                                          completion:
+            (nullable void (^)(GIDGoogleUser *_Nullable user, NSError *_Nullable error))completion
+    NS_SWIFT_NAME(restorePreviousSignIn(restoredUserHandler:cancellationToken:completion:));
+
 /// Signs out the `currentUser`, removing it from the keychain.
 - (void)signOut;
 
@@ -140,6 +248,56 @@ NS_SWIFT_NAME(configureDebugProvider(withAPIKey:completion:));
 ///     This block will be called asynchronously on the main queue.
 - (void)disconnectWithCompletion:(nullable void (^)(NSError *_Nullable error))completion;
 
+/// Disconnects the `currentUser` like `disconnectWithCompletion:`, which can be cancelled with
+/// `cancellationToken`.
+///
+/// A cancelled disconnect doesn't call its completion, and leaves the user signed in if the grants
+/// were not revoked yet.
+///
+/// @param cancellationToken The token that cancels the disconnect.
+/// @param completion The optional block that is called on completion.
+///     This block will be called asynchronously on the main queue.
+- (void)disconnectWithCancellationToken:(GIDCancellationToken *)cancellationToken
+                             completion:(nullable void (^)(NSError *_Nullable error))completion
+    NS_SWIFT_NAME(disconnect(cancellationToken:completion:));
+
+/// Disconnects the `currentUser` like `disconnectWithCompletion:`, failing if it takes longer than
+/// `timeout`.
+///
+/// The revoke request is given `timeout` as its own timeout.  Once the timeout passes, the
+/// completion is called with a `kGIDSignInErrorCodeTimedOut` error and the disconnect is
+/// cancelled, leaving the user signed in if the grants were not revoked yet.
+///
+/// @param timeout The time in seconds the disconnect may take.
+/// @param completion The optional block that is called on completion.
+///     This block will be called asynchronously on the main queue.
+- (void)disconnectWithTimeout:(NSTimeInterval)timeout
+                   completion:(nullable void (^)(NSError *_Nullable error))completion
+    NS_SWIFT_NAME(disconnect(timeout:completion:));
+
+/// Disconnects the `currentUser` like `disconnectWithTimeout:completion:`, which can also be
+/// cancelled with `cancellationToken`.
+///
+/// @param timeout The time in seconds the disconnect may take.
+/// @param cancellationToken The token that cancels the disconnect.
+/// @param completion The optional block that is called on completion.
+///     This block will be called asynchronously on the main queue.
+- (void)disconnectWithTimeout:(NSTimeInterval)timeout
+            cancellationToken:(GIDCancellationToken *)cancellationToken
+                   completion:(nullable void (^)(NSError *_Nullable error))completion
+    NS_SWIFT_NAME(disconnect(timeout:cancellationToken:completion:));
+
+/// Disconnects the `currentUser` like `disconnectWithCompletion:`, but signs them out right away
+/// and revokes the scope grants in the background.
+///
+/// The token to revoke is saved before the user is signed out, and revoking it is retried with
+/// backoff until it succeeds, including after the app is relaunched, so the grants are revoked
+/// even if the device is offline.
+///
+/// @param completion The optional block that is called once the grants are revoked. This block will
+///     be called asynchronously on the main queue, and is not called if the app exits first.
+- (void)disconnectInBackgroundWithCompletion:(nullable void (^)(void))completion;
+
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
 
 /// Starts an interactive sign-in flow on iOS.
@@ -317,6 +475,34 @@ NS_EXTENSION_UNAVAILABLE("The sign-in flow is not supported in App Extensions.")
                        NSError *_Nullable error))completion
     NS_EXTENSION_UNAVAILABLE("The sign-in flow is not supported in App Extensions.");
 
+/// Starts an interactive sign-in flow on iOS like
+/// `signInWithPresentingViewController:hint:additionalScopes:nonce:claims:completion:`, which
+/// can be cancelled with `cancellationToken`.
+///
+/// A cancelled sign-in doesn't call its completion, and its browser session is dismissed unless
+/// another request still waits for the same flow.
+///
+/// @param presentingViewController The view controller used to present the authorization flow.
+/// @param hint An optional hint for the authorization server, for example the user's ID or email
+///     address, to be prefilled if possible.
+/// @param additionalScopes An optional array of scopes to request in addition to the basic profile
+///     scopes.
+/// @param nonce An optional custom nonce.
+/// @param claims An optional `NSSet` of claims to request.
+/// @param cancellationToken The token that cancels the sign-in.
+/// @param completion The optional block that is called on completion.  This block will
+///     be called asynchronously on the main queue.
+- (void)signInWithPresentingViewController:(UIViewController *)presentingViewController
+                                      hint:(nullable NSString *)hint
+                          additionalScopes:(nullable NSArray<NSString *> *)additionalScopes
+                                     nonce:(nullable NSString *)nonce
+                                    claims:(nullable NSSet<GIDClaim *> *)claims
+                         cancellationToken:(GIDCancellationToken *)cancellationToken
+                                completion:
+    (nullable void (^)(GIDSignInResult *_Nullable signInResult,
+                       NSError *_Nullable error))completion
+    NS_EXTENSION_UNAVAILABLE("The sign-in flow is not supported in App Extensions.");
+
 #elif TARGET_OS_OSX
 
 /// Starts an interactive sign-in flow on macOS.
@@ -471,6 +657,33 @@ NS_EXTENSION_UNAVAILABLE("The sign-in flow is not supported in App Extensions.")
                         completion:(nullable void (^)(GIDSignInResult *_Nullable signInResult,
                                                       NSError *_Nullable error))completion;
 
+/// Starts an interactive sign-in flow on macOS like
+/// `signInWithPresentingWindow:hint:additionalScopes:nonce:claims:completion:`, which can be
+/// cancelled with `cancellationToken`.
+///
+/// A cancelled sign-in doesn't call its completion, and its browser session is dismissed unless
+/// another request still waits for the same flow.
+///
+/// @param presentingWindow The window used to supply `presentationContextProvider` for
+///     `ASWebAuthenticationSession`.
+/// @param hint An optional hint for the authorization server, for example the user's ID or email
+///     address, to be prefilled if possible.
+/// @param additionalScopes An optional array of scopes to request in addition to the basic profile
+///     scopes.
+/// @param nonce An optional custom nonce.
+/// @param claims An optional `NSSet` of claims to request.
+/// @param cancellationToken The token that cancels the sign-in.
+/// @param completion The optional block that is called on completion.  This block will
+///     be called asynchronously on the main queue.
+- (void)signInWithPresentingWindow:(NSWindow *)presentingWindow
+                              hint:(nullable NSString *)hint
+                  additionalScopes:(nullable NSArray<NSString *> *)additionalScopes
+                             nonce:(nullable NSString *)nonce
+                            claims:(nullable NSSet<GIDClaim *> *)claims
+                 cancellationToken:(GIDCancellationToken *)cancellationToken
+                        completion:(nullable void (^)(GIDSignInResult *_Nullable signInResult,
+                                                      NSError *_Nullable error))completion;
+
 #endif
 
 @end
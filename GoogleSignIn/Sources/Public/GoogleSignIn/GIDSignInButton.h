@@ -61,6 +61,12 @@ typedef NS_ENUM(NSInteger, GIDSignInButtonColorScheme) {
 /// - kGIDSignInButtonColorSchemeLight (default)
 @property(nonatomic, assign) GIDSignInButtonColorScheme colorScheme;
 
+/// Registers the button font on a background queue.
+///
+/// Calling this early, for example while the app launches, keeps the font registration off the
+/// main thread when the first button is created. Calling it is optional and safe to repeat.
++ (void)prefetchResources;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #import "GIDAppCheckError.h"
+#import "GIDCancellationToken.h"
 #import "GIDConfiguration.h"
 #import "GIDGoogleUser.h"
 #import "GIDProfileData.h"
@@ -0,0 +1,403 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <TargetConditionals.h>
+#import <XCTest/XCTest.h>
+
+#include <pthread.h>
+
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+#import <UIKit/UIKit.h>
+#endif
+
+#import "GoogleSignIn/Sources/GIDCallbackQueue.h"
+#import "GoogleSignIn/Sources/GIDClaimsInternalOptions.h"
+#import "GoogleSignIn/Sources/GIDGoogleUser_Private.h"
+#import "GoogleSignIn/Sources/GIDJSONSerializer/Implementation/GIDJSONSerializerImpl.h"
+#import "GoogleSignIn/Sources/NSData+GIDBase64URL.h"
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDClaim.h"
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDGoogleUser.h"
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDProfileData.h"
+#import "GoogleSignIn/Tests/Unit/GIDProfileData+Testing.h"
+#import "GoogleSignIn/Tests/Unit/OIDAuthState+Testing.h"
+
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+#import "GoogleSignIn/Sources/GIDEMMSupport.h"
+#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDSignInButton.h"
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+
+#ifdef SWIFT_PACKAGE
+@import AppAuth;
+#else
+#import <AppAuth/OIDAuthState.h>
+#endif
+
+/// The number of operations counted and timed by each measurement.
+static const NSUInteger kBenchmarkIterations = 1000;
+
+/// The name of the checked-in baseline, a JSON object mapping each benchmark's operation name to
+/// its allocations per operation.
+static NSString *const kBaselineResourceName = @"GIDBenchmarkBaseline";
+
+/// The relative increase in allocations per operation over the baseline that fails a benchmark.
+static const double kAllocationTolerance = 0.1;
+
+/// The environment variable that switches the benchmarks to recording the baseline. Its value is
+/// the path of the baseline file to update, which on a simulator or a Mac can be the checked-in
+/// file itself.
+static const char *const kRecordBaselineEnvironmentVariable = "GID_RECORD_BENCHMARK_BASELINE";
+
+#pragma mark - Allocation Counting
+
+/// The signature of libmalloc's logging hook, which it calls for every allocation and free.
+typedef void(GIDMallocLogger)(uint32_t type,
+                              uintptr_t arg1,
+                              uintptr_t arg2,
+                              uintptr_t arg3,
+                              uintptr_t result,
+                              uint32_t numHotFramesToSkip);
+
+/// The hook libmalloc calls, if set; the same one malloc stack logging and Instruments use.
+extern GIDMallocLogger *malloc_logger;
+
+/// The `type` bit libmalloc sets for allocations, including the new block of a reallocation.
+static const uint32_t kGIDMallocLogTypeAllocate = 2;
+
+/// The thread whose allocations are counted, and the count so far. Only touched by that thread
+/// while the hook is installed.
+static pthread_t gCountedThread;
+static uint64_t gAllocationCount;
+static GIDMallocLogger *gPreviousMallocLogger;
+
+static void GIDCountingMallocLogger(uint32_t type,
+                                    uintptr_t arg1,
+                                    uintptr_t arg2,
+                                    uintptr_t arg3,
+                                    uintptr_t result,
+                                    uint32_t numHotFramesToSkip) {
+  if ((type & kGIDMallocLogTypeAllocate) && pthread_equal(pthread_self(), gCountedThread)) {
+    gAllocationCount++;
+  }
+  if (gPreviousMallocLogger) {
+    gPreviousMallocLogger(type, arg1, arg2, arg3, result, numHotFramesToSkip + 1);
+  }
+}
+
+/// Returns the number of heap allocations the current thread makes while running `block`.
+///
+/// Unlike `malloc_zone_statistics`, which only reports the blocks still in use, this also counts
+/// the temporary allocations that are freed again before `block` returns.
+static uint64_t GIDCountAllocations(void (^block)(void)) {
+  gCountedThread = pthread_self();
+  gAllocationCount = 0;
+  gPreviousMallocLogger = malloc_logger;
+  malloc_logger = GIDCountingMallocLogger;
+  block();
+  malloc_logger = gPreviousMallocLogger;
+  return gAllocationCount;
+}
+
+#pragma mark - GIDBenchmarkTest
+
+/// Benchmarks for the SDK's hot paths.
+///
+/// Each benchmark counts the heap allocations of `kBenchmarkIterations` operations and fails if
+/// the allocations per operation exceed the checked-in baseline by more than
+/// `kAllocationTolerance`. Allocation counts, unlike timings, carry across machines, so they can
+/// be compared against a single baseline. A benchmark missing from the baseline fails, so that a
+/// new benchmark can't pass without being compared. To record the baseline, run with
+/// `GID_RECORD_BENCHMARK_BASELINE` set to the path of the baseline file (prefix it with
+/// `TEST_RUNNER_` when passing it to `xcodebuild`).
+///
+/// Each benchmark then times the same operations with XCTest, so that the reported time divided by
+/// `kBenchmarkIterations` is the cost of one operation. These run in their own test target, apart
+/// from the unit tests.
+@interface GIDBenchmarkTest : XCTestCase
+@end
+
+@implementation GIDBenchmarkTest
+
+#pragma mark - Helpers
+
+/// Runs `kBenchmarkIterations` operations once to warm caches, counts the allocations of another
+/// run and compares them against the baseline, then times the operations with XCTest.
+- (void)measureOperationNamed:(NSString *)name operation:(void (^)(void))operation {
+  void (^operations)(void) = ^{
+    for (NSUInteger i = 0; i < kBenchmarkIterations; i++) {
+      @autoreleasepool {
+        operation();
+      }
+    }
+  };
+
+  operations();
+  double allocationsPerOperation =
+      (double)GIDCountAllocations(operations) / kBenchmarkIterations;
+  [self checkAllocationsPerOperation:allocationsPerOperation forOperationNamed:name];
+
+  if (@available(iOS 13, macOS 10.15, *)) {
+    [self measureWithMetrics:@[ [[XCTClockMetric alloc] init] ] block:operations];
+  } else {
+    [self measureBlock:operations];
+  }
+}
+
+/// Reports `allocationsPerOperation` and compares it against the baseline, or records it in the
+/// baseline when recording.
+- (void)checkAllocationsPerOperation:(double)allocationsPerOperation
+                   forOperationNamed:(NSString *)name {
+  NSString *summary = [NSString stringWithFormat:@"%@: %.1f allocations/op",
+                                                 name, allocationsPerOperation];
+  [XCTContext runActivityNamed:summary block:^(id<XCTActivity> activity) {
+    [activity addAttachment:[XCTAttachment attachmentWithString:summary]];
+  }];
+
+  const char *recordPath = getenv(kRecordBaselineEnvironmentVariable);
+  if (recordPath) {
+    [self recordAllocationsPerOperation:allocationsPerOperation
+                      forOperationNamed:name
+                                 atPath:@(recordPath)];
+    return;
+  }
+
+  NSNumber *baseline = [[self class] baseline][name];
+  if (!baseline) {
+    XCTFail(@"%@ has no baseline. Record it by running with %s set to the path of %@.json.",
+            name, kRecordBaselineEnvironmentVariable, kBaselineResourceName);
+    return;
+  }
+  double limit = baseline.doubleValue * (1 + kAllocationTolerance);
+  XCTAssertLessThanOrEqual(allocationsPerOperation, limit,
+                           @"%@ allocates more than its baseline of %@ allocations/op",
+                           name, baseline);
+}
+
+/// The checked-in allocations per operation, keyed by operation name.
++ (NSDictionary<NSString *, NSNumber *> *)baseline {
+  static NSDictionary<NSString *, NSNumber *> *baseline;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    NSBundle *bundle = [NSBundle bundleForClass:self];
+    NSURL *URL = [bundle URLForResource:kBaselineResourceName withExtension:@"json"];
+    NSData *data = URL ? [NSData dataWithContentsOfURL:URL] : nil;
+    id object = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+    baseline = [object isKindOfClass:[NSDictionary class]] ? object : @{};
+  });
+  return baseline;
+}
+
+/// Writes `allocationsPerOperation` into the baseline file at `path`, keeping its other entries.
+- (void)recordAllocationsPerOperation:(double)allocationsPerOperation
+                    forOperationNamed:(NSString *)name
+                               atPath:(NSString *)path {
+  NSData *data = [NSData dataWithContentsOfFile:path];
+  id object = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+  NSMutableDictionary<NSString *, NSNumber *> *baseline =
+      [object isKindOfClass:[NSDictionary class]] ? [object mutableCopy]
+                                                  : [NSMutableDictionary dictionary];
+  // Round to a tenth; finer differences are noise.
+  baseline[name] = @(round(allocationsPerOperation * 10) / 10);
+  NSError *error;
+  NSData *updatedData =
+      [NSJSONSerialization dataWithJSONObject:baseline
+                                      options:NSJSONWritingPrettyPrinted | NSJSONWritingSortedKeys
+                                        error:&error];
+  XCTAssertTrue([updatedData writeToFile:path options:NSDataWritingAtomic error:&error],
+                @"Could not record the baseline at %@: %@", path, error);
+}
+
+- (GIDGoogleUser *)googleUser {
+  return [[GIDGoogleUser alloc] initWithAuthState:[OIDAuthState testInstance]
+                                      profileData:[GIDProfileData testInstance]];
+}
+
+/// Passcode info shaped like the payload `GIDMDMPasscodeCache` encodes.
+- (NSData *)passcodeInfoData {
+  NSString *json = @"{\"LocalAuthentication\":{\"result\":1},\"Keychain\":{\"result\":0}}";
+  return [json dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+#pragma mark - GIDGoogleUser
+
+- (void)testBenchmark_googleUserInitialization {
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  GIDProfileData *profileData = [GIDProfileData testInstance];
+  [self measureOperationNamed:@"GIDGoogleUser init" operation:^{
+    (void)[[GIDGoogleUser alloc] initWithAuthState:authState profileData:profileData];
+  }];
+}
+
+- (void)testBenchmark_updateTokensWithAuthState {
+  GIDGoogleUser *user = [self googleUser];
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  [self measureOperationNamed:@"GIDGoogleUser updateTokensWithAuthState:" operation:^{
+    // The auth state change delegate callback is the entry point for token updates.
+    [user didChangeState:authState];
+  }];
+}
+
+- (void)testBenchmark_userIDAndGrantedScopes {
+  GIDGoogleUser *user = [self googleUser];
+  [self measureOperationNamed:@"GIDGoogleUser userID/grantedScopes" operation:^{
+    (void)user.userID;
+    (void)user.grantedScopes;
+  }];
+}
+
+- (void)testBenchmark_googleUserCodingRoundTrip {
+  GIDGoogleUser *user = [self googleUser];
+  [self measureOperationNamed:@"GIDGoogleUser NSSecureCoding round trip" operation:^{
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:user
+                                         requiringSecureCoding:YES
+                                                         error:nil];
+    (void)[NSKeyedUnarchiver unarchivedObjectOfClass:[GIDGoogleUser class]
+                                            fromData:data
+                                               error:nil];
+  }];
+}
+
+#pragma mark - GIDProfileData
+
+- (void)testBenchmark_profileDataCodingRoundTrip {
+  GIDProfileData *profileData = [GIDProfileData testInstance];
+  [self measureOperationNamed:@"GIDProfileData NSSecureCoding round trip" operation:^{
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:profileData
+                                         requiringSecureCoding:YES
+                                                         error:nil];
+    (void)[NSKeyedUnarchiver unarchivedObjectOfClass:[GIDProfileData class]
+                                            fromData:data
+                                               error:nil];
+  }];
+}
+
+- (void)testBenchmark_imageURLWithDimension {
+  GIDProfileData *profileData = [GIDProfileData testInstance];
+  __block NSUInteger dimension = 0;
+  [self measureOperationNamed:@"GIDProfileData imageURLWithDimension:" operation:^{
+    // Vary the dimension so that every call builds a new URL.
+    (void)[profileData imageURLWithDimension:++dimension % 512 + 1];
+  }];
+}
+
+#pragma mark - Claims
+
+- (void)testBenchmark_validatedJSONStringForClaims {
+  GIDClaimsInternalOptions *options = [[GIDClaimsInternalOptions alloc] init];
+  NSSet<GIDClaim *> *claims = [NSSet setWithObject:[GIDClaim essentialAuthTimeClaim]];
+  [self measureOperationNamed:@"GIDClaimsInternalOptions validatedJSONStringForClaims:"
+                    operation:^{
+    (void)[options validatedJSONStringForClaims:claims error:nil];
+  }];
+}
+
+#pragma mark - Serialization
+
+- (void)testBenchmark_jsonSerializer {
+  GIDJSONSerializerImpl *serializer = [[GIDJSONSerializerImpl alloc] init];
+  NSDictionary *object = @{ @"id_token" : @{ @"auth_time" : @{ @"essential" : @YES } } };
+  [self measureOperationNamed:@"GIDJSONSerializerImpl stringWithJSONObject:" operation:^{
+    (void)[serializer stringWithJSONObject:object error:NULL];
+  }];
+}
+
+- (void)testBenchmark_jsonSerializerReference {
+  NSDictionary *object = @{ @"id_token" : @{ @"auth_time" : @{ @"essential" : @YES } } };
+  [self measureOperationNamed:@"NSJSONSerialization dataWithJSONObject: (reference)"
+                    operation:^{
+    NSData *data = [NSJSONSerialization dataWithJSONObject:object options:0 error:NULL];
+    (void)[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+  }];
+}
+
+- (void)testBenchmark_base64URLEncoding {
+  NSData *data = [self passcodeInfoData];
+  [self measureOperationNamed:@"NSData gid_base64URLEncodedString" operation:^{
+    (void)[data gid_base64URLEncodedString];
+  }];
+}
+
+- (void)testBenchmark_base64URLEncodingReference {
+  NSData *data = [self passcodeInfoData];
+  [self measureOperationNamed:@"NSData base64 with URL-safe replacements (reference)"
+                    operation:^{
+    NSString *string = [data base64EncodedStringWithOptions:0];
+    string = [string stringByReplacingOccurrencesOfString:@"/" withString:@"_"];
+    (void)[string stringByReplacingOccurrencesOfString:@"+" withString:@"-"];
+  }];
+}
+
+#pragma mark - GIDCallbackQueue
+
+- (void)testBenchmark_callbackQueueThroughput {
+  GIDCallbackQueue *queue = [[GIDCallbackQueue alloc] init];
+  __block NSUInteger fired = 0;
+  [self measureOperationNamed:@"GIDCallbackQueue wait/addCallback/next" operation:^{
+    [queue wait];
+    [queue addCallback:^{
+      fired++;
+    }];
+    [queue next];
+  }];
+  XCTAssertGreaterThan(fired, 0u);
+}
+
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+
+#pragma mark - GIDEMMSupport
+
+- (void)testBenchmark_emmParameters {
+  NSDictionary *parameters = @{ @"emm_support" : @"1", @"device_os" : @"iOS 17.0" };
+  [self measureOperationNamed:@"GIDEMMSupport parametersWithParameters:" operation:^{
+    (void)[GIDEMMSupport parametersWithParameters:parameters
+                                       emmSupport:@"1"
+                           isPasscodeInfoRequired:YES];
+  }];
+}
+
+#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+
+#pragma mark - GIDSignInButton
+
+- (void)testBenchmark_signInButtonLayout {
+  GIDSignInButton *button = [[GIDSignInButton alloc] initWithFrame:CGRectMake(0, 0, 312, 48)];
+  __block NSUInteger count = 0;
+  [self measureOperationNamed:@"GIDSignInButton layout" operation:^{
+    button.style = count++ % 2 ? kGIDSignInButtonStyleWide : kGIDSignInButtonStyleStandard;
+    [button updateConstraintsIfNeeded];
+    [button layoutIfNeeded];
+  }];
+}
+
+- (void)testBenchmark_signInButtonDraw {
+  GIDSignInButton *button = [[GIDSignInButton alloc] initWithFrame:CGRectMake(0, 0, 312, 48)];
+  [button layoutIfNeeded];
+  UIGraphicsImageRenderer *renderer =
+      [[UIGraphicsImageRenderer alloc] initWithSize:button.bounds.size];
+  [self measureOperationNamed:@"GIDSignInButton draw" operation:^{
+    (void)[renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+      [button.layer renderInContext:context.CGContext];
+    }];
+  }];
+}
+
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+
+@end
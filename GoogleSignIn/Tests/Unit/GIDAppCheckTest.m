@@ -139,6 +139,123 @@ NS_CLASS_AVAILABLE_IOS(14)
   XCTAssertTrue([appCheck isPrepared]);
 }
 
+- (void)testPrepareKeepsTokenForFirstRequest {
+  XCTestExpectation *prepareExpectation =
+      [self expectationWithDescription:@"Prepare for App Check expectation"];
+
+  GACAppCheckToken *expectedToken = [[GACAppCheckToken alloc] initWithToken:@"foo"
+                                                             expirationDate:[NSDate distantFuture]];
+  GIDAppCheckProviderFake *fakeProvider =
+      [[GIDAppCheckProviderFake alloc] initWithAppCheckToken:expectedToken error:nil];
+  GIDAppCheck *appCheck = [[GIDAppCheck alloc] initWithAppCheckProvider:fakeProvider
+                                                           userDefaults:self.userDefaults];
+
+  [appCheck prepareForAppCheckWithCompletion:^(NSError * _Nullable error) {
+    XCTAssertNil(error);
+    [prepareExpectation fulfill];
+  }];
+
+  [self waitForExpectations:@[prepareExpectation] timeout:timeout];
+
+  XCTAssertTrue([appCheck hasPrefetchedToken]);
+  XCTAssertEqual(fakeProvider.limitedUseTokenRequestCount, 1);
+
+  // The prefetched token is handed out without waiting on the provider, but still asynchronously.
+  XCTestExpectation *tokenExpectation =
+      [self expectationWithDescription:@"getLimitedUseToken should succeed"];
+  __block GACAppCheckToken *receivedToken;
+  BOOL tokenIsReady = [appCheck getLimitedUseTokenWithCompletion:^(GACAppCheckToken *token,
+                                                                   NSError * _Nullable error) {
+    XCTAssertNil(error);
+    receivedToken = token;
+    [tokenExpectation fulfill];
+  }];
+  XCTAssertTrue(tokenIsReady);
+  XCTAssertNil(receivedToken);
+  XCTAssertFalse([appCheck hasPrefetchedToken]);
+
+  [self waitForExpectations:@[tokenExpectation] timeout:timeout];
+  XCTAssertEqualObjects(receivedToken, expectedToken);
+
+  // Handing out the token does not fetch another one that might never be used.
+  XCTAssertFalse([appCheck hasPrefetchedToken]);
+  XCTAssertEqual(fakeProvider.limitedUseTokenRequestCount, 1);
+}
+
+- (void)testPrepareWhenAlreadyPreparedDoesNotFetchToken {
+  [self.userDefaults setBool:YES forKey:kGIDAppCheckPreparedKey];
+  XCTestExpectation *prepareExpectation =
+      [self expectationWithDescription:@"Prepare for App Check expectation"];
+
+  GACAppCheckToken *expectedToken = [[GACAppCheckToken alloc] initWithToken:@"foo"
+                                                             expirationDate:[NSDate distantFuture]];
+  GIDAppCheckProviderFake *fakeProvider =
+      [[GIDAppCheckProviderFake alloc] initWithAppCheckToken:expectedToken error:nil];
+  GIDAppCheck *appCheck = [[GIDAppCheck alloc] initWithAppCheckProvider:fakeProvider
+                                                           userDefaults:self.userDefaults];
+
+  [appCheck prepareForAppCheckWithCompletion:^(NSError * _Nullable error) {
+    XCTAssertNil(error);
+    [prepareExpectation fulfill];
+  }];
+
+  [self waitForExpectations:@[prepareExpectation] timeout:timeout];
+
+  // Launching an already prepared app spends no quota until a sign-in is likely.
+  XCTAssertFalse([appCheck hasPrefetchedToken]);
+  XCTAssertEqual(fakeProvider.limitedUseTokenRequestCount, 0);
+}
+
+- (void)testPrefetchCoalescesConcurrentRequests {
+  GACAppCheckToken *expectedToken = [[GACAppCheckToken alloc] initWithToken:@"foo"
+                                                             expirationDate:[NSDate distantFuture]];
+  GIDAppCheckProviderFake *fakeProvider =
+      [[GIDAppCheckProviderFake alloc] initWithAppCheckToken:expectedToken error:nil];
+  GIDAppCheck *appCheck = [[GIDAppCheck alloc] initWithAppCheckProvider:fakeProvider
+                                                           userDefaults:self.userDefaults];
+
+  [appCheck prefetchLimitedUseToken];
+  [appCheck prefetchLimitedUseToken];
+
+  XCTestExpectation *tokenExpectation =
+      [self expectationWithDescription:@"getLimitedUseToken should succeed"];
+  BOOL tokenIsReady = [appCheck getLimitedUseTokenWithCompletion:^(GACAppCheckToken *token,
+                                                                   NSError * _Nullable error) {
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(token, expectedToken);
+    [tokenExpectation fulfill];
+  }];
+  XCTAssertFalse(tokenIsReady);
+
+  [self waitForExpectations:@[tokenExpectation] timeout:timeout];
+
+  // The waiting caller was served by the single in-flight prefetch.
+  XCTAssertEqual(fakeProvider.limitedUseTokenRequestCount, 1);
+}
+
+- (void)testTokenNearExpirationIsNotPrefetched {
+  XCTestExpectation *prepareExpectation =
+      [self expectationWithDescription:@"Prepare for App Check expectation"];
+
+  GACAppCheckToken *expiringToken =
+      [[GACAppCheckToken alloc] initWithToken:@"foo"
+                               expirationDate:[NSDate dateWithTimeIntervalSinceNow:10]];
+  GIDAppCheckProviderFake *fakeProvider =
+      [[GIDAppCheckProviderFake alloc] initWithAppCheckToken:expiringToken error:nil];
+  GIDAppCheck *appCheck = [[GIDAppCheck alloc] initWithAppCheckProvider:fakeProvider
+                                                           userDefaults:self.userDefaults];
+
+  [appCheck prepareForAppCheckWithCompletion:^(NSError * _Nullable error) {
+    XCTAssertNil(error);
+    [prepareExpectation fulfill];
+  }];
+
+  [self waitForExpectations:@[prepareExpectation] timeout:timeout];
+
+  XCTAssertTrue([appCheck isPrepared]);
+  XCTAssertFalse([appCheck hasPrefetchedToken]);
+}
+
 - (void)testAsyncCompletions {
   XCTestExpectation *firstPrepareExpectation =
       [self expectationWithDescription:@"First async prepare for App Check expectation"];
@@ -61,7 +61,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface GIDAuthStateMigration ()
 
-+ (nullable NSString *)passwordForService:(NSString *)service;
++ (NSDictionary<NSString *, NSString *> *)legacyPasswords;
 
 /// Returns a `GTMAuthSession` given the provided token URL.
 ///
@@ -227,6 +227,37 @@ NS_ASSUME_NONNULL_BEGIN
   XCTAssertNotNil(authorization);
 }
 
+- (void)testExtractAuthorization_NoFingerprint {
+  [[[_mockGIDAuthStateMigration expect] andReturn:@{}] legacyPasswords];
+
+  GIDAuthStateMigration *migration =
+      [[GIDAuthStateMigration alloc] initWithKeychainStore:_mockGTMKeychainStore];
+  GTMAuthSession *authorization =
+      [migration extractAuthSessionWithTokenURL:[NSURL URLWithString:kTokenURL]
+                                   callbackPath:kCallbackPath];
+
+  XCTAssertNil(authorization);
+}
+
+- (void)testExtractAuthorization_FingerprintOfOtherBundle {
+  // The GTMOAuth2 persistence string isn't read for another bundle's fingerprint.
+  [[_mockGTMKeychainStore reject] keychainHelper];
+  NSDictionary<NSString *, NSString *> *legacyPasswords = @{
+    kFingerprintService : kSavedFingerprint,
+  };
+  [[[_mockGIDAuthStateMigration expect] andReturn:legacyPasswords] legacyPasswords];
+  [[[_mockNSBundle expect] andReturn:_mockNSBundle] mainBundle];
+  [[[_mockNSBundle expect] andReturn:@"com.example.other"] bundleIdentifier];
+
+  GIDAuthStateMigration *migration =
+      [[GIDAuthStateMigration alloc] initWithKeychainStore:_mockGTMKeychainStore];
+  GTMAuthSession *authorization =
+      [migration extractAuthSessionWithTokenURL:[NSURL URLWithString:kTokenURL]
+                                   callbackPath:kCallbackPath];
+
+  XCTAssertNil(authorization);
+}
+
 - (void)testExtractAuthorization_HostedDomain {
   [self setUpCommonExtractAuthorizationMocksWithFingerPrint:kSavedFingerprint_HostedDomain];
 
@@ -282,19 +313,22 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (void)setUpCommonExtractAuthorizationMocksWithFingerPrint:(NSString *)fingerprint {
-  [[[_mockGIDAuthStateMigration expect] andReturn:fingerprint]
-      passwordForService:kFingerprintService];
+  // The GPPSignIn items are read with a single keychain query.
+  NSDictionary<NSString *, NSString *> *legacyPasswords = @{
+    kFingerprintService : fingerprint,
+    [self additionalTokenRequestParametersKeyFromFingerprint:fingerprint] :
+        kAdditionalTokenRequestParameters,
+  };
+  [[[_mockGIDAuthStateMigration expect] andReturn:legacyPasswords] legacyPasswords];
+  [[[_mockNSBundle expect] andReturn:_mockNSBundle] mainBundle];
+  [[[_mockNSBundle expect] andReturn:kBundleID] bundleIdentifier];
   (void)[[[_mockKeychainHelper expect] andReturn:kGTMOAuth2PersistenceString]
       passwordForService:fingerprint error:OCMArg.anyObjectRef];
   [[[_mockGTMKeychainStore expect] andReturn:_mockKeychainHelper] keychainHelper];
-  [[[_mockNSBundle expect] andReturn:_mockNSBundle] mainBundle];
-  [[[_mockNSBundle expect] andReturn:kBundleID] bundleIdentifier];
   [[[_mockGIDSignInCallbackSchemes expect] andReturn:_mockGIDSignInCallbackSchemes] alloc];
   (void)[[[_mockGIDSignInCallbackSchemes expect] andReturn:_mockGIDSignInCallbackSchemes]
       initWithClientIdentifier:kClientID];
   [[[_mockGIDSignInCallbackSchemes expect] andReturn:kDotReversedClientID] clientIdentifierScheme];
-  [[[_mockGIDAuthStateMigration expect] andReturn:kAdditionalTokenRequestParameters]
-      passwordForService:[self additionalTokenRequestParametersKeyFromFingerprint:fingerprint]];
 }
 
 @end
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDAuthStateStore/Fake/GIDFakeAuthStateStore.h"
+#import "GoogleSignIn/Sources/GIDUserInfoRecord.h"
+#import "GoogleSignIn/Tests/Unit/GIDProfileData+Testing.h"
+#import "GoogleSignIn/Tests/Unit/OIDAuthState+Testing.h"
+#import "GoogleSignIn/Tests/Unit/OIDTokenResponse+Testing.h"
+
+#ifdef SWIFT_PACKAGE
+@import AppAuth;
+#else
+#import <AppAuth/AppAuth.h>
+#endif
+
+static NSString *const kRefreshedAccessToken = @"refreshed_access_token";
+static NSString *const kEntityTag = @"\"etag\"";
+
+@interface GIDAuthStateStoreTest : XCTestCase
+@end
+
+@implementation GIDAuthStateStoreTest
+
+#pragma mark - GIDFakeAuthStateStore
+
+- (void)testFakeStore {
+  [self verifyStore:[[GIDFakeAuthStateStore alloc] init]];
+}
+
+- (void)testFakeStore_savedAuthStateIsSnapshot {
+  GIDFakeAuthStateStore *store = [[GIDFakeAuthStateStore alloc] init];
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  XCTAssertTrue([store saveAuthState:authState error:nil]);
+
+  [authState updateWithTokenResponse:[self refreshedTokenResponseForAuthState:authState]
+                               error:nil];
+
+  XCTAssertEqualObjects([store retrieveAuthStateWithError:nil].lastTokenResponse.accessToken,
+                        kAccessToken);
+}
+
+#pragma mark - Helpers
+
+// Verifies the store behavior that `GIDSignIn` relies on.
+- (void)verifyStore:(id<GIDAuthStateStore>)store {
+  NSError *error;
+  XCTAssertNil([store retrieveAuthStateWithError:&error]);
+  XCTAssertNil(error);
+  XCTAssertNil([store retrieveTokenResponseWithError:nil]);
+
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  XCTAssertTrue([store saveAuthState:authState error:nil]);
+  OIDAuthState *retrievedAuthState = [store retrieveAuthStateWithError:nil];
+  XCTAssertEqualObjects(retrievedAuthState.refreshToken, authState.refreshToken);
+  XCTAssertEqualObjects(retrievedAuthState.lastTokenResponse.accessToken, kAccessToken);
+  XCTAssertNil([store retrieveTokenResponseWithError:nil]);
+
+  XCTAssertTrue([store saveTokenResponse:[self refreshedTokenResponseForAuthState:authState]
+                                   error:nil]);
+  XCTAssertEqualObjects([store retrieveTokenResponseWithError:nil].accessToken,
+                        kRefreshedAccessToken);
+  // The token response is kept apart from the auth state.
+  XCTAssertEqualObjects([store retrieveAuthStateWithError:nil].lastTokenResponse.accessToken,
+                        kAccessToken);
+
+  // Saving a whole auth state replaces the token response.
+  XCTAssertTrue([store saveAuthState:authState error:nil]);
+  XCTAssertNil([store retrieveTokenResponseWithError:nil]);
+
+  XCTAssertNil([store retrieveUserInfoRecordWithError:nil]);
+  GIDUserInfoRecord *userInfoRecord =
+      [[GIDUserInfoRecord alloc] initWithUserID:kUserID
+                                    profileData:[GIDProfileData testInstance]
+                                      entityTag:kEntityTag
+                                   lastModified:nil];
+  XCTAssertTrue([store saveUserInfoRecord:userInfoRecord error:nil]);
+  GIDUserInfoRecord *retrievedUserInfoRecord = [store retrieveUserInfoRecordWithError:nil];
+  XCTAssertEqualObjects(retrievedUserInfoRecord.userID, kUserID);
+  XCTAssertEqualObjects(retrievedUserInfoRecord.profileData, [GIDProfileData testInstance]);
+  XCTAssertEqualObjects(retrievedUserInfoRecord.entityTag, kEntityTag);
+  XCTAssertNil(retrievedUserInfoRecord.lastModified);
+
+  // Saving a whole auth state keeps the userinfo response.
+  XCTAssertTrue([store saveAuthState:authState error:nil]);
+  XCTAssertNotNil([store retrieveUserInfoRecordWithError:nil]);
+
+  XCTAssertNil([store retrievePendingRevocationsWithError:nil]);
+  XCTAssertTrue([store savePendingRevocations:@[ kAccessToken, kRefreshToken ] error:nil]);
+  XCTAssertEqualObjects([store retrievePendingRevocationsWithError:nil],
+                        (@[ kAccessToken, kRefreshToken ]));
+
+  XCTAssertTrue([store saveTokenResponse:[self refreshedTokenResponseForAuthState:authState]
+                                   error:nil]);
+  XCTAssertTrue([store removeAuthStateWithError:nil]);
+  XCTAssertNil([store retrieveAuthStateWithError:nil]);
+  XCTAssertNil([store retrieveTokenResponseWithError:nil]);
+  XCTAssertNil([store retrieveUserInfoRecordWithError:nil]);
+  // Tokens are queued for revocation when their user is removed, so they outlive the auth state.
+  XCTAssertEqualObjects([store retrievePendingRevocationsWithError:nil],
+                        (@[ kAccessToken, kRefreshToken ]));
+
+  XCTAssertTrue([store savePendingRevocations:@[] error:nil]);
+  XCTAssertNil([store retrievePendingRevocationsWithError:nil]);
+}
+
+- (OIDTokenResponse *)refreshedTokenResponseForAuthState:(OIDAuthState *)authState {
+  return [OIDTokenResponse testInstanceWithIDToken:[OIDTokenResponse idToken]
+                                       accessToken:kRefreshedAccessToken
+                                         expiresIn:@(kAccessTokenExpiresIn)
+                                      refreshToken:authState.refreshToken
+                                      tokenRequest:[authState tokenRefreshRequest]];
+}
+
+@end
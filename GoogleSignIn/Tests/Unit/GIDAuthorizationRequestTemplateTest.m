@@ -0,0 +1,150 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDAuthorizationRequestTemplate.h"
+
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDConfiguration.h"
+
+#import "GoogleSignIn/Sources/GIDSignInInternalOptions.h"
+#import "GoogleSignIn/Sources/GIDSignInPreferences.h"
+#import "GoogleSignIn/Tests/Unit/GIDFakeMainBundle.h"
+
+static NSString *const kClientId = @"FakeClientID";
+static NSString *const kServerClientId = @"FakeServerClientID";
+static NSString *const kHostedDomain = @"fakehosteddomain.com";
+static NSString *const kCallbackPath = @"/oauth2callback";
+
+@interface GIDAuthorizationRequestTemplateTest : XCTestCase
+@end
+
+@implementation GIDAuthorizationRequestTemplateTest {
+  GIDFakeMainBundle *_fakeMainBundle;
+  GIDConfiguration *_configuration;
+}
+
+- (void)setUp {
+  [super setUp];
+  _fakeMainBundle = [[GIDFakeMainBundle alloc] init];
+  [_fakeMainBundle startFakingWithClientID:kClientId];
+  [_fakeMainBundle fakeAllSchemesSupported];
+  _configuration = [[GIDConfiguration alloc] initWithClientID:kClientId
+                                               serverClientID:kServerClientId
+                                                 hostedDomain:kHostedDomain
+                                                  openIDRealm:nil];
+}
+
+- (void)tearDown {
+  [_fakeMainBundle stopFaking];
+  [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (GIDSignInInternalOptions *)optionsWithLoginHint:(NSString *)loginHint {
+  return [GIDSignInInternalOptions defaultOptionsWithConfiguration:_configuration
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+                                          presentingViewController:nil
+#elif TARGET_OS_OSX
+                                                  presentingWindow:nil
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+                                                         loginHint:loginHint
+                                                     addScopesFlow:NO
+                                                        completion:nil];
+}
+
+#pragma mark - Tests
+
+- (void)testRedirectURL {
+  GIDAuthorizationRequestTemplate *template =
+      [[GIDAuthorizationRequestTemplate alloc] initWithConfiguration:_configuration
+                                                        callbackPath:kCallbackPath];
+  XCTAssertEqualObjects(template.redirectURL.absoluteString, @"fakeclientid:/oauth2callback");
+  XCTAssertEqual(template.unsupportedSchemes.count, 0u);
+}
+
+- (void)testUnsupportedSchemes {
+  [_fakeMainBundle fakeMissingAllSchemes];
+  GIDAuthorizationRequestTemplate *template =
+      [[GIDAuthorizationRequestTemplate alloc] initWithConfiguration:_configuration
+                                                        callbackPath:kCallbackPath];
+  XCTAssertEqualObjects(template.unsupportedSchemes, @[ @"fakeclientid" ]);
+}
+
+- (void)testAdditionalParameters {
+  GIDAuthorizationRequestTemplate *template =
+      [[GIDAuthorizationRequestTemplate alloc] initWithConfiguration:_configuration
+                                                        callbackPath:kCallbackPath];
+  NSDictionary<NSString *, NSString *> *parameters =
+      [template additionalParametersWithOptions:[self optionsWithLoginHint:@"hint"]
+                                     emmSupport:nil];
+  XCTAssertEqualObjects(parameters[@"include_granted_scopes"], @"true");
+  XCTAssertEqualObjects(parameters[@"audience"], kServerClientId);
+  XCTAssertEqualObjects(parameters[@"hd"], kHostedDomain);
+  XCTAssertEqualObjects(parameters[@"login_hint"], @"hint");
+  XCTAssertNil(parameters[@"claims"]);
+  XCTAssertEqualObjects(parameters[kSDKVersionLoggingParameter], GIDVersion());
+  XCTAssertEqualObjects(parameters[kEnvironmentLoggingParameter], GIDEnvironment());
+}
+
+- (void)testAdditionalParameters_doNotLeakBetweenRequests {
+  GIDAuthorizationRequestTemplate *template =
+      [[GIDAuthorizationRequestTemplate alloc] initWithConfiguration:_configuration
+                                                        callbackPath:kCallbackPath];
+  NSMutableDictionary *first =
+      [template additionalParametersWithOptions:[self optionsWithLoginHint:@"hint"]
+                                     emmSupport:nil];
+  first[@"client_assertion"] = @"token";
+  NSDictionary *second =
+      [template additionalParametersWithOptions:[self optionsWithLoginHint:nil]
+                                     emmSupport:nil];
+  XCTAssertNil(second[@"login_hint"]);
+  XCTAssertNil(second[@"client_assertion"]);
+}
+
+- (void)testIsValidForConfiguration {
+  GIDAuthorizationRequestTemplate *template =
+      [[GIDAuthorizationRequestTemplate alloc] initWithConfiguration:_configuration
+                                                        callbackPath:kCallbackPath];
+  GIDConfiguration *equalConfiguration =
+      [[GIDConfiguration alloc] initWithClientID:kClientId
+                                  serverClientID:kServerClientId
+                                    hostedDomain:kHostedDomain
+                                     openIDRealm:@"realm"];
+  GIDConfiguration *otherConfiguration = [[GIDConfiguration alloc] initWithClientID:kClientId];
+
+  XCTAssertTrue([template isValidForConfiguration:_configuration]);
+  XCTAssertTrue([template isValidForConfiguration:equalConfiguration]);
+  XCTAssertFalse([template isValidForConfiguration:otherConfiguration]);
+  XCTAssertFalse([template isValidForConfiguration:nil]);
+}
+
+- (void)testIsValidForConfiguration_registeredSchemesChanged {
+  GIDAuthorizationRequestTemplate *template =
+      [[GIDAuthorizationRequestTemplate alloc] initWithConfiguration:_configuration
+                                                        callbackPath:kCallbackPath];
+  XCTAssertEqual(template.unsupportedSchemes.count, 0u);
+
+  // Faking a new Info.plist invalidates the registered schemes, so the template must be rebuilt.
+  [_fakeMainBundle fakeMissingAllSchemes];
+  XCTAssertFalse([template isValidForConfiguration:_configuration]);
+  GIDAuthorizationRequestTemplate *rebuiltTemplate =
+      [[GIDAuthorizationRequestTemplate alloc] initWithConfiguration:_configuration
+                                                        callbackPath:kCallbackPath];
+  XCTAssertEqualObjects(rebuiltTemplate.unsupportedSchemes, @[ @"fakeclientid" ]);
+  XCTAssertTrue([rebuiltTemplate isValidForConfiguration:_configuration]);
+}
+
+@end
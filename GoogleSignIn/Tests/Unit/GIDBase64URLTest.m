@@ -0,0 +1,58 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/NSData+GIDBase64URL.h"
+
+@interface GIDBase64URLTest : XCTestCase
+@end
+
+@implementation GIDBase64URLTest
+
+// Returns the Foundation base64 encoding with the URL-safe substitutions applied afterwards.
+- (NSString *)referenceEncodingOfData:(NSData *)data {
+  NSString *string = [data base64EncodedStringWithOptions:0];
+  string = [string stringByReplacingOccurrencesOfString:@"/" withString:@"_"];
+  return [string stringByReplacingOccurrencesOfString:@"+" withString:@"-"];
+}
+
+- (void)testEncoding_empty {
+  XCTAssertEqualObjects([[NSData data] gid_base64URLEncodedString], @"");
+}
+
+- (void)testEncoding_emptyJSONObject {
+  NSData *data = [@"{}" dataUsingEncoding:NSUTF8StringEncoding];
+  XCTAssertEqualObjects([data gid_base64URLEncodedString], @"e30=");
+}
+
+- (void)testEncoding_usesURLSafeAlphabet {
+  const uint8_t bytes[] = { 0xFB, 0xFF, 0xBF };
+  NSData *data = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+  XCTAssertEqualObjects([data gid_base64URLEncodedString], @"-_-_");
+}
+
+- (void)testEncoding_matchesFoundationForAllPaddingLengths {
+  uint8_t bytes[256];
+  for (NSUInteger i = 0; i < sizeof(bytes); i++) {
+    bytes[i] = (uint8_t)(255 - i);
+  }
+  for (NSUInteger length = 0; length <= sizeof(bytes); length++) {
+    NSData *data = [NSData dataWithBytes:bytes length:length];
+    XCTAssertEqualObjects([data gid_base64URLEncodedString], [self referenceEncodingOfData:data],
+                          @"Mismatch for length %lu", (unsigned long)length);
+  }
+}
+
+@end
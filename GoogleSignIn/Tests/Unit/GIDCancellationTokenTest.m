@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDCancellationToken.h"
+
+#import "GoogleSignIn/Sources/GIDCancellationToken_Private.h"
+
+@interface GIDCancellationTokenTest : XCTestCase
+@end
+
+@implementation GIDCancellationTokenTest
+
+- (void)testCancel {
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  __block NSUInteger handlerCount = 0;
+  [cancellationToken addCancellationHandler:^{
+    handlerCount++;
+  }];
+  [cancellationToken addCancellationHandler:^{
+    handlerCount++;
+  }];
+  XCTAssertFalse(cancellationToken.isCancelled);
+  XCTAssertEqual(handlerCount, 0);
+
+  [cancellationToken cancel];
+
+  XCTAssertTrue(cancellationToken.isCancelled);
+  XCTAssertEqual(handlerCount, 2);
+}
+
+- (void)testCancel_callsHandlersOnce {
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  __block NSUInteger handlerCount = 0;
+  [cancellationToken addCancellationHandler:^{
+    handlerCount++;
+  }];
+
+  [cancellationToken cancel];
+  [cancellationToken cancel];
+
+  XCTAssertEqual(handlerCount, 1);
+}
+
+- (void)testAddCancellationHandler_givenCancelled {
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  [cancellationToken cancel];
+  __block BOOL handlerCalled = NO;
+
+  [cancellationToken addCancellationHandler:^{
+    handlerCalled = YES;
+  }];
+
+  XCTAssertTrue(handlerCalled);
+}
+
+- (void)testRemoveCancellationHandler {
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  __block NSUInteger handlerCount = 0;
+  id<NSObject> registration = [cancellationToken addCancellationHandler:^{
+    XCTFail(@"A removed handler should not be called");
+  }];
+  [cancellationToken addCancellationHandler:^{
+    handlerCount++;
+  }];
+
+  [cancellationToken removeCancellationHandler:registration];
+  [cancellationToken removeCancellationHandler:registration];
+  [cancellationToken removeCancellationHandler:nil];
+  [cancellationToken cancel];
+
+  XCTAssertEqual(handlerCount, 1);
+}
+
+- (void)testRemoveCancellationHandler_givenCancelled {
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  __block NSUInteger handlerCount = 0;
+  id<NSObject> registration = [cancellationToken addCancellationHandler:^{
+    handlerCount++;
+  }];
+  [cancellationToken cancel];
+
+  [cancellationToken removeCancellationHandler:registration];
+
+  XCTAssertEqual(handlerCount, 1);
+}
+
+@end
@@ -29,6 +29,9 @@
 // Emulates server returning with data and/or error.
 - (void)didFinishWithData:(NSData *)data error:(NSError *)error;
 
+// Emulates server returning with a response, data and/or error.
+- (void)didFinishWithResponse:(NSURLResponse *)response data:(NSData *)data error:(NSError *)error;
+
 - (instancetype)initWithRequest:(NSURLRequest *)request;
 
 #pragma clang diagnostic push
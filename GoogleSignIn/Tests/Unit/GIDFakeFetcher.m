@@ -20,6 +20,7 @@ typedef void (^FetchCompletionHandler)(NSData *, NSError *);
 @implementation GIDFakeFetcher {
   FetchCompletionHandler _handler;
   NSURL *_requestURL;
+  NSURLResponse *_response;
 }
 
 - (instancetype)initWithRequest:(NSURLRequest *)request {
@@ -65,10 +66,19 @@ typedef void (^FetchCompletionHandler)(NSData *, NSError *);
   return _requestURL;
 }
 
+- (NSURLResponse *)response {
+  return _response;
+}
+
 - (void)didFinishWithData:(NSData *)data error:(NSError *)error {
   FetchCompletionHandler handler = _handler;
   _handler = nil;
   handler(data, error);
 }
 
+- (void)didFinishWithResponse:(NSURLResponse *)response data:(NSData *)data error:(NSError *)error {
+  _response = response;
+  [self didFinishWithData:data error:error];
+}
+
 @end
@@ -14,6 +14,8 @@
 
 #import "GoogleSignIn/Tests/Unit/GIDFakeMainBundle.h"
 
+#import "GoogleSignIn/Sources/GIDSignInCallbackSchemes_Private.h"
+
 #import <GoogleUtilities/GULSwizzler.h>
 #import <GoogleUtilities/GULSwizzler+Unswizzle.h>
 
@@ -60,6 +62,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                                    userInfo:nil];
     }
   }];
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 - (void)stopFaking {
@@ -67,6 +70,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
                      selector:@selector(objectForInfoDictionaryKey:)
               isClassSelector:NO];
   _fakeConfig = nil;
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 #pragma mark - Utilities
@@ -113,6 +117,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       kCFBundleURLSchemesKey : @[ [self reversedClientId] ]
     }
   ];
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 - (void)fakeAllSchemesSupportedAndMerged {
@@ -123,6 +128,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       ]
     },
   ];
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 - (void)fakeAllSchemesSupportedWithCasesMangled {
@@ -133,6 +139,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       kCFBundleURLSchemesKey : @[ caseFlippedReverseClientId ]
     }
   ];
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 - (void)fakeMissingClientIdScheme {
@@ -141,6 +148,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
 
 - (void)fakeMissingAllSchemes {
   _fakeConfig[kCFBundleURLTypesKey] = nil;
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 - (void)fakeOtherSchemes {
@@ -149,6 +157,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       kCFBundleURLSchemesKey : @[ @"junk" ]
     }
   ];
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 - (void)fakeOtherSchemesAndAllSchemes {
@@ -160,6 +169,7 @@ static NSString *const kConfigOpenIDRealmKey = @"GIDOpenIDRealm";
       kCFBundleURLSchemesKey : @[ [self reversedClientId] ]
     }
   ];
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
 }
 
 - (void)fakeWithClientID:(id)clientID
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDGoogleUserRecord.h"
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDProfileData.h"
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDToken.h"
+#import "GoogleSignIn/Tests/Unit/GIDProfileData+Testing.h"
+#import "GoogleSignIn/Tests/Unit/OIDAuthState+Testing.h"
+#import "GoogleSignIn/Tests/Unit/OIDAuthorizationRequest+Testing.h"
+#import "GoogleSignIn/Tests/Unit/OIDTokenResponse+Testing.h"
+
+#ifdef SWIFT_PACKAGE
+@import AppAuth;
+#else
+#import <AppAuth/AppAuth.h>
+#endif
+
+static NSTimeInterval const kRefreshTokenExpiresIn = 3600;
+
+@interface GIDGoogleUserRecordTest : XCTestCase
+@end
+
+@implementation GIDGoogleUserRecordTest {
+  OIDAuthState *_authState;
+  NSDate *_refreshTokenExpirationDate;
+  NSDate *_idTokenExpirationDate;
+  GIDGoogleUserRecord *_record;
+}
+
+- (void)setUp {
+  [super setUp];
+  _authState = [OIDAuthState testInstance];
+  _refreshTokenExpirationDate = [NSDate dateWithTimeIntervalSinceNow:kRefreshTokenExpiresIn];
+  _idTokenExpirationDate =
+      [[OIDIDToken alloc] initWithIDTokenString:_authState.lastTokenResponse.idToken].expiresAt;
+  _record = [[GIDGoogleUserRecord alloc] initWithAuthState:_authState
+                                refreshTokenExpirationDate:_refreshTokenExpirationDate
+                                     idTokenExpirationDate:_idTokenExpirationDate
+                                               profileData:[GIDProfileData testInstance]];
+}
+
+- (void)testRoundTrip {
+  GIDGoogleUserRecord *decoded = [[GIDGoogleUserRecord alloc] initWithData:_record.data];
+  XCTAssertNotNil(decoded);
+  XCTAssertEqualObjects(decoded.data, _record.data);
+  XCTAssertEqualObjects(decoded.profileData, [GIDProfileData testInstance]);
+  XCTAssertEqualObjects(decoded.accessToken.tokenString, kAccessToken);
+  XCTAssertEqualObjects(decoded.accessToken.expirationDate,
+                        _authState.lastTokenResponse.accessTokenExpirationDate);
+  XCTAssertEqualObjects(decoded.refreshToken.tokenString, kRefreshToken);
+  XCTAssertEqualObjects(decoded.refreshToken.expirationDate, _refreshTokenExpirationDate);
+  XCTAssertEqualObjects(decoded.idToken.tokenString, _authState.lastTokenResponse.idToken);
+  XCTAssertEqualObjects(decoded.idToken.expirationDate, _idTokenExpirationDate);
+}
+
+- (void)testAuthStateCanRefresh {
+  GIDGoogleUserRecord *decoded = [[GIDGoogleUserRecord alloc] initWithData:_record.data];
+  OIDAuthState *authState = [decoded authState];
+  OIDAuthorizationRequest *original = _authState.lastAuthorizationResponse.request;
+  OIDAuthorizationRequest *restored = authState.lastAuthorizationResponse.request;
+
+  XCTAssertEqualObjects(restored.clientID, original.clientID);
+  XCTAssertEqualObjects(restored.redirectURL, original.redirectURL);
+  XCTAssertEqualObjects(restored.configuration.tokenEndpoint,
+                        original.configuration.tokenEndpoint);
+  XCTAssertEqualObjects(authState.refreshToken, _authState.refreshToken);
+  XCTAssertEqualObjects(authState.lastTokenResponse.accessToken, kAccessToken);
+  XCTAssertEqualObjects(authState.lastTokenResponse.idToken,
+                        _authState.lastTokenResponse.idToken);
+  XCTAssertEqualObjects(authState.lastTokenResponse.scope, _authState.lastTokenResponse.scope);
+  XCTAssertEqualObjects(authState.lastTokenResponse.request.additionalParameters,
+                        _authState.lastTokenResponse.request.additionalParameters);
+  XCTAssertEqualWithAccuracy(
+      [authState.lastTokenResponse.accessTokenExpirationDate timeIntervalSinceNow],
+      [_authState.lastTokenResponse.accessTokenExpirationDate timeIntervalSinceNow], 1);
+
+  OIDTokenRequest *refreshRequest = [authState tokenRefreshRequest];
+  XCTAssertEqualObjects(refreshRequest.refreshToken, kRefreshToken);
+  XCTAssertEqualObjects(refreshRequest.clientID, OIDAuthorizationRequestTestingClientID);
+}
+
+- (void)testRecordIsSmallerThanKeyedArchive {
+  NSData *archive = [NSKeyedArchiver archivedDataWithRootObject:_authState
+                                          requiringSecureCoding:YES
+                                                          error:nil];
+  XCTAssertLessThan(_record.data.length, archive.length);
+}
+
+- (void)testRejectsNewerVersion {
+  NSMutableData *data = [_record.data mutableCopy];
+  uint8_t version = kGIDGoogleUserRecordVersion + 1;
+  [data replaceBytesInRange:NSMakeRange(4, 1) withBytes:&version];
+  XCTAssertNil([[GIDGoogleUserRecord alloc] initWithData:data]);
+}
+
+- (void)testRejectsMalformedData {
+  XCTAssertNil([[GIDGoogleUserRecord alloc] initWithData:[NSData data]]);
+  XCTAssertNil([[GIDGoogleUserRecord alloc]
+      initWithData:[@"not a record" dataUsingEncoding:NSUTF8StringEncoding]]);
+  NSData *truncated = [_record.data subdataWithRange:NSMakeRange(0, _record.data.length - 1)];
+  XCTAssertNil([[GIDGoogleUserRecord alloc] initWithData:truncated]);
+}
+
+- (void)testSkipsUnknownFields {
+  NSMutableData *data = [_record.data mutableCopy];
+  // A string field with a tag from a later version.
+  const uint8_t unknownField[] = {63, 3, 0, 0, 0, 'n', 'e', 'w'};
+  [data appendBytes:unknownField length:sizeof(unknownField)];
+  GIDGoogleUserRecord *decoded = [[GIDGoogleUserRecord alloc] initWithData:data];
+  XCTAssertNotNil(decoded);
+  XCTAssertEqualObjects(decoded.accessToken.tokenString, kAccessToken);
+}
+
+- (void)testKeepsUnknownFieldsThisVersionCannotParse {
+  NSMutableData *data = [_record.data mutableCopy];
+  // Fields from a later version whose values aren't UTF-8, a date or a map.
+  const uint8_t unknownFields[] = {
+    18, 2, 0, 0, 0, 0xFF, 0xFE,
+    67, 1, 0, 0, 0, 0x01,
+    131, 3, 0, 0, 0, 0x05, 0x00, 0x00,
+  };
+  [data appendBytes:unknownFields length:sizeof(unknownFields)];
+  GIDGoogleUserRecord *decoded = [[GIDGoogleUserRecord alloc] initWithData:data];
+  XCTAssertNotNil(decoded);
+  XCTAssertEqualObjects(decoded.accessToken.tokenString, kAccessToken);
+  XCTAssertEqualObjects(decoded.data, data);
+}
+
+@end
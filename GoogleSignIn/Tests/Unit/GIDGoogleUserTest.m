@@ -17,12 +17,14 @@
 #import <XCTest/XCTest.h>
 #import <TargetConditionals.h>
 
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDCancellationToken.h"
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDConfiguration.h"
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDProfileData.h"
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDSignIn.h"
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDToken.h"
 
 #import "GoogleSignIn/Sources/GIDGoogleUser_Private.h"
+#import "GoogleSignIn/Sources/GIDSignIn_Private.h"
 #import "GoogleSignIn/Tests/Unit/GIDGoogleUser+Testing.h"
 #import "GoogleSignIn/Tests/Unit/GIDProfileData+Testing.h"
 #import "GoogleSignIn/Tests/Unit/OIDAuthState+Testing.h"
@@ -166,6 +168,77 @@ static NSString *const kNewScope = @"newScope";
   }
 }
 
+// A decoded user builds its auth state on first use, and encodes its updated state afterwards.
+- (void)testUpdateAfterDecoding {
+  if (@available(iOS 11, macOS 10.13, *)) {
+    GIDGoogleUser *user = [[GIDGoogleUser alloc] initWithAuthState:[OIDAuthState testInstance]
+                                                       profileData:[GIDProfileData testInstance]];
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:user
+                                         requiringSecureCoding:YES
+                                                         error:nil];
+    GIDGoogleUser *decodedUser = [NSKeyedUnarchiver unarchivedObjectOfClass:[GIDGoogleUser class]
+                                                                   fromData:data
+                                                                      error:nil];
+    // Encoding a decoded user that hasn't changed writes the same record back.
+    XCTAssertEqualObjects([NSKeyedArchiver archivedDataWithRootObject:decodedUser
+                                                requiringSecureCoding:YES
+                                                                error:nil], data);
+
+    OIDAuthState *updatedAuthState =
+        [OIDAuthState testInstanceWithIDToken:[self idTokenWithExpiresIn:kNewIDTokenExpiresIn]
+                                  accessToken:kNewAccessToken
+                         accessTokenExpiresIn:kAccessTokenExpiresIn
+                                 refreshToken:kNewRefreshToken];
+    [decodedUser updateWithTokenResponse:updatedAuthState.lastTokenResponse
+                   authorizationResponse:updatedAuthState.lastAuthorizationResponse
+                             profileData:[GIDProfileData testInstance]];
+    XCTAssertEqualObjects(decodedUser.accessToken.tokenString, kNewAccessToken);
+
+    NSData *updatedData = [NSKeyedArchiver archivedDataWithRootObject:decodedUser
+                                                requiringSecureCoding:YES
+                                                                error:nil];
+    GIDGoogleUser *updatedUser =
+        [NSKeyedUnarchiver unarchivedObjectOfClass:[GIDGoogleUser class]
+                                          fromData:updatedData
+                                             error:nil];
+    XCTAssertEqualObjects(updatedUser, decodedUser);
+    XCTAssertEqualObjects(updatedUser.refreshToken.tokenString, kNewRefreshToken);
+  } else {
+    XCTSkip(@"Required API is not available for this test.");
+  }
+}
+
+// A profile set on a decoded user before its auth state is built is encoded, not the record the
+// user was decoded from.
+- (void)testSetProfileAfterDecoding {
+  if (@available(iOS 11, macOS 10.13, *)) {
+    GIDGoogleUser *user = [[GIDGoogleUser alloc] initWithAuthState:[OIDAuthState testInstance]
+                                                       profileData:[GIDProfileData testInstance]];
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:user
+                                         requiringSecureCoding:YES
+                                                         error:nil];
+    GIDGoogleUser *decodedUser = [NSKeyedUnarchiver unarchivedObjectOfClass:[GIDGoogleUser class]
+                                                                   fromData:data
+                                                                      error:nil];
+    GIDProfileData *updatedProfile =
+        [GIDProfileData testInstanceWithImageURL:@"https://example.com/updated.png"];
+    decodedUser.profile = updatedProfile;
+
+    NSData *updatedData = [NSKeyedArchiver archivedDataWithRootObject:decodedUser
+                                                requiringSecureCoding:YES
+                                                                error:nil];
+    GIDGoogleUser *updatedUser =
+        [NSKeyedUnarchiver unarchivedObjectOfClass:[GIDGoogleUser class]
+                                          fromData:updatedData
+                                             error:nil];
+    XCTAssertEqualObjects(updatedUser.profile, updatedProfile);
+    XCTAssertEqualObjects(updatedUser.accessToken.tokenString, user.accessToken.tokenString);
+    XCTAssertEqualObjects(updatedUser.refreshToken.tokenString, user.refreshToken.tokenString);
+  } else {
+    XCTSkip(@"Required API is not available for this test.");
+  }
+}
+
 - (void)testUpdateAuthState {
   GIDGoogleUser *user = [self googleUserWithAccessTokenExpiresIn:kAccessTokenExpiresIn
                                                 idTokenExpiresIn:kIDTokenExpiresIn];
@@ -459,6 +532,71 @@ static NSString *const kNewScope = @"newScope";
   [self waitForExpectationsWithTimeout:1 handler:nil];
 }
 
+- (void)testRefreshTokensIfNeededWithCompletion_cancelledRequestIsNotCalledBack {
+  NSTimeInterval expiresIn = -10;
+  GIDGoogleUser *user = [self googleUserWithAccessTokenExpiresIn:expiresIn
+                                                idTokenExpiresIn:expiresIn];
+  OIDTokenResponse *fakeResponse =
+      [OIDTokenResponse testInstanceWithIDToken:[self idTokenWithExpiresIn:kNewIDTokenExpiresIn]
+                                    accessToken:kNewAccessToken
+                                      expiresIn:@(kAccessTokenExpiresIn)
+                                   refreshToken:kRefreshToken
+                                   tokenRequest:nil];
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  [user refreshTokensIfNeededWithCancellationToken:cancellationToken
+                                        completion:^(GIDGoogleUser *user, NSError *error) {
+    XCTFail(@"A cancelled request should not be called back");
+  }];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback is called"];
+  [user refreshTokensIfNeededWithCompletion:^(GIDGoogleUser *user, NSError *error) {
+    [expectation fulfill];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(user.accessToken.tokenString, kNewAccessToken);
+  }];
+
+  [cancellationToken cancel];
+  _tokenFetchHandler(fakeResponse, nil);
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testRefreshTokensIfNeededWithCompletion_abandonedRefreshResponseIsApplied {
+  NSTimeInterval expiresIn = -10;
+  GIDGoogleUser *user = [self googleUserWithAccessTokenExpiresIn:expiresIn
+                                                idTokenExpiresIn:expiresIn];
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  [user refreshTokensIfNeededWithCancellationToken:cancellationToken
+                                        completion:^(GIDGoogleUser *user, NSError *error) {
+    XCTFail(@"A cancelled request should not be called back");
+  }];
+  OIDTokenCallback abandonedTokenFetchHandler = _tokenFetchHandler;
+  [cancellationToken cancel];
+
+  // Over-fulfilling fails the test, so the abandoned response doesn't call back this request.
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback is called"];
+  [user refreshTokensIfNeededWithCompletion:^(GIDGoogleUser *user, NSError *error) {
+    [expectation fulfill];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(user.accessToken.tokenString, kNewAccessToken);
+  }];
+  // A new token request is started for the new request.
+  XCTAssertNotEqual(_tokenFetchHandler, abandonedTokenFetchHandler);
+
+  OIDTokenResponse *fakeResponse =
+      [OIDTokenResponse testInstanceWithIDToken:[self idTokenWithExpiresIn:kNewIDTokenExpiresIn]
+                                    accessToken:kNewAccessToken
+                                      expiresIn:@(kAccessTokenExpiresIn)
+                                   refreshToken:kRefreshToken
+                                   tokenRequest:nil];
+  // The abandoned response still updates the user's tokens.
+  abandonedTokenFetchHandler(fakeResponse, nil);
+  XCTAssertEqualObjects(user.accessToken.tokenString, kNewAccessToken);
+  [self verifyUser:user accessTokenExpiresIn:kAccessTokenExpiresIn];
+  _tokenFetchHandler(fakeResponse, nil);
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
 - (void)testRefreshTokensIfNeededWithCompletion_noRefresh_givenRefreshTokenExpired {
   NSTimeInterval expiresIn = -10;
   GIDGoogleUser *user = [self googleUserWithAccessTokenExpiresIn:expiresIn
@@ -478,6 +616,90 @@ static NSString *const kNewScope = @"newScope";
   [self waitForExpectationsWithTimeout:1 handler:nil];
 }
 
+#pragma mark - Test `loadProfileWithCompletion:`
+
+- (void)testLoadProfileWithCompletion_noFetch_givenProfile {
+  id signIn = OCMClassMock([GIDSignIn class]);
+  OCMStub([signIn sharedInstance]).andReturn(signIn);
+  [[signIn reject] fetchProfileDataWithAuthState:OCMOCK_ANY
+                                         idToken:OCMOCK_ANY
+                                      completion:OCMOCK_ANY];
+  GIDProfileData *profileData = [GIDProfileData testInstance];
+  GIDGoogleUser *user = [[GIDGoogleUser alloc] initWithAuthState:[OIDAuthState testInstance]
+                                                     profileData:profileData];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Completion is called."];
+
+  [user loadProfileWithCompletion:^(GIDProfileData *_Nullable profile, NSError *_Nullable error) {
+    [expectation fulfill];
+    XCTAssertEqual(profile, profileData);
+    XCTAssertNil(error);
+  }];
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  [signIn verify];
+  [signIn stopMocking];
+}
+
+- (void)testLoadProfileWithCompletion_fetchesOnce_givenNoProfile {
+  id signIn = OCMClassMock([GIDSignIn class]);
+  OCMStub([signIn sharedInstance]).andReturn(signIn);
+  __block NSUInteger fetchCount = 0;
+  __block void (^fetchCompletion)(GIDProfileData *, NSError *);
+  OCMStub([signIn fetchProfileDataWithAuthState:OCMOCK_ANY
+                                        idToken:OCMOCK_ANY
+                                     completion:OCMOCK_ANY]).andDo(^(NSInvocation *invocation) {
+    fetchCount++;
+    __unsafe_unretained void (^completion)(GIDProfileData *, NSError *);
+    [invocation getArgument:&completion atIndex:4];
+    fetchCompletion = [completion copy];
+  });
+  GIDGoogleUser *user = [self googleUserWithAccessTokenExpiresIn:kAccessTokenExpiresIn
+                                                idTokenExpiresIn:kIDTokenExpiresIn];
+  GIDProfileData *profileData = [GIDProfileData testInstance];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Completion is called."];
+  XCTestExpectation *otherExpectation =
+      [self expectationWithDescription:@"Other completion is called."];
+
+  [user loadProfileWithCompletion:^(GIDProfileData *_Nullable profile, NSError *_Nullable error) {
+    [expectation fulfill];
+    XCTAssertEqual(profile, profileData);
+  }];
+  [user loadProfileWithCompletion:^(GIDProfileData *_Nullable profile, NSError *_Nullable error) {
+    [otherExpectation fulfill];
+    XCTAssertEqual(profile, profileData);
+  }];
+  XCTAssertEqual(fetchCount, 1);
+  XCTAssertNil(user.profile);
+  fetchCompletion(profileData, nil);
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertEqual(user.profile, profileData);
+  [signIn stopMocking];
+}
+
+- (void)testLoadProfileWithCompletion_fetchError {
+  id signIn = OCMClassMock([GIDSignIn class]);
+  OCMStub([signIn sharedInstance]).andReturn(signIn);
+  NSError *fetchError = [NSError errorWithDomain:@"test" code:-1 userInfo:nil];
+  OCMStub([signIn fetchProfileDataWithAuthState:OCMOCK_ANY
+                                        idToken:OCMOCK_ANY
+                                     completion:([OCMArg invokeBlockWithArgs:[NSNull null],
+                                                                             fetchError, nil])]);
+  GIDGoogleUser *user = [self googleUserWithAccessTokenExpiresIn:kAccessTokenExpiresIn
+                                                idTokenExpiresIn:kIDTokenExpiresIn];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Completion is called."];
+
+  [user loadProfileWithCompletion:^(GIDProfileData *_Nullable profile, NSError *_Nullable error) {
+    [expectation fulfill];
+    XCTAssertNil(profile);
+    XCTAssertEqual(error, fetchError);
+  }];
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertNil(user.profile);
+  [signIn stopMocking];
+}
+
 # pragma mark - Test `addScopes:`
 
 - (void)testAddScopes_success {
@@ -489,6 +711,7 @@ static NSString *const kNewScope = @"newScope";
 #elif TARGET_OS_OSX
               presentingWindow:OCMOCK_ANY
 #endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+             cancellationToken:OCMOCK_ANY
                     completion:OCMOCK_ANY];
   
   GIDGoogleUser *currentUser = [self googleUserWithAccessTokenExpiresIn:kAccessTokenExpiresIn
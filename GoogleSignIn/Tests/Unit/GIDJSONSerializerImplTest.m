@@ -0,0 +1,116 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDJSONSerializer/Implementation/GIDJSONSerializerImpl.h"
+#import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDSignIn.h"
+
+@interface GIDJSONSerializerImplTest : XCTestCase
+@end
+
+@implementation GIDJSONSerializerImplTest {
+  GIDJSONSerializerImpl *_serializer;
+}
+
+- (void)setUp {
+  [super setUp];
+  _serializer = [[GIDJSONSerializerImpl alloc] init];
+}
+
+#pragma mark - Helpers
+
+// Returns the `NSJSONSerialization` output for `object`, which the serializer must match.
+- (NSString *)referenceStringWithJSONObject:(NSDictionary *)object {
+  NSData *data = [NSJSONSerialization dataWithJSONObject:object options:0 error:NULL];
+  return [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+}
+
+// A dictionary shaped like the claims request built by `GIDClaimsInternalOptions`.
+- (NSDictionary *)claimsObject {
+  return @{ @"id_token" : @{ @"auth_time" : @{ @"essential" : @YES } } };
+}
+
+#pragma mark - Formatting
+
+- (void)testStringWithJSONObject_claims {
+  NSError *error;
+  NSString *result = [_serializer stringWithJSONObject:[self claimsObject] error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(result, @"{\"id_token\":{\"auth_time\":{\"essential\":true}}}");
+}
+
+- (void)testStringWithJSONObject_matchesNSJSONSerialization {
+  NSDictionary *object = @{
+    @"string" : @"plain",
+    @"escaped" : @"quote\" backslash\\ slash/ newline\n tab\t bell\a",
+    @"unicode" : @"café 日本 \U0001F600",
+    @"empty" : @"",
+    @"true" : @YES,
+    @"false" : @NO,
+    @"int" : @(-42),
+    @"unsigned" : @(UINT64_MAX),
+    @"double" : @(0.1),
+    @"float" : @(0.1f),
+    @"largeDouble" : @(1e20),
+    @"smallDouble" : @(-1.5e-7),
+    @"null" : [NSNull null],
+    @"array" : @[ @1, @"two", @[], @{} ],
+    @"nested" : @{ @"result" : @(-34018), @"error_domain" : @"com.apple.LocalAuthentication" },
+  };
+  for (NSString *key in object) {
+    NSDictionary *single = @{ key : object[key] };
+    XCTAssertEqualObjects([_serializer stringWithJSONObject:single error:NULL],
+                          [self referenceStringWithJSONObject:single],
+                          @"Mismatch for key %@", key);
+  }
+}
+
+- (void)testDataWithJSONObject_matchesString {
+  NSData *data = [_serializer dataWithJSONObject:[self claimsObject] error:NULL];
+  NSString *string = [_serializer stringWithJSONObject:[self claimsObject] error:NULL];
+  XCTAssertEqualObjects([[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding], string);
+}
+
+- (void)testStringWithJSONObject_emptyDictionary {
+  XCTAssertEqualObjects([_serializer stringWithJSONObject:@{} error:NULL], @"{}");
+}
+
+#pragma mark - Errors
+
+- (void)testStringWithJSONObject_unsupportedValue_returnsError {
+  NSError *error;
+  NSString *result = [_serializer stringWithJSONObject:@{ @"date" : [NSDate date] } error:&error];
+  XCTAssertNil(result);
+  XCTAssertEqualObjects(error.domain, kGIDSignInErrorDomain);
+  XCTAssertEqual(error.code, kGIDSignInErrorCodeJSONSerializationFailure);
+  XCTAssertEqualObjects(error.localizedDescription, kGIDJSONSerializationErrorDescription);
+  NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+  XCTAssertEqualObjects(underlyingError.domain, NSCocoaErrorDomain);
+  XCTAssertEqual(underlyingError.code, NSPropertyListWriteInvalidError);
+}
+
+- (void)testStringWithJSONObject_nonStringKey_returnsError {
+  NSError *error;
+  XCTAssertNil([_serializer stringWithJSONObject:(NSDictionary *)@{ @1 : @"one" } error:&error]);
+  XCTAssertEqual(error.code, kGIDSignInErrorCodeJSONSerializationFailure);
+}
+
+- (void)testStringWithJSONObject_nonFiniteNumber_returnsError {
+  NSError *error;
+  XCTAssertNil([_serializer stringWithJSONObject:@{ @"nan" : @(NAN) } error:&error]);
+  XCTAssertEqual(error.code, kGIDSignInErrorCodeJSONSerializationFailure);
+}
+
+@end
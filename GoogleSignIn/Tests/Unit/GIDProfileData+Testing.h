@@ -24,10 +24,6 @@ extern NSString *const kImageURL;
 
 @interface GIDProfileData (Testing)
 
-- (BOOL)isEqual:(id)object;
-- (BOOL)isEqualToProfileData:(GIDProfileData *)other;
-- (NSUInteger)hash;
-
 + (instancetype)testInstance;
 
 + (instancetype)testInstanceWithImageURL:(NSString *)imageURL;
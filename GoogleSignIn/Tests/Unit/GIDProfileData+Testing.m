@@ -24,35 +24,6 @@ NSString *const kImageURL = @"http://no.domain/empty";
 
 @implementation GIDProfileData (Testing)
 
-- (BOOL)isEqual:(id)object {
-  if (self == object) {
-    return YES;
-  }
-  if (![object isKindOfClass:[GIDProfileData class]]) {
-    return NO;
-  }
-  return [self isEqualToProfileData:(GIDProfileData *)object];
-}
-
-- (BOOL)isEqualToProfileData:(GIDProfileData *)other {
-  return [self.email isEqual:other.email] &&
-      [self.name isEqual:other.name] &&
-      [self.givenName isEqual:other.givenName] &&
-      [self.familyName isEqual:other.familyName] &&
-      // Not something you want to use in production. Should compare _imageURL instead.
-      [[self imageURLWithDimension:0].absoluteString isEqual:
-          [other imageURLWithDimension:0].absoluteString];
-}
-
-// Not the hash implemention you want to use on prod, but just to match |isEqual:| here.
-- (NSUInteger)hash {
-  return [self.email hash] ^
-      [self.name hash] ^
-      [self.givenName hash] ^
-      [self.familyName hash] ^
-      [[self imageURLWithDimension:0] hash];
-}
-
 + (instancetype)testInstance {
   return [self testInstanceWithImageURL:kImageURL];
 }
@@ -16,6 +16,7 @@
 
 #import "GoogleSignIn/Sources/Public/GoogleSignIn/GIDProfileData.h"
 
+#import "GoogleSignIn/Sources/GIDProfileData_Private.h"
 #import "GoogleSignIn/Tests/Unit/GIDProfileData+Testing.h"
 
 static const NSUInteger kDimension = 100;
@@ -92,6 +93,19 @@ static NSString *const kFIFEAvatarURL2WithDimension =
   XCTAssertTrue(profileData.hasImage);
 }
 
+- (void)testEquality {
+  GIDProfileData *profileData = [self profileData];
+  XCTAssertEqualObjects(profileData, [self profileData]);
+  XCTAssertEqual(profileData.hash, [self profileData].hash);
+  XCTAssertNotEqualObjects(profileData, [self profileDataWithImageURL:kFIFEAvatarURL]);
+  GIDProfileData *withoutGivenName = [[GIDProfileData alloc] initWithEmail:kEmail
+                                                                      name:kName
+                                                                 givenName:nil
+                                                                familyName:kFamilyName
+                                                                  imageURL:nil];
+  XCTAssertNotEqualObjects(profileData, withoutGivenName);
+}
+
 - (void)testCoding {
   if (@available(iOS 11, macOS 10.13, *)) {
     GIDProfileData *profileData = [self profileData];
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <TargetConditionals.h>
+
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDSignInButtonImages.h"
+
+@interface GIDSignInButtonImagesTest : XCTestCase
+@end
+
+@implementation GIDSignInButtonImagesTest
+
+- (void)testGoogleIconIsCached {
+  UIImage *icon = [GIDSignInButtonImages googleIconForScale:2 disabled:NO];
+  XCTAssertNotNil(icon);
+  XCTAssertEqual(icon.scale, 2);
+  XCTAssertEqual([GIDSignInButtonImages googleIconForScale:2 disabled:NO], icon);
+}
+
+- (void)testDisabledGoogleIconIsCachedSeparately {
+  UIImage *icon = [GIDSignInButtonImages googleIconForScale:3 disabled:NO];
+  UIImage *disabledIcon = [GIDSignInButtonImages googleIconForScale:3 disabled:YES];
+  XCTAssertNotNil(disabledIcon);
+  XCTAssertNotEqual(disabledIcon, icon);
+  XCTAssertEqual(disabledIcon.scale, icon.scale);
+  XCTAssertTrue(CGSizeEqualToSize(disabledIcon.size, icon.size));
+  XCTAssertEqual([GIDSignInButtonImages googleIconForScale:3 disabled:YES], disabledIcon);
+}
+
+- (void)testConcurrentAccessReturnsSameIcon {
+  UIImage *icon = [GIDSignInButtonImages googleIconForScale:2 disabled:YES];
+  dispatch_apply(16, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+    XCTAssertEqual([GIDSignInButtonImages googleIconForScale:2 disabled:YES], icon);
+  });
+}
+
+@end
+
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
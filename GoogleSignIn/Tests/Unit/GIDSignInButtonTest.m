@@ -90,19 +90,19 @@ static NSString * const kAppBundleId = @"FakeBundleID";
 - (void)testSetStyle {
   GIDSignInButton *button = [[GIDSignInButton alloc] init];
   id buttonMock = OCMPartialMock(button);
-  [[buttonMock expect] setNeedsDisplay];
+  [[buttonMock expect] setNeedsLayout];
 
   button.style = kGIDSignInButtonStyleWide;
   [buttonMock verify];
   XCTAssertEqual(button.style, kGIDSignInButtonStyleWide);
 
-  [[buttonMock expect] setNeedsDisplay];
+  [[buttonMock expect] setNeedsLayout];
 
   button.style = kGIDSignInButtonStyleIconOnly;
   [buttonMock verify];
   XCTAssertEqual(button.style, kGIDSignInButtonStyleIconOnly);
 
-  [[buttonMock expect] setNeedsDisplay];
+  [[buttonMock expect] setNeedsLayout];
 
   button.style = kGIDSignInButtonStyleStandard;
   [buttonMock verify];
@@ -114,20 +114,64 @@ static NSString * const kAppBundleId = @"FakeBundleID";
   id buttonMock = OCMPartialMock(button);
   // Checks default value for |button.enabled|
   XCTAssertTrue(button.enabled, @"Button should be default enabled");
-  // Checks that button redraw when enabled set YES.
-  [[buttonMock expect] setNeedsDisplay];
+  // Checks that button relayouts when enabled set NO.
+  [[buttonMock expect] setNeedsLayout];
   button.enabled = NO;
   [buttonMock verify];
   // Checks nothing happen if setting same value.
   button.enabled = NO;
-  // Checks that button redraw when enabled set YES.
-  [[buttonMock expect] setNeedsDisplay];
+  // Checks that button relayouts when enabled set YES.
+  [[buttonMock expect] setNeedsLayout];
   button.enabled = YES;
   [buttonMock verify];
   // Checks nothing happen if setting same value.
   button.enabled = YES;
 }
 
+// Verify that touch transitions swap the pre-rendered background instead of redrawing.
+- (void)testTouchTransitionsDoNotRedraw {
+  GIDSignInButton *button = [[GIDSignInButton alloc] init];
+  id buttonMock = OCMPartialMock(button);
+  [[buttonMock reject] setNeedsDisplay];
+  [button sendActionsForControlEvents:UIControlEventTouchDown];
+  [button sendActionsForControlEvents:UIControlEventTouchUpInside];
+  [buttonMock verify];
+}
+
+// Verify that a locale change posted off the main thread updates buttons on the main thread.
+- (void)testLocaleChangeUpdatesButtonsOnMainThread {
+  GIDSignInButton *button = [[GIDSignInButton alloc] init];
+  id buttonMock = OCMPartialMock(button);
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Button updated"];
+  [[[buttonMock expect] andDo:^(NSInvocation *invocation) {
+    XCTAssertTrue([NSThread isMainThread]);
+    [expectation fulfill];
+  }] updateUI];
+
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+    [[NSNotificationCenter defaultCenter] postNotificationName:NSCurrentLocaleDidChangeNotification
+                                                        object:nil];
+  });
+  [self waitForExpectations:@[ expectation ] timeout:5];
+  [buttonMock verify];
+}
+
+// Verify that prefetching registers the button font without blocking the caller.
+- (void)testPrefetchResourcesRegistersFont {
+  [GIDSignInButton prefetchResources];
+  NSPredicate *registered =
+      [NSPredicate predicateWithBlock:^BOOL(id object, NSDictionary *bindings) {
+        return [UIFont fontWithName:@"Roboto-Bold" size:14] != nil;
+      }];
+  XCTNSPredicateExpectation *expectation =
+      [[XCTNSPredicateExpectation alloc] initWithPredicate:registered object:nil];
+  [self waitForExpectations:@[ expectation ] timeout:5];
+
+  // Buttons created afterwards pick up the registered font.
+  GIDSignInButton *button = [[GIDSignInButton alloc] init];
+  XCTAssertNotNil(button);
+}
+
 - (void)testWidthAndHeightConstraintAddition {
   GIDSignInButton *button = [[GIDSignInButton alloc] init];
   XCTAssertEqual([button.constraints count], 0u);
@@ -138,6 +182,36 @@ static NSString * const kAppBundleId = @"FakeBundleID";
   XCTAssertEqual([button.constraints count], 2u);
 }
 
+- (void)testConstraintsAreUpdatedInPlace {
+  GIDSignInButton *button = [[GIDSignInButton alloc] init];
+  [button updateConstraints];
+  NSLayoutConstraint *widthConstraint = [self constraintWithIdentifier:kWidthConstraintIdentifier
+                                                              inButton:button];
+  NSLayoutConstraint *heightConstraint = [self constraintWithIdentifier:kHeightConstraintIdentifier
+                                                               inButton:button];
+  CGFloat standardWidth = widthConstraint.constant;
+
+  // Changing the text updates the existing width constraint.
+  button.style = kGIDSignInButtonStyleWide;
+  [button updateConstraints];
+  XCTAssertEqual([button.constraints count], 2u);
+  XCTAssertEqual([self constraintWithIdentifier:kWidthConstraintIdentifier inButton:button],
+                 widthConstraint);
+  XCTAssertEqual([self constraintWithIdentifier:kHeightConstraintIdentifier inButton:button],
+                 heightConstraint);
+  XCTAssertGreaterThan(widthConstraint.constant, standardWidth);
+
+  // The icon style needs a fixed width, which requires a new constraint.
+  button.style = kGIDSignInButtonStyleIconOnly;
+  [button updateConstraints];
+  XCTAssertEqual([button.constraints count], 2u);
+  NSLayoutConstraint *iconWidthConstraint =
+      [self constraintWithIdentifier:kWidthConstraintIdentifier inButton:button];
+  XCTAssertEqual(iconWidthConstraint.relation, NSLayoutRelationEqual);
+  XCTAssertEqual([self constraintWithIdentifier:kHeightConstraintIdentifier inButton:button],
+                 heightConstraint);
+}
+
 - (void)testHeightConstraintReplacement {
   GIDSignInButton *button = [[GIDSignInButton alloc] init];
   [button addConstraint:[NSLayoutConstraint constraintWithItem:button
@@ -212,6 +286,18 @@ static NSString * const kAppBundleId = @"FakeBundleID";
   XCTAssertTrue([button.constraints containsObject:heightConstraint]);
 }
 
+#pragma mark - Helpers
+
+- (nullable NSLayoutConstraint *)constraintWithIdentifier:(NSString *)identifier
+                                                 inButton:(GIDSignInButton *)button {
+  for (NSLayoutConstraint *constraint in button.constraints) {
+    if ([constraint.identifier isEqualToString:identifier]) {
+      return constraint;
+    }
+  }
+  return nil;
+}
+
 @end
 
 #endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
@@ -14,7 +14,7 @@
 
 #import <XCTest/XCTest.h>
 
-#import "GoogleSignIn/Sources/GIDSignInCallbackSchemes.h"
+#import "GoogleSignIn/Sources/GIDSignInCallbackSchemes_Private.h"
 #import "GoogleSignIn/Tests/Unit/GIDFakeMainBundle.h"
 
 static NSString *const kClientId = @"FakeClientID";
@@ -97,6 +97,27 @@ static NSString *const kClientId = @"FakeClientID";
 
   XCTAssert([schemes URLSchemeIsCallbackScheme:clientIdentifierURL]);
   XCTAssertFalse([schemes URLSchemeIsCallbackScheme:junkIdentifierURL]);
+  XCTAssertFalse([schemes URLSchemeIsCallbackScheme:[NSURL URLWithString:@"/relative"]]);
+}
+
+- (void)testRegisteredURLSchemes_areCachedUntilInvalidated {
+  [_fakeMainBundle fakeOtherSchemesAndAllSchemes];
+  NSSet<NSString *> *registeredURLSchemes = [GIDSignInCallbackSchemes registeredURLSchemes];
+  XCTAssertEqualObjects(registeredURLSchemes,
+                        ([NSSet setWithObjects:@"junk", kClientId.lowercaseString, nil]));
+  XCTAssertEqual([GIDSignInCallbackSchemes registeredURLSchemes], registeredURLSchemes);
+
+  [GIDSignInCallbackSchemes invalidateRegisteredURLSchemes];
+  XCTAssertNotEqual([GIDSignInCallbackSchemes registeredURLSchemes], registeredURLSchemes);
+}
+
+- (void)testIsRegisteredURLScheme {
+  [_fakeMainBundle fakeAllSchemesSupported];
+
+  XCTAssertTrue([GIDSignInCallbackSchemes isRegisteredURLScheme:kClientId.lowercaseString]);
+  XCTAssertTrue([GIDSignInCallbackSchemes isRegisteredURLScheme:kClientId]);
+  XCTAssertFalse([GIDSignInCallbackSchemes isRegisteredURLScheme:@"junk"]);
+  XCTAssertFalse([GIDSignInCallbackSchemes isRegisteredURLScheme:nil]);
 }
 
 @end
@@ -122,4 +122,62 @@
   XCTAssertEqual(options.completion, completion);
 }
 
+- (void)testFlowOptions_continuationCarriesOnOriginalFlow {
+  GIDSignInInternalOptions *options = [GIDSignInInternalOptions silentOptionsWithCompletion:
+      ^(GIDSignInResult *_Nullable signInResult, NSError * _Nullable error) {}];
+  GIDSignInInternalOptions *continuation =
+      [options optionsWithExtraParameters:@{} forContinuation:YES];
+
+  XCTAssertEqual(options.flowOptions, options);
+  XCTAssertEqual(continuation.flowOptions, options);
+  XCTAssertEqual([continuation optionsWithExtraParameters:@{} forContinuation:YES].flowOptions,
+                 options);
+  GIDSignInInternalOptions *newFlowOptions =
+      [continuation optionsWithExtraParameters:@{} forContinuation:NO];
+  XCTAssertEqual(newFlowOptions.flowOptions, newFlowOptions);
+}
+
+- (void)testIsEquivalentToOptions_silentOptions {
+  GIDSignInInternalOptions *options = [GIDSignInInternalOptions silentOptionsWithCompletion:
+      ^(GIDSignInResult *_Nullable signInResult, NSError * _Nullable error) {}];
+  GIDSignInInternalOptions *otherOptions = [GIDSignInInternalOptions silentOptionsWithCompletion:
+      ^(GIDSignInResult *_Nullable signInResult, NSError * _Nullable error) {}];
+
+  XCTAssertTrue([options isEquivalentToOptions:otherOptions]);
+  XCTAssertFalse([options isEquivalentToOptions:
+      [otherOptions optionsWithExtraParameters:@{} forContinuation:YES]]);
+}
+
+- (void)testIsEquivalentToOptions_interactiveOptions {
+  id configuration = OCMStrictClassMock([GIDConfiguration class]);
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  id presentingViewController = OCMStrictClassMock([UIViewController class]);
+#elif TARGET_OS_OSX
+  id presentingWindow = OCMStrictClassMock([NSWindow class]);
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  GIDSignInInternalOptions *(^optionsWithHint)(NSString *) = ^(NSString *loginHint) {
+    return [GIDSignInInternalOptions defaultOptionsWithConfiguration:configuration
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+                                            presentingViewController:presentingViewController
+#elif TARGET_OS_OSX
+                                                    presentingWindow:presentingWindow
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+                                                           loginHint:loginHint
+                                                       addScopesFlow:NO
+                                                              scopes:@[@"scope"]
+                                                               nonce:nil
+                                                              claims:nil
+                                                          completion:
+        ^(GIDSignInResult *_Nullable signInResult, NSError * _Nullable error) {}];
+  };
+  GIDSignInInternalOptions *options = optionsWithHint(@"login_hint");
+
+  XCTAssertTrue([options isEquivalentToOptions:optionsWithHint(@"login_hint")]);
+  XCTAssertFalse([options isEquivalentToOptions:optionsWithHint(@"other_login_hint")]);
+  XCTAssertFalse([options isEquivalentToOptions:optionsWithHint(nil)]);
+  XCTAssertFalse([options isEquivalentToOptions:[GIDSignInInternalOptions
+      silentOptionsWithCompletion:^(GIDSignInResult *_Nullable signInResult,
+                                    NSError * _Nullable error) {}]]);
+}
+
 @end
@@ -0,0 +1,303 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDAuthStateMigration/Fake/GIDFakeAuthStateMigration.h"
+#import "GoogleSignIn/Sources/GIDSignIn_Private.h"
+#import "GoogleSignIn/Tests/Unit/OIDAuthState+Testing.h"
+#import "GoogleSignIn/Tests/Unit/OIDTokenResponse+Testing.h"
+
+#ifdef SWIFT_PACKAGE
+@import AppAuth;
+@import GTMAppAuth;
+@import OCMock;
+#else
+#import <AppAuth/AppAuth.h>
+#import <GTMAppAuth/GTMAppAuth.h>
+#import <OCMock/OCMock.h>
+#endif
+
+static NSString *const kItemName = @"auth";
+static NSString *const kTokenResponseService = @"auth-tokens";
+static NSString *const kRefreshedAccessToken = @"refreshed_access_token";
+
+@interface GIDSignIn (Persistence)
+
+- (BOOL)saveAuthState:(OIDAuthState *)authState;
+- (BOOL)saveTokenResponseOfAuthState:(OIDAuthState *)authState;
+- (nullable OIDAuthState *)loadAuthState;
+- (void)saveAuthStateInBackground:(OIDAuthState *)authState
+                tokenResponseOnly:(BOOL)tokenResponseOnly;
+
+@end
+
+@interface GIDSignInPersistenceTest : XCTestCase
+@end
+
+@implementation GIDSignInPersistenceTest {
+  id _keychainStore;
+  id _keychainHelper;
+  // The contents of the faked keychain, by service.
+  NSMutableDictionary<NSString *, NSString *> *_passwords;
+  // The archived auth state of the last saved auth session.
+  NSData *_savedAuthState;
+  GTMAuthSession *_retrievedAuthSession;
+  NSUInteger _authSessionSaveCount;
+  // Whether saving an auth session fails.
+  BOOL _authSessionSaveFails;
+  GIDSignIn *_signIn;
+}
+
+- (void)setUp {
+  [super setUp];
+  _passwords = [NSMutableDictionary dictionary];
+  _savedAuthState = nil;
+  _authSessionSaveCount = 0;
+  _authSessionSaveFails = NO;
+
+  _keychainHelper = OCMProtocolMock(@protocol(GTMKeychainHelper));
+  OCMStub([_keychainHelper setPassword:OCMOCK_ANY
+                             forService:OCMOCK_ANY
+                                  error:[OCMArg anyObjectRef]])
+      .andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *password;
+        __unsafe_unretained NSString *service;
+        [invocation getArgument:&password atIndex:2];
+        [invocation getArgument:&service atIndex:3];
+        self->_passwords[service] = password;
+      });
+  OCMStub([_keychainHelper passwordForService:OCMOCK_ANY error:[OCMArg anyObjectRef]])
+      .andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *service;
+        [invocation getArgument:&service atIndex:2];
+        __unsafe_unretained NSString *password = self->_passwords[service];
+        [invocation setReturnValue:&password];
+      });
+  OCMStub([_keychainHelper removePasswordForService:OCMOCK_ANY error:[OCMArg anyObjectRef]])
+      .andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *service;
+        [invocation getArgument:&service atIndex:2];
+        [self->_passwords removeObjectForKey:service];
+      });
+
+  _keychainStore = OCMClassMock([GTMKeychainStore class]);
+  OCMStub([_keychainStore itemName]).andReturn(kItemName);
+  OCMStub([_keychainStore keychainHelper]).andReturn(_keychainHelper);
+  OCMStub([_keychainStore saveAuthSession:OCMOCK_ANY error:[OCMArg anyObjectRef]])
+      .andDo(^(NSInvocation *invocation) {
+        if (self->_authSessionSaveFails) {
+          NSError *__autoreleasing *error;
+          [invocation getArgument:&error atIndex:3];
+          *error = [NSError errorWithDomain:NSOSStatusErrorDomain code:-1 userInfo:nil];
+          return;
+        }
+        __unsafe_unretained GTMAuthSession *authSession;
+        [invocation getArgument:&authSession atIndex:2];
+        self->_savedAuthState = [NSKeyedArchiver archivedDataWithRootObject:authSession.authState
+                                                      requiringSecureCoding:YES
+                                                                      error:nil];
+        self->_authSessionSaveCount++;
+      });
+  OCMStub([_keychainStore retrieveAuthSessionWithError:[OCMArg anyObjectRef]])
+      .andDo(^(NSInvocation *invocation) {
+        OIDAuthState *authState = [NSKeyedUnarchiver unarchivedObjectOfClass:[OIDAuthState class]
+                                                                     fromData:self->_savedAuthState
+                                                                        error:nil];
+        // Keep the session alive until the caller retains the return value.
+        self->_retrievedAuthSession =
+            authState ? [[GTMAuthSession alloc] initWithAuthState:authState] : nil;
+        __unsafe_unretained GTMAuthSession *authSession = self->_retrievedAuthSession;
+        [invocation setReturnValue:&authSession];
+      });
+  OCMStub([_keychainStore removeAuthSessionWithError:[OCMArg anyObjectRef]])
+      .andDo(^(NSInvocation *invocation) {
+        self->_savedAuthState = nil;
+      });
+
+  _signIn = [[GIDSignIn alloc] initWithKeychainStore:_keychainStore
+                           authStateMigrationService:[[GIDFakeAuthStateMigration alloc] init]];
+}
+
+- (void)tearDown {
+  [_keychainStore stopMocking];
+  [super tearDown];
+}
+
+#pragma mark - Tests
+
+- (void)testSaveTokenResponseOnlyWritesTokenResponse {
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  XCTAssertTrue([_signIn saveAuthState:authState]);
+  XCTAssertEqual(_authSessionSaveCount, 1u);
+
+  [self refreshAuthState:authState refreshToken:authState.refreshToken];
+  XCTAssertTrue([_signIn saveTokenResponseOfAuthState:authState]);
+
+  XCTAssertEqual(_authSessionSaveCount, 1u, @"should not rewrite the auth session");
+  XCTAssertNotNil(_passwords[kTokenResponseService]);
+}
+
+- (void)testLoadAuthStateAppliesRefreshedTokenResponse {
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  [_signIn saveAuthState:authState];
+  [self refreshAuthState:authState refreshToken:authState.refreshToken];
+  [_signIn saveTokenResponseOfAuthState:authState];
+
+  OIDAuthState *loadedAuthState = [_signIn loadAuthState];
+
+  XCTAssertEqualObjects(loadedAuthState.lastTokenResponse.accessToken, kRefreshedAccessToken);
+  XCTAssertEqualObjects(loadedAuthState.refreshToken, authState.refreshToken);
+  XCTAssertEqualObjects(loadedAuthState.lastAuthorizationResponse.authorizationCode,
+                        authState.lastAuthorizationResponse.authorizationCode);
+}
+
+- (void)testLoadAuthStateIgnoresTokenResponseOfAnotherGrant {
+  OIDAuthState *previousAuthState = [OIDAuthState testInstance];
+  [_signIn saveAuthState:previousAuthState];
+  [self refreshAuthState:previousAuthState refreshToken:previousAuthState.refreshToken];
+  [_signIn saveTokenResponseOfAuthState:previousAuthState];
+  NSString *staleTokenResponse = _passwords[kTokenResponseService];
+
+  OIDAuthState *authState = [OIDAuthState testInstanceWithIDToken:[OIDTokenResponse idToken]
+                                                      accessToken:kAccessToken
+                                             accessTokenExpiresIn:kAccessTokenExpiresIn
+                                                     refreshToken:@"other_refresh_token"];
+  [_signIn saveAuthState:authState];
+  // Simulate a token response left over from the previous grant.
+  _passwords[kTokenResponseService] = staleTokenResponse;
+
+  OIDAuthState *loadedAuthState = [_signIn loadAuthState];
+
+  XCTAssertEqualObjects(loadedAuthState.lastTokenResponse.accessToken, kAccessToken);
+  XCTAssertEqualObjects(loadedAuthState.refreshToken, @"other_refresh_token");
+}
+
+- (void)testSaveAuthStateRemovesTokenResponse {
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  [_signIn saveAuthState:authState];
+  [self refreshAuthState:authState refreshToken:authState.refreshToken];
+  [_signIn saveTokenResponseOfAuthState:authState];
+  XCTAssertNotNil(_passwords[kTokenResponseService]);
+
+  XCTAssertTrue([_signIn saveAuthState:[OIDAuthState testInstance]]);
+
+  XCTAssertEqual(_authSessionSaveCount, 2u);
+  XCTAssertNil(_passwords[kTokenResponseService]);
+}
+
+- (void)testSaveTokenResponseWithRotatedRefreshTokenSavesAuthSession {
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  [_signIn saveAuthState:authState];
+  [self refreshAuthState:authState refreshToken:@"rotated_refresh_token"];
+
+  XCTAssertTrue([_signIn saveTokenResponseOfAuthState:authState]);
+
+  XCTAssertEqual(_authSessionSaveCount, 2u);
+  XCTAssertNil(_passwords[kTokenResponseService]);
+  XCTAssertEqualObjects([_signIn loadAuthState].refreshToken, @"rotated_refresh_token");
+}
+
+- (void)testKeychainAccessWaitsForMigration {
+  __block BOOL migrated = NO;
+  GIDFakeAuthStateMigration *migration = [[GIDFakeAuthStateMigration alloc] init];
+  migration.migrationInvokedCallback =
+      ^(NSURL *tokenURL, NSString *callbackPath, BOOL isFreshInstall) {
+        XCTAssertFalse([NSThread isMainThread]);
+        [NSThread sleepForTimeInterval:0.1];
+        migrated = YES;
+      };
+  GIDSignIn *signIn = [[GIDSignIn alloc] initWithKeychainStore:_keychainStore
+                                     authStateMigrationService:migration];
+
+  [signIn loadAuthState];
+
+  XCTAssertTrue(migrated);
+}
+
+- (void)testSaveAuthStateInBackgroundSavesSnapshot {
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  [_signIn saveAuthStateInBackground:authState tokenResponseOnly:NO];
+  [self refreshAuthState:authState refreshToken:authState.refreshToken];
+
+  OIDAuthState *loadedAuthState = [_signIn loadAuthState];
+
+  XCTAssertEqual(_authSessionSaveCount, 1u);
+  XCTAssertEqualObjects(loadedAuthState.lastTokenResponse.accessToken, kAccessToken);
+}
+
+- (void)testSaveAuthStateInBackgroundKeepsRefreshTokenOfEarlierResponse {
+  OIDAuthState *authState = [OIDAuthState testInstance];
+  NSString *refreshToken = authState.refreshToken;
+  // Refresh responses may omit the refresh token, which the auth state keeps.
+  OIDTokenResponse *tokenResponse =
+      [[OIDTokenResponse alloc] initWithRequest:[authState tokenRefreshRequest]
+                                     parameters:@{
+                                       @"access_token" : kRefreshedAccessToken,
+                                       @"expires_in" : @(kAccessTokenExpiresIn),
+                                       @"token_type" : @"Bearer",
+                                     }];
+  [authState updateWithTokenResponse:tokenResponse error:nil];
+  XCTAssertNil(authState.lastTokenResponse.refreshToken);
+
+  [_signIn saveAuthStateInBackground:authState tokenResponseOnly:NO];
+  OIDAuthState *loadedAuthState = [_signIn loadAuthState];
+
+  XCTAssertEqualObjects(loadedAuthState.refreshToken, refreshToken);
+  XCTAssertEqualObjects(loadedAuthState.scope, authState.scope);
+  XCTAssertEqualObjects(loadedAuthState.lastTokenResponse.accessToken, kRefreshedAccessToken);
+  XCTAssertEqualObjects(loadedAuthState.lastAuthorizationResponse.authorizationCode,
+                        authState.lastAuthorizationResponse.authorizationCode);
+}
+
+- (void)testSignOutWaitsForBackgroundSave {
+  [_signIn saveAuthStateInBackground:[OIDAuthState testInstance] tokenResponseOnly:NO];
+
+  [_signIn signOut];
+
+  XCTAssertNil([_signIn loadAuthState]);
+}
+
+- (void)testSaveAuthStateInBackgroundReportsFailure {
+  _authSessionSaveFails = YES;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Error handler called"];
+  _signIn.persistenceErrorHandler = ^(NSError *error) {
+    XCTAssertTrue([NSThread isMainThread]);
+    XCTAssertEqualObjects(error.domain, kGIDSignInErrorDomain);
+    XCTAssertEqual(error.code, kGIDSignInErrorCodeKeychain);
+    [expectation fulfill];
+  };
+
+  [_signIn saveAuthStateInBackground:[OIDAuthState testInstance] tokenResponseOnly:NO];
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertNil([_signIn loadAuthState]);
+}
+
+#pragma mark - Helpers
+
+// Updates |authState| as a token refresh returning |refreshToken| would.
+- (void)refreshAuthState:(OIDAuthState *)authState refreshToken:(NSString *)refreshToken {
+  OIDTokenResponse *tokenResponse =
+      [OIDTokenResponse testInstanceWithIDToken:[OIDTokenResponse idToken]
+                                    accessToken:kRefreshedAccessToken
+                                      expiresIn:@(kAccessTokenExpiresIn * 2)
+                                   refreshToken:refreshToken
+                                   tokenRequest:[authState tokenRefreshRequest]];
+  [authState updateWithTokenResponse:tokenResponse error:nil];
+}
+
+@end
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDSignInStrings.h"
+#import "GoogleSignIn/Sources/NSBundle+GID3PAdditions.h"
+
+static NSString *const kStringsTableName = @"GoogleSignIn";
+
+@interface GIDSignInStringsTest : XCTestCase
+@end
+
+@implementation GIDSignInStringsTest
+
+- (void)testFrameworkBundleIsResolvedOnce {
+  NSBundle *bundle = [NSBundle gid_frameworkBundle];
+  XCTAssertNotNil(bundle);
+  XCTAssertEqual([NSBundle gid_frameworkBundle], bundle);
+}
+
+- (void)testLocalizedStringsMatchBundle {
+  NSBundle *bundle = [NSBundle gid_frameworkBundle];
+  for (NSString *key in @[ @"Sign in", @"Sign in with Google", @"OK", @"Cancel" ]) {
+    NSString *expected = [bundle localizedStringForKey:key value:key table:kStringsTableName];
+    XCTAssertEqualObjects([GIDSignInStrings localizedStringForKey:key text:key], expected);
+  }
+  XCTAssertEqualObjects([GIDSignInStrings signInString],
+                        [bundle localizedStringForKey:@"Sign in"
+                                                value:@"Sign in"
+                                                table:kStringsTableName]);
+}
+
+- (void)testUnknownKeyReturnsText {
+  XCTAssertEqualObjects([GIDSignInStrings localizedStringForKey:@"NoSuchKey" text:@"Fallback"],
+                        @"Fallback");
+}
+
+- (void)testEveryDevelopmentLocalizationKeyIsLocalized {
+  // Keys missing from the preferred localization fall back to the development localization.
+  NSBundle *bundle = [NSBundle gid_frameworkBundle];
+  NSString *path = [bundle pathForResource:kStringsTableName
+                                    ofType:@"strings"
+                               inDirectory:nil
+                           forLocalization:bundle.developmentLocalization ?: @"en"];
+  NSDictionary<NSString *, NSString *> *developmentTable =
+      [NSDictionary dictionaryWithContentsOfFile:path];
+  XCTAssertGreaterThan(developmentTable.count, 0u);
+  for (NSString *key in developmentTable) {
+    NSString *expected = [bundle localizedStringForKey:key value:nil table:kStringsTableName];
+    XCTAssertEqualObjects([GIDSignInStrings localizedStringForKey:key text:@""], expected);
+  }
+}
+
+- (void)testLookupPerformance {
+  [self measureBlock:^{
+    for (int i = 0; i < 10000; i++) {
+      [GIDSignInStrings signInWithGoogleString];
+    }
+  }];
+}
+
+@end
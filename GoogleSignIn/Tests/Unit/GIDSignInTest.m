@@ -33,6 +33,8 @@
 #import "GoogleSignIn/Sources/GIDSignIn_Private.h"
 #import "GoogleSignIn/Sources/GIDSignInPreferences.h"
 #import "GoogleSignIn/Sources/GIDClaimsInternalOptions.h"
+#import "GoogleSignIn/Sources/GIDTokenRevocationQueue.h"
+#import "GoogleSignIn/Sources/GIDAuthStateStore/Fake/GIDFakeAuthStateStore.h"
 
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
 #import <AppCheckCore/GACAppCheckToken.h>
@@ -111,6 +113,7 @@ static NSString * const kContinueURL = @"com.google.UnitTests:/oauth2callback";
 static NSString * const kContinueURLWithClientID = @"FakeClientID:/oauth2callback";
 static NSString * const kWrongSchemeURL = @"wrong.app:/oauth2callback";
 static NSString * const kWrongPathURL = @"com.google.UnitTests:/wrong_path";
+static NSString * const kWrongPathURLWithClientID = @"FakeClientID:/wrong_path";
 
 static NSString * const kEMMRestartAuthURL =
      @"com.google.UnitTests:///emmcallback?action=restart_auth";
@@ -118,6 +121,8 @@ static NSString * const kEMMWrongPathURL =
      @"com.google.UnitTests:///unknowcallback?action=restart_auth";
 static NSString * const kEMMWrongActionURL =
      @"com.google.UnitTests:///emmcallback?action=unrecognized";
+static NSString * const kEMMRestartAuthURLWithClientID =
+     @"FakeClientID:///emmcallback?action=restart_auth";
 static NSString * const kDevicePolicyAppBundleID = @"com.google.DevicePolicy";
 
 static NSString * const kFingerprintKeychainName = @"fingerprint";
@@ -153,6 +158,8 @@ static NSString *const kTokenURL = @"https://oauth2.googleapis.com/token";
 
 static NSString *const kFakeURL = @"http://foo.com";
 
+static NSString *const kUserInfoETag = @"\"userinfo-etag\"";
+
 static NSString *const kEMMSupport = @"1";
 
 static NSString *const kGrantedScope = @"grantedScope";
@@ -207,6 +214,9 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   // Mock |GTMKeychainStore|.
   id _keychainStore;
 
+  // Mock |GTMKeychainHelper| of |_keychainStore|.
+  id _keychainHelper;
+
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
   // Mock |UIViewController|.
   id _presentingViewController;
@@ -316,6 +326,9 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
     [_keychainStore retrieveAuthSessionWithItemName:OCMOCK_ANY error:OCMArg.anyObjectRef]
   ).andReturn(_authorization);
   OCMStub([_keychainStore retrieveAuthSessionWithError:nil]).andReturn(_authorization);
+  _keychainHelper = OCMProtocolMock(@protocol(GTMKeychainHelper));
+  OCMStub([_keychainStore itemName]).andReturn(kKeychainName);
+  OCMStub([_keychainStore keychainHelper]).andReturn(_keychainHelper);
   OCMStub([_authorization alloc]).andReturn(_authorization);
   OCMStub([_authorization initWithAuthState:OCMOCK_ANY]).andReturn(_authorization);
   OCMStub(
@@ -609,7 +622,8 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
 
 - (void)testRestorePreviousSignInWhenCompletionIsNil {
   [[[_authorization expect] andReturn:_authState] authState];
-  [[_keychainStore expect] saveAuthSession:OCMOCK_ANY error:[OCMArg anyObjectRef]];
+  // The restored access token is still valid, so there is nothing new to save.
+  [[_keychainStore reject] saveAuthSession:OCMOCK_ANY error:[OCMArg anyObjectRef]];
   [[[_authState expect] andReturnValue:[NSNumber numberWithBool:YES]] isAuthorized];
 
   OIDTokenResponse *tokenResponse =
@@ -632,6 +646,382 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   XCTAssertNotNil(_signIn.currentUser);
 }
 
+- (void)testRestorePreviousSignIn_defersProfileLoading {
+  _signIn.defersProfileLoading = YES;
+  OCMStub([_authorization fetcherService]).andReturn(_fetcherService);
+  [[[_authorization expect] andReturn:_authState] authState];
+  [[[_authState expect] andReturnValue:[NSNumber numberWithBool:YES]] isAuthorized];
+  // The ID token has no profile, which would otherwise be fetched from the userinfo endpoint.
+  OIDTokenResponse *tokenResponse =
+      [OIDTokenResponse testInstanceWithIDToken:[OIDTokenResponse idToken]
+                                    accessToken:kAccessToken
+                                      expiresIn:nil
+                                   refreshToken:kRefreshToken
+                                   tokenRequest:nil];
+  [[[_authState stub] andReturn:tokenResponse] lastTokenResponse];
+  [[[_user stub] andReturn:_user] alloc];
+  (void)[[[_user expect] andReturn:_user] initWithAuthState:OCMOCK_ANY
+                                                profileData:[OCMArg isNil]];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback called"];
+
+  [_signIn restorePreviousSignInWithCompletion:^(GIDGoogleUser *_Nullable user,
+                                                 NSError *_Nullable error) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertNil(error);
+    [expectation fulfill];
+  }];
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertFalse([self isFetcherStarted], @"should not fetch the profile");
+}
+
+// Verifies a profile fetch shared with a request without a timeout isn't given the timeout of the
+// request that started the flow, while that request still times out on its own.
+- (void)testRestorePreviousSignInWithTimeout_joinedRequestWithoutTimeoutOutlivesTimeout {
+  OCMStub([_authorization fetcherService]).andReturn(_fetcherService);
+  [[[_authorization expect] andReturn:_authState] authState];
+  [[[_authState expect] andReturnValue:[NSNumber numberWithBool:YES]] isAuthorized];
+  // The ID token has no profile, so it is fetched from the userinfo endpoint.
+  OIDTokenResponse *tokenResponse =
+      [OIDTokenResponse testInstanceWithIDToken:[OIDTokenResponse idToken]
+                                    accessToken:kAccessToken
+                                      expiresIn:nil
+                                   refreshToken:kRefreshToken
+                                   tokenRequest:nil];
+  [[[_authState stub] andReturn:tokenResponse] lastTokenResponse];
+  [[[_user stub] andReturn:_user] alloc];
+  (void)[[[_user expect] andReturn:_user] initWithAuthState:OCMOCK_ANY
+                                                profileData:OCMOCK_ANY];
+  XCTestExpectation *timedOutExpectation = [self expectationWithDescription:@"Timed out"];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback called"];
+
+  [_signIn restorePreviousSignInWithTimeout:0.1
+                                 completion:^(GIDGoogleUser *_Nullable user,
+                                              NSError *_Nullable error) {
+    XCTAssertNil(user);
+    XCTAssertEqual(error.code, kGIDSignInErrorCodeTimedOut);
+    [timedOutExpectation fulfill];
+  }];
+  [_signIn restorePreviousSignInWithCompletion:^(GIDGoogleUser *_Nullable user,
+                                                 NSError *_Nullable error) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertNil(error);
+    [expectation fulfill];
+  }];
+  GIDFakeFetcher *fetcher = [self waitForFetcherAtIndex:0];
+  XCTAssertGreaterThan(fetcher.request.timeoutInterval, 1);
+
+  [self waitForExpectations:@[ timedOutExpectation ] timeout:1];
+  [fetcher didFinishWithResponse:[self userInfoResponseWithHeaders:@{}]
+                            data:[self userInfoData]
+                           error:nil];
+
+  [self waitForExpectations:@[ expectation ] timeout:1];
+}
+
+- (void)testFetchProfileData_revalidatesSavedProfile {
+  GIDSignIn *signIn =
+      [[GIDSignIn alloc] initWithAuthStateStore:[[GIDFakeAuthStateStore alloc] init]
+                      authStateMigrationService:_authStateMigrationService];
+  OCMStub([_authorization fetcherService]).andReturn(_fetcherService);
+  OIDTokenResponse *tokenResponse =
+      [OIDTokenResponse testInstanceWithIDToken:[OIDTokenResponse idToken]];
+  [[[_authState stub] andReturn:tokenResponse] lastTokenResponse];
+  OIDIDToken *idToken = [[OIDIDToken alloc] initWithIDTokenString:[OIDTokenResponse idToken]];
+  __block GIDProfileData *fetchedProfileData;
+
+  [signIn fetchProfileDataWithAuthState:_authState
+                                idToken:idToken
+                             completion:^(GIDProfileData *profileData, NSError *error) {
+    XCTAssertNil(error);
+    fetchedProfileData = profileData;
+  }];
+  GIDFakeFetcher *fetcher = [self waitForFetcherAtIndex:0];
+  XCTAssertNil([fetcher.request valueForHTTPHeaderField:@"If-None-Match"]);
+  [fetcher didFinishWithResponse:[self userInfoResponseWithHeaders:@{ @"ETag" : kUserInfoETag }]
+                            data:[self userInfoData]
+                           error:nil];
+  XCTAssertEqualObjects(fetchedProfileData.name, kFatName);
+
+  __block GIDProfileData *revalidatedProfileData;
+  [signIn fetchProfileDataWithAuthState:_authState
+                                idToken:idToken
+                             completion:^(GIDProfileData *profileData, NSError *error) {
+    XCTAssertNil(error);
+    revalidatedProfileData = profileData;
+  }];
+  fetcher = [self waitForFetcherAtIndex:1];
+  XCTAssertEqualObjects([fetcher.request valueForHTTPHeaderField:@"If-None-Match"],
+                        kUserInfoETag);
+  NSError *notModified = [NSError errorWithDomain:kGTMSessionFetcherStatusDomain
+                                             code:GTMSessionFetcherStatusNotModified
+                                         userInfo:nil];
+  [fetcher didFinishWithResponse:nil data:nil error:notModified];
+  XCTAssertEqualObjects(revalidatedProfileData, fetchedProfileData);
+}
+
+- (void)testFetchProfileData_ignoresProfileSavedForOtherUser {
+  GIDSignIn *signIn =
+      [[GIDSignIn alloc] initWithAuthStateStore:[[GIDFakeAuthStateStore alloc] init]
+                      authStateMigrationService:_authStateMigrationService];
+  OCMStub([_authorization fetcherService]).andReturn(_fetcherService);
+  OIDTokenResponse *tokenResponse =
+      [OIDTokenResponse testInstanceWithIDToken:[OIDTokenResponse idToken]];
+  [[[_authState stub] andReturn:tokenResponse] lastTokenResponse];
+  NSString *otherIDTokenString = [OIDTokenResponse idTokenWithSub:@"other_user"
+                                                              exp:@(kIDTokenExpires)];
+  OIDIDToken *otherIDToken = [[OIDIDToken alloc] initWithIDTokenString:otherIDTokenString];
+  [signIn fetchProfileDataWithAuthState:_authState
+                                idToken:otherIDToken
+                             completion:^(GIDProfileData *profileData, NSError *error) {}];
+  [[self waitForFetcherAtIndex:0]
+      didFinishWithResponse:[self userInfoResponseWithHeaders:@{ @"ETag" : kUserInfoETag }]
+                       data:[self userInfoData]
+                      error:nil];
+
+  OIDIDToken *idToken = [[OIDIDToken alloc] initWithIDTokenString:[OIDTokenResponse idToken]];
+  [signIn fetchProfileDataWithAuthState:_authState
+                                idToken:idToken
+                             completion:^(GIDProfileData *profileData, NSError *error) {}];
+
+  GIDFakeFetcher *fetcher = [self waitForFetcherAtIndex:1];
+  XCTAssertNil([fetcher.request valueForHTTPHeaderField:@"If-None-Match"]);
+}
+
+- (void)testRestorePreviousSignInWithRestoredUserHandler_deliversUserBeforeRefresh {
+  _signIn.currentUser = _user;
+  OCMStub([_user needsTokenRefresh]).andReturn(YES);
+  __block GIDGoogleUserCompletion refreshCompletion;
+  [[_user expect] refreshTokensIfNeededWithCancellationToken:OCMOCK_ANY
+                                          completion:SAVE_TO_ARG_BLOCK(refreshCompletion)];
+  XCTestExpectation *restoredUserExpectation =
+      [self expectationWithDescription:@"Restored user handler called"];
+  XCTestExpectation *completionExpectation = [self expectationWithDescription:@"Callback called"];
+  __block BOOL refreshed = NO;
+
+  [_signIn restorePreviousSignInWithRestoredUserHandler:^(GIDGoogleUser *user,
+                                                          BOOL tokensAreFresh) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertFalse(tokensAreFresh);
+    XCTAssertFalse(refreshed, @"should deliver the user before refreshing its tokens");
+    [restoredUserExpectation fulfill];
+  } completion:^(GIDGoogleUser *_Nullable user, NSError *_Nullable error) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertNil(error);
+    [completionExpectation fulfill];
+  }];
+
+  [self waitForExpectations:@[ restoredUserExpectation ] timeout:1];
+  refreshed = YES;
+  refreshCompletion(_user, nil);
+  [self waitForExpectations:@[ completionExpectation ] timeout:1];
+}
+
+- (void)testRestorePreviousSignInWithRestoredUserHandler_noPreviousUser {
+  __block NSUInteger authStateReads = 0;
+  [[[_authorization stub] andDo:^(NSInvocation *invocation) {
+    authStateReads++;
+  }] authState];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback called"];
+
+  [_signIn restorePreviousSignInWithRestoredUserHandler:^(GIDGoogleUser *user,
+                                                          BOOL tokensAreFresh) {
+    XCTFail(@"should not call the restored user handler");
+  } completion:^(GIDGoogleUser *_Nullable user, NSError *_Nullable error) {
+    XCTAssertNil(user);
+    XCTAssertEqual(error.code, kGIDSignInErrorCodeHasNoAuthInKeychain);
+    [expectation fulfill];
+  }];
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertNil(_signIn.currentUser);
+  XCTAssertEqual(authStateReads, 1u, @"should restore from the auth state it already loaded");
+}
+
+- (void)testRestorePreviousSignIn_concurrentCallsShareOneFlow {
+  _signIn.currentUser = _user;
+  // The strict user mock fails if the tokens are refreshed more than once.
+  __block GIDGoogleUserCompletion refreshCompletion;
+  [[_user expect] refreshTokensIfNeededWithCancellationToken:OCMOCK_ANY
+                                          completion:SAVE_TO_ARG_BLOCK(refreshCompletion)];
+  XCTestExpectation *firstExpectation = [self expectationWithDescription:@"First callback"];
+  XCTestExpectation *secondExpectation = [self expectationWithDescription:@"Second callback"];
+
+  [_signIn restorePreviousSignInWithCompletion:^(GIDGoogleUser *_Nullable user,
+                                                 NSError *_Nullable error) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertNil(error);
+    [firstExpectation fulfill];
+  }];
+  [_signIn restorePreviousSignInWithCompletion:^(GIDGoogleUser *_Nullable user,
+                                                 NSError *_Nullable error) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertNil(error);
+    [secondExpectation fulfill];
+  }];
+  refreshCompletion(_user, nil);
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testRestorePreviousSignIn_cancelledCallLeavesSharedFlowRunning {
+  _signIn.currentUser = _user;
+  __block GIDGoogleUserCompletion refreshCompletion;
+  [[_user expect] refreshTokensIfNeededWithCancellationToken:OCMOCK_ANY
+                                          completion:SAVE_TO_ARG_BLOCK(refreshCompletion)];
+  XCTestExpectation *cancelledExpectation = [self expectationWithDescription:@"Cancelled callback"];
+  cancelledExpectation.inverted = YES;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback"];
+
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  [_signIn restorePreviousSignInWithCancellationToken:cancellationToken
+                                           completion:^(GIDGoogleUser *_Nullable user,
+                                                        NSError *_Nullable error) {
+    [cancelledExpectation fulfill];
+  }];
+  [_signIn restorePreviousSignInWithCompletion:^(GIDGoogleUser *_Nullable user,
+                                                 NSError *_Nullable error) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertNil(error);
+    [expectation fulfill];
+  }];
+  [cancellationToken cancel];
+  refreshCompletion(_user, nil);
+
+  [self waitForExpectations:@[ cancelledExpectation, expectation ] timeout:1];
+}
+
+- (void)testRestorePreviousSignInWithTimeout_timesOut {
+  _signIn.currentUser = _user;
+  __block GIDGoogleUserCompletion refreshCompletion;
+  [[_user expect] refreshTokensIfNeededWithCancellationToken:OCMOCK_ANY
+                                          completion:SAVE_TO_ARG_BLOCK(refreshCompletion)];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback called"];
+
+  [_signIn restorePreviousSignInWithTimeout:0.1
+                                 completion:^(GIDGoogleUser *_Nullable user,
+                                              NSError *_Nullable error) {
+    XCTAssertNil(user);
+    XCTAssertEqualObjects(error.domain, kGIDSignInErrorDomain);
+    XCTAssertEqual(error.code, kGIDSignInErrorCodeTimedOut);
+    [expectation fulfill];
+  }];
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  // The refresh completing late doesn't call back again.
+  refreshCompletion(_user, nil);
+  XCTestExpectation *drainExpectation = [self expectationWithDescription:@"Main queue drained"];
+  dispatch_async(dispatch_get_main_queue(), ^{
+    [drainExpectation fulfill];
+  });
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testRestorePreviousSignInWithTimeout_completesBeforeTimeout {
+  _signIn.currentUser = _user;
+  __block GIDGoogleUserCompletion refreshCompletion;
+  [[_user expect] refreshTokensIfNeededWithCancellationToken:OCMOCK_ANY
+                                          completion:SAVE_TO_ARG_BLOCK(refreshCompletion)];
+  __block NSUInteger callbackCount = 0;
+
+  [_signIn restorePreviousSignInWithTimeout:0.1
+                                 completion:^(GIDGoogleUser *_Nullable user,
+                                              NSError *_Nullable error) {
+    XCTAssertEqual(user, self->_user);
+    XCTAssertNil(error);
+    callbackCount++;
+  }];
+  refreshCompletion(_user, nil);
+  // Waits past the timeout.
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Timeout passed"];
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+    [expectation fulfill];
+  });
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertEqual(callbackCount, 1);
+}
+
+- (void)testSignIn_identicalConcurrentRequestsShareOneFlow {
+  __block NSUInteger completionCount = 0;
+  GIDSignInCompletion completion = ^(GIDSignInResult *_Nullable signInResult,
+                                     NSError *_Nullable error) {
+    XCTAssertEqual(error.code, kGIDSignInErrorCodeCanceled);
+    completionCount++;
+  };
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  [_signIn signInWithPresentingViewController:_presentingViewController
+                                         hint:_hint
+                                   completion:completion];
+#elif TARGET_OS_OSX
+  [_signIn signInWithPresentingWindow:_presentingWindow hint:_hint completion:completion];
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  OIDAuthorizationCallback authorizationCallback = _savedAuthorizationCallback;
+  XCTAssertNotNil(authorizationCallback);
+  _savedAuthorizationCallback = nil;
+
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  [_signIn signInWithPresentingViewController:_presentingViewController
+                                         hint:_hint
+                                   completion:completion];
+#elif TARGET_OS_OSX
+  [_signIn signInWithPresentingWindow:_presentingWindow hint:_hint completion:completion];
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  XCTAssertNil(_savedAuthorizationCallback, @"should not present a second authorization flow");
+
+  authorizationCallback(nil, [NSError errorWithDomain:OIDGeneralErrorDomain
+                                                 code:OIDErrorCodeUserCanceledAuthorizationFlow
+                                             userInfo:nil]);
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callbacks called"];
+  dispatch_async(dispatch_get_main_queue(), ^{
+    [expectation fulfill];
+  });
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertEqual(completionCount, 2);
+}
+
+- (void)testSignIn_completesAfterRestoreFinishesDuringFlow {
+  __block NSError *signInError;
+  GIDSignInCompletion completion = ^(GIDSignInResult *_Nullable signInResult,
+                                     NSError *_Nullable error) {
+    signInError = error;
+  };
+#if TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  [_signIn signInWithPresentingViewController:_presentingViewController
+                                         hint:_hint
+                                   completion:completion];
+#elif TARGET_OS_OSX
+  [_signIn signInWithPresentingWindow:_presentingWindow hint:_hint completion:completion];
+#endif // TARGET_OS_IOS || TARGET_OS_MACCATALYST
+  OIDAuthorizationCallback authorizationCallback = _savedAuthorizationCallback;
+  XCTAssertNotNil(authorizationCallback);
+
+  // A restore started and finished while the browser is up replaces the current options.
+  [[[_authorization expect] andReturn:_authState] authState];
+  [[[_authState expect] andReturnValue:[NSNumber numberWithBool:NO]] isAuthorized];
+  XCTestExpectation *restoreExpectation = [self expectationWithDescription:@"Restore completed"];
+  [_signIn restorePreviousSignInWithCompletion:^(GIDGoogleUser *_Nullable user,
+                                                 NSError *_Nullable error) {
+    XCTAssertEqual(error.code, kGIDSignInErrorCodeHasNoAuthInKeychain);
+    [restoreExpectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+
+  authorizationCallback(nil, [NSError errorWithDomain:OIDGeneralErrorDomain
+                                                 code:OIDErrorCodeUserCanceledAuthorizationFlow
+                                             userInfo:nil]);
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback called"];
+  dispatch_async(dispatch_get_main_queue(), ^{
+    [expectation fulfill];
+  });
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertEqual(signInError.code, kGIDSignInErrorCodeCanceled,
+                 @"the interactive flow should complete its own request");
+}
+
 - (void)testOAuthLogin {
   OCMStub(
     [_keychainStore saveAuthSession:OCMOCK_ANY error:OCMArg.anyObjectRef]
@@ -1210,6 +1600,13 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   XCTAssertFalse(_completionCalled, @"should not call delegate");
 }
 
+- (void)testNotHandleWrongPathWithRegisteredScheme {
+  NSURL *url = [NSURL URLWithString:kWrongPathURLWithClientID];
+  XCTAssertFalse([_signIn handleURL:url], @"should not handle URL");
+  XCTAssertFalse(_keychainSaved, @"should not save to keychain");
+  XCTAssertFalse(_completionCalled, @"should not call delegate");
+}
+
 #pragma mark - Test Fresh Install
 
 - (void)testFreshInstall_removesKeychainEntries {
@@ -1282,6 +1679,56 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   [_tokenResponse verify];
 }
 
+// Verifies a cancelled disconnect does not call its callback.
+- (void)testDisconnect_cancelled {
+  [[[_authorization expect] andReturn:_authState] authState];
+  [[[_authState expect] andReturn:_tokenResponse] lastTokenResponse];
+  [[[_tokenResponse expect] andReturn:kAccessToken] accessToken];
+  [[[_authorization expect] andReturn:_fetcherService] fetcherService];
+  XCTestExpectation *callbackExpectation = [self expectationWithDescription:@"Callback called"];
+  callbackExpectation.inverted = YES;
+  GIDCancellationToken *cancellationToken = [[GIDCancellationToken alloc] init];
+  [_signIn disconnectWithCancellationToken:cancellationToken
+                                completion:^(NSError * _Nullable error) {
+    [callbackExpectation fulfill];
+  }];
+  XCTAssertTrue([self isFetcherStarted], @"should start fetching");
+
+  [cancellationToken cancel];
+  [self didFetch:nil error:nil];
+
+  [self waitForExpectations:@[callbackExpectation] timeout:0.1];
+  [_authorization verify];
+  [_authState verify];
+  [_tokenResponse verify];
+}
+
+// Verifies a disconnect that takes longer than its timeout fails and stays signed in.
+- (void)testDisconnectWithTimeout_timesOut {
+  [[[_authorization expect] andReturn:_authState] authState];
+  [[[_authState expect] andReturn:_tokenResponse] lastTokenResponse];
+  [[[_tokenResponse expect] andReturn:kAccessToken] accessToken];
+  [[[_authorization expect] andReturn:_fetcherService] fetcherService];
+  XCTestExpectation *errorExpectation =
+      [self expectationWithDescription:@"Callback called with a timeout error"];
+  [_signIn disconnectWithTimeout:0.1 completion:^(NSError * _Nullable error) {
+    XCTAssertEqualObjects(error.domain, kGIDSignInErrorDomain);
+    XCTAssertEqual(error.code, kGIDSignInErrorCodeTimedOut);
+    [errorExpectation fulfill];
+  }];
+  XCTAssertTrue([self isFetcherStarted], @"should start fetching");
+  // The revoke request is given the timeout of the disconnect.
+  GTMSessionFetcher *fetcher = _fetcherService.fetchers[0];
+  XCTAssertLessThanOrEqual(fetcher.request.timeoutInterval, 1);
+  XCTAssertLessThanOrEqual(fetcher.maxRetryInterval, 1);
+
+  [self waitForExpectations:@[errorExpectation] timeout:1];
+  XCTAssertFalse(_keychainRemoved, @"should stay signed in");
+  [_authorization verify];
+  [_authState verify];
+  [_tokenResponse verify];
+}
+
 // Verifies disconnect errors are passed along to the callback.
 - (void)testDisconnect_errors {
   [[[_authorization expect] andReturn:_authState] authState];
@@ -1359,6 +1806,26 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   [_tokenResponse verify];
 }
 
+// Verifies disconnecting in the background queues the refresh token before signing out.
+- (void)testDisconnectInBackground_refreshToken {
+  [[[_authorization expect] andReturn:_authState] authState];
+  [[[_authState expect] andReturn:kRefreshToken] refreshToken];
+  id tokenRevocationQueue = OCMStrictClassMock([GIDTokenRevocationQueue class]);
+  OCMExpect([tokenRevocationQueue revokeToken:kRefreshToken completion:nil])
+      .andDo(^(NSInvocation *invocation) {
+    XCTAssertFalse(self->_keychainRemoved, @"token should be queued before signing out");
+  });
+  _signIn.tokenRevocationQueue = tokenRevocationQueue;
+
+  [_signIn disconnectInBackgroundWithCompletion:nil];
+
+  XCTAssertFalse([self isFetcherStarted], @"should not fetch");
+  XCTAssertTrue(_keychainRemoved, @"keychain should be removed");
+  OCMVerifyAll(tokenRevocationQueue);
+  [_authorization verify];
+  [_authState verify];
+}
+
 - (void)testPresentingViewControllerException {
 #if TARGET_OS_IOS || TARGET_OS_MACCATALYST
   _presentingViewController = nil;
@@ -1427,6 +1894,12 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   XCTAssertFalse(result);
 }
 
+// Verifies that URL is not handled if there is no pending sign-in, even if its scheme is registered
+- (void)testRequiringPendingSignIn_registeredScheme {
+  BOOL result = [_signIn handleURL:[NSURL URLWithString:kEMMRestartAuthURLWithClientID]];
+  XCTAssertFalse(result);
+}
+
 #pragma mark - EMM tests
 
 #if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
@@ -1598,6 +2071,19 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   return !!count;
 }
 
+// Waits for the fetcher at |index| to be started, since profile fetches first read the saved
+// profile on the store queue.
+- (GIDFakeFetcher *)waitForFetcherAtIndex:(NSUInteger)index {
+  NSPredicate *started = [NSPredicate predicateWithBlock:^BOOL(GIDFakeFetcherService *service,
+                                                               NSDictionary *bindings) {
+    return service.fetchers.count > index;
+  }];
+  XCTestExpectation *startedExpectation =
+      [[XCTNSPredicateExpectation alloc] initWithPredicate:started object:_fetcherService];
+  [self waitForExpectations:@[ startedExpectation ] timeout:1];
+  return _fetcherService.fetchers[index];
+}
+
 // Gets the URL being fetched.
 - (NSURL *)fetchedURL {
   return [_fetcherService.fetchers[0] requestURL];
@@ -1620,6 +2106,25 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   return [NSError errorWithDomain:kErrorDomain code:kErrorCode userInfo:nil];
 }
 
+// A userinfo endpoint response with the given headers.
+- (NSHTTPURLResponse *)userInfoResponseWithHeaders:(NSDictionary<NSString *, NSString *> *)headers {
+  return [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:kFakeURL]
+                                     statusCode:200
+                                    HTTPVersion:@"HTTP/1.1"
+                                   headerFields:headers];
+}
+
+// The body of a userinfo endpoint response.
+- (NSData *)userInfoData {
+  NSDictionary<NSString *, NSString *> *profile = @{
+    kBasicProfileNameKey : kFatName,
+    kBasicProfileGivenNameKey : kFatGivenName,
+    kBasicProfileFamilyNameKey : kFatFamilyName,
+    kBasicProfilePictureKey : kFakeURL,
+  };
+  return [NSJSONSerialization dataWithJSONObject:profile options:0 error:nil];
+}
+
 // Verifies a fetcher has started for revoking token and emulates a server response.
 - (void)verifyAndRevokeToken:(NSString *)token
                  hasCallback:(BOOL)hasCallback
@@ -1869,6 +2374,10 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   [[[_authState expect] andReturn:tokenResponse] lastTokenResponse];
 
   // SaveAuthCallback
+  if (restoredSignIn && oldAccessToken) {
+    // saveTokenResponseOfAuthState
+    [[[_authState expect] andReturn:tokenResponse] lastTokenResponse];
+  }
   __block OIDAuthState *authState;
   __block OIDTokenResponse *updatedTokenResponse;
   __block OIDAuthorizationResponse *updatedAuthorizationResponse;
@@ -1914,7 +2423,11 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
 
   [_authState verify];
 
-  XCTAssertTrue(_keychainSaved, @"should save to keychain");
+  if (restoredSignIn && !oldAccessToken) {
+    XCTAssertFalse(_keychainSaved, @"should not save an unchanged auth state to keychain");
+  } else {
+    XCTAssertTrue(_keychainSaved, @"should save to keychain");
+  }
   if (addScopesFlow) {
     XCTAssertNotNil(updatedTokenResponse);
     XCTAssertNotNil(updatedAuthorizationResponse);
@@ -1934,7 +2447,8 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   _authError = nil;
 
   __block GIDGoogleUserCompletion completion;
-  [[_user expect] refreshTokensIfNeededWithCompletion:SAVE_TO_ARG_BLOCK(completion)];
+  [[_user expect] refreshTokensIfNeededWithCancellationToken:OCMOCK_ANY
+                                          completion:SAVE_TO_ARG_BLOCK(completion)];
 
   XCTestExpectation *restorePreviousSignInExpectation =
       [self expectationWithDescription:@"Callback should be called"];
@@ -1954,6 +2468,10 @@ static NSString *const kNonEssentialAuthTimeClaimsJsonString =
   if (restoredSignIn) {
     // Ignore the return value
     OCMVerify((void)[_keychainStore retrieveAuthSessionWithError:OCMArg.anyObjectRef]);
+  }
+  if (restoredSignIn && oldAccessToken) {
+    // The refreshed token response comes with a new refresh token, so the whole auth state is
+    // saved.
     OCMVerify([_keychainStore saveAuthSession:OCMOCK_ANY error:OCMArg.anyObjectRef]);
   }
 }
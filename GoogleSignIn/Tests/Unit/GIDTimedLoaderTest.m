@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <TargetConditionals.h>
+
+#if TARGET_OS_IOS && !TARGET_OS_MACCATALYST
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDTimedLoader/GIDLatencyEstimator.h"
+#import "GoogleSignIn/Sources/GIDTimedLoader/GIDTimedLoader.h"
+
+static NSTimeInterval const kAccuracy = 0.0001;
+
+@interface GIDTimedLoaderTest : XCTestCase
+@end
+
+@implementation GIDTimedLoaderTest
+
+#pragma mark - GIDLatencyEstimator
+
+- (void)testEstimatorWithoutSamples {
+  GIDLatencyEstimator *estimator = [[GIDLatencyEstimator alloc] init];
+  XCTAssertEqual(estimator.sampleCount, 0);
+  XCTAssertEqual(estimator.predictedLatency, 0);
+}
+
+- (void)testEstimatorFirstSample {
+  GIDLatencyEstimator *estimator = [[GIDLatencyEstimator alloc] init];
+  [estimator addSample:0.4];
+  XCTAssertEqual(estimator.sampleCount, 1);
+  XCTAssertEqualWithAccuracy(estimator.smoothedLatency, 0.4, kAccuracy);
+  XCTAssertEqualWithAccuracy(estimator.latencyDeviation, 0.2, kAccuracy);
+  XCTAssertEqualWithAccuracy(estimator.predictedLatency, 0.8, kAccuracy);
+}
+
+- (void)testEstimatorConvergesOnSteadyLatency {
+  GIDLatencyEstimator *estimator = [[GIDLatencyEstimator alloc] init];
+  for (int i = 0; i < 100; i++) {
+    [estimator addSample:0.3];
+  }
+  XCTAssertEqualWithAccuracy(estimator.smoothedLatency, 0.3, kAccuracy);
+  XCTAssertEqualWithAccuracy(estimator.predictedLatency, 0.3, kAccuracy);
+}
+
+- (void)testEstimatorIgnoresNegativeSamples {
+  GIDLatencyEstimator *estimator = [[GIDLatencyEstimator alloc] init];
+  [estimator addSample:-1];
+  XCTAssertEqual(estimator.sampleCount, 0);
+}
+
+#pragma mark - Adaptive timing
+
+- (void)testDelayBeforeAnimating {
+  // No prediction, or work predicted to finish early, keeps the default delay.
+  XCTAssertEqual([GIDTimedLoader delayBeforeAnimatingForPredictedLatency:0],
+                 kGIDTimedLoaderMaxDelayBeforeAnimating);
+  XCTAssertEqual([GIDTimedLoader delayBeforeAnimatingForPredictedLatency:0.5],
+                 kGIDTimedLoaderMaxDelayBeforeAnimating);
+  // Work predicted to finish shortly after the default delay is waited out.
+  XCTAssertEqual([GIDTimedLoader delayBeforeAnimatingForPredictedLatency:1.0], 1.0);
+  // Slow work shows the indicator at the default delay.
+  XCTAssertEqual([GIDTimedLoader delayBeforeAnimatingForPredictedLatency:3.0],
+                 kGIDTimedLoaderMaxDelayBeforeAnimating);
+}
+
+- (void)testMinAnimationDuration {
+  XCTAssertEqual([GIDTimedLoader minAnimationDurationForPredictedLatency:0 elapsed:0.8],
+                 kGIDTimedLoaderMinAnimationDuration);
+  // Overdue work falls back to the full duration.
+  XCTAssertEqual([GIDTimedLoader minAnimationDurationForPredictedLatency:0.5 elapsed:0.8],
+                 kGIDTimedLoaderMinAnimationDuration);
+  XCTAssertEqualWithAccuracy([GIDTimedLoader minAnimationDurationForPredictedLatency:1.4
+                                                                             elapsed:0.8],
+                             0.6, kAccuracy);
+  XCTAssertEqual([GIDTimedLoader minAnimationDurationForPredictedLatency:0.9 elapsed:0.8],
+                 kGIDTimedLoaderMinAdaptiveAnimationDuration);
+  XCTAssertEqual([GIDTimedLoader minAnimationDurationForPredictedLatency:5.0 elapsed:0.8],
+                 kGIDTimedLoaderMinAnimationDuration);
+}
+
+- (void)testStopBeforePresentingReportsEventsAndRecordsSample {
+  GIDTimedLoader *loader =
+      [[GIDTimedLoader alloc] initWithPresentingViewController:[[UIViewController alloc] init]];
+  NSMutableArray<NSNumber *> *events = [NSMutableArray array];
+  loader.eventHandler = ^(GIDTimedLoaderEvent event, CFTimeInterval elapsed) {
+    XCTAssertGreaterThanOrEqual(elapsed, 0);
+    [events addObject:@(event)];
+  };
+
+  XCTestExpectation *completionExpectation =
+      [self expectationWithDescription:@"Completion is called"];
+  [loader startTiming];
+  [loader stopTimingWithCompletion:^{
+    [completionExpectation fulfill];
+  }];
+
+  [self waitForExpectations:@[completionExpectation] timeout:1];
+
+  NSArray<NSNumber *> *expectedEvents = @[
+    @(GIDTimedLoaderEventStarted),
+    @(GIDTimedLoaderEventFinishedWithoutPresenting),
+    @(GIDTimedLoaderEventCompleted),
+  ];
+  XCTAssertEqualObjects(events, expectedEvents);
+  XCTAssertEqual(loader.animationStatus, GIDTimedLoaderAnimationStatusStopped);
+  XCTAssertEqual(loader.latencyEstimator.sampleCount, 1);
+  XCTAssertLessThan(loader.lastAddedLatency, kGIDTimedLoaderMinAnimationDuration);
+}
+
+@end
+
+#endif // TARGET_OS_IOS && !TARGET_OS_MACCATALYST
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "GoogleSignIn/Sources/GIDAuthStateStore/Fake/GIDFakeAuthStateStore.h"
+#import "GoogleSignIn/Sources/GIDTokenRevocationQueue.h"
+#import "GoogleSignIn/Tests/Unit/GIDFakeFetcher.h"
+#import "GoogleSignIn/Tests/Unit/GIDFakeFetcherService.h"
+
+static NSString *const kToken = @"token";
+static NSString *const kOtherToken = @"other_token";
+
+// Predicate expectations are polled, so allow for more than one polling interval.
+static const NSTimeInterval kTimeout = 5;
+
+@interface GIDTokenRevocationQueueTest : XCTestCase
+@end
+
+@implementation GIDTokenRevocationQueueTest {
+  GIDFakeAuthStateStore *_store;
+  GIDFakeFetcherService *_fetcherService;
+  dispatch_queue_t _storeQueue;
+  dispatch_group_t _storeReadyGroup;
+  GIDTokenRevocationQueue *_revocationQueue;
+}
+
+- (void)setUp {
+  [super setUp];
+  _store = [[GIDFakeAuthStateStore alloc] init];
+  _fetcherService = [[GIDFakeFetcherService alloc] init];
+  _storeQueue = dispatch_queue_create("GIDTokenRevocationQueueTest", DISPATCH_QUEUE_SERIAL);
+  _storeReadyGroup = dispatch_group_create();
+  _revocationQueue = [[GIDTokenRevocationQueue alloc] initWithAuthStateStore:_store
+                                                                   storeQueue:_storeQueue
+                                                              storeReadyGroup:_storeReadyGroup
+                                                               fetcherService:_fetcherService];
+}
+
+- (void)testRevokeToken_savesTokenAheadOfLaterStoreWork {
+  [_revocationQueue revokeToken:kToken completion:nil];
+
+  __block NSArray<NSString *> *pendingTokens;
+  dispatch_sync(_storeQueue, ^{
+    pendingTokens = [self->_store retrievePendingRevocationsWithError:nil];
+  });
+  XCTAssertEqualObjects(pendingTokens, @[ kToken ]);
+}
+
+- (void)testRevokeToken_waitsForStoreWithoutBlockingCaller {
+  dispatch_group_enter(_storeReadyGroup);
+
+  [_revocationQueue revokeToken:kToken completion:nil];
+
+  XCTAssertNil([_store retrievePendingRevocationsWithError:nil]);
+  dispatch_group_leave(_storeReadyGroup);
+  dispatch_sync(_storeQueue, ^{});
+  XCTAssertEqualObjects([_store retrievePendingRevocationsWithError:nil], @[ kToken ]);
+}
+
+- (void)testRevokeToken_revokesToken {
+  XCTestExpectation *revoked = [self expectationWithDescription:@"Token revoked"];
+  [_revocationQueue revokeToken:kToken completion:^{
+    XCTAssertTrue([NSThread isMainThread]);
+    [revoked fulfill];
+  }];
+
+  GIDFakeFetcher *fetcher = [self waitForFetcherAtIndex:0];
+  XCTAssertEqualObjects(fetcher.requestURL, [GIDTokenRevocationQueue revokeURLForToken:kToken]);
+  XCTAssertEqual(fetcher.request.timeoutInterval, 15.0, @"should not wait for the default timeout");
+  [fetcher didFinishWithData:[NSData data] error:nil];
+
+  [self waitForExpectations:@[ revoked ] timeout:1];
+  XCTAssertNil([_store retrievePendingRevocationsWithError:nil]);
+}
+
+- (void)testRevokeToken_revokesPendingTokensTogether {
+  XCTestExpectation *revoked = [self expectationWithDescription:@"Tokens revoked"];
+  revoked.expectedFulfillmentCount = 2;
+  [_store savePendingRevocations:@[ kOtherToken ] error:nil];
+  [_revocationQueue revokeToken:kToken completion:^{
+    [revoked fulfill];
+  }];
+  [_revocationQueue revokeToken:kOtherToken completion:^{
+    [revoked fulfill];
+  }];
+
+  NSSet<NSURL *> *expectedURLs = [NSSet setWithArray:@[
+    [GIDTokenRevocationQueue revokeURLForToken:kToken],
+    [GIDTokenRevocationQueue revokeURLForToken:kOtherToken],
+  ]];
+  NSMutableSet<NSURL *> *requestedURLs = [NSMutableSet set];
+  for (NSUInteger index = 0; index < 2; index++) {
+    GIDFakeFetcher *fetcher = [self waitForFetcherAtIndex:index];
+    [requestedURLs addObject:fetcher.requestURL];
+    [fetcher didFinishWithData:[NSData data] error:nil];
+  }
+
+  [self waitForExpectations:@[ revoked ] timeout:1];
+  XCTAssertEqualObjects(requestedURLs, expectedURLs);
+  XCTAssertNil([_store retrievePendingRevocationsWithError:nil]);
+}
+
+- (void)testRevokeToken_keepsTokenAfterTransientFailure {
+  XCTestExpectation *revoked = [self expectationWithDescription:@"Token revoked"];
+  [_revocationQueue revokeToken:kToken completion:^{
+    [revoked fulfill];
+  }];
+  NSError *unavailable = [NSError errorWithDomain:kGTMSessionFetcherStatusDomain
+                                             code:503
+                                         userInfo:nil];
+  [[self waitForFetcherAtIndex:0] didFinishWithData:nil error:unavailable];
+  XCTAssertEqualObjects([_store retrievePendingRevocationsWithError:nil], @[ kToken ]);
+
+  // Queueing the token again retries right away rather than after the backoff.
+  [_revocationQueue revokeToken:kToken completion:nil];
+  [[self waitForFetcherAtIndex:1] didFinishWithData:[NSData data] error:nil];
+
+  [self waitForExpectations:@[ revoked ] timeout:1];
+  XCTAssertNil([_store retrievePendingRevocationsWithError:nil]);
+}
+
+- (void)testRevokeToken_dropsTokenRejectedByServer {
+  XCTestExpectation *finished = [self expectationWithDescription:@"Token dropped"];
+  [_revocationQueue revokeToken:kToken completion:^{
+    [finished fulfill];
+  }];
+  NSError *badRequest = [NSError errorWithDomain:kGTMSessionFetcherStatusDomain
+                                            code:400
+                                        userInfo:nil];
+  [[self waitForFetcherAtIndex:0] didFinishWithData:nil error:badRequest];
+
+  [self waitForExpectations:@[ finished ] timeout:1];
+  XCTAssertNil([_store retrievePendingRevocationsWithError:nil]);
+}
+
+- (void)testResume_revokesSavedTokens {
+  [_store savePendingRevocations:@[ kToken ] error:nil];
+
+  [_revocationQueue resume];
+
+  GIDFakeFetcher *fetcher = [self waitForFetcherAtIndex:0];
+  XCTAssertEqualObjects(fetcher.requestURL, [GIDTokenRevocationQueue revokeURLForToken:kToken]);
+}
+
+#pragma mark - Helpers
+
+// Waits for the revocation queue to start its fetcher at |index|.
+- (GIDFakeFetcher *)waitForFetcherAtIndex:(NSUInteger)index {
+  NSPredicate *started = [NSPredicate predicateWithBlock:^BOOL(GIDFakeFetcherService *service,
+                                                               NSDictionary *bindings) {
+    return service.fetchers.count > index;
+  }];
+  XCTestExpectation *startedExpectation =
+      [[XCTNSPredicateExpectation alloc] initWithPredicate:started object:_fetcherService];
+  [self waitForExpectations:@[ startedExpectation ] timeout:kTimeout];
+  return _fetcherService.fetchers[index];
+}
+
+@end
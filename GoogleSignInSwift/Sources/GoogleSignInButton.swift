@@ -26,6 +26,8 @@ import CoreGraphics
 public struct GoogleSignInButton: View {
   /// An object containing the styling information needed to create the button.
   @ObservedObject public var viewModel: GoogleSignInButtonViewModel
+  @Environment(\.signInButtonBodyEvaluationRecorder)
+  private var bodyEvaluationRecorder: SignInButtonBodyEvaluationRecorder?
   private let action: () -> Void
   private let fontLoaded: Bool
 
@@ -41,7 +43,7 @@ public struct GoogleSignInButton: View {
   ) {
     self.viewModel = viewModel
     self.action = action
-    self.fontLoaded = Font.loadCGFont()
+    self.fontLoaded = GoogleSignInButtonResources.fontLoaded
   }
 
   /// A convenience initializer to create a Google Sign-In button in SwiftUI
@@ -67,42 +69,22 @@ public struct GoogleSignInButton: View {
     self.init(viewModel: vm, action: action)
   }
 
+  /// Registers the button font and measures the localized button text on a
+  /// background queue.
+  ///
+  /// Calling this early keeps that work off the main thread when the first
+  /// button is created. Calling it is optional and safe to repeat.
+  public static func prefetchResources() {
+    GoogleSignInButtonResources.prefetch()
+  }
+
   public var body: some View {
+    let _ = bodyEvaluationRecorder?.record(.button)
     Button(action: action) {
-      switch viewModel.style {
-      case .icon:
-        ZStack {
-          RoundedRectangle(cornerRadius: googleCornerRadius)
-            .fill(viewModel.buttonStyle.colors.iconColor)
-            .border(viewModel.buttonStyle.colors.iconBorderColor)
-          Image.signInButtonImage
-        }
-      case .standard, .wide:
-        HStack(alignment: .center) {
-          ZStack {
-            RoundedRectangle(cornerRadius: googleCornerRadius)
-              .fill(
-                viewModel.state == .disabled ?
-                  .clear : viewModel.buttonStyle.colors.iconColor
-              )
-              .frame(
-                width: iconWidth - iconPadding,
-                height: iconWidth - iconPadding
-              )
-            Image.signInButtonImage
-          }
-          .padding(.leading, 1)
-          Text(viewModel.style.buttonText)
-            .fixedSize()
-            .padding(.trailing, textPadding)
-            .frame(
-              width: viewModel.style.widthForButtonText,
-              height: buttonHeight,
-              alignment: .leading
-            )
-          Spacer()
-        }
-      }
+      // Only the colors change on press, so the label's subviews are compared by their inputs and
+      // their bodies are skipped when those are unchanged.
+      SignInButtonLabel(viewModel: viewModel)
+        .equatable()
     }
     .font(signInButtonFont)
     .buttonStyle(viewModel.buttonStyle)
@@ -122,23 +104,196 @@ public struct GoogleSignInButton: View {
   }
 }
 
+// MARK: - Button Subviews
+
+/// The content of the sign-in button, laid out by button style.
+@available(iOS 13.0, macOS 10.15, *)
+struct SignInButtonLabel: View, Equatable {
+  let style: GoogleSignInButtonStyle
+  let iconColor: Color
+  /// The border of the icon style's icon, or `nil` for the other styles, which draw no border.
+  let iconBorderColor: Color?
+  let isDisabled: Bool
+  @Environment(\.signInButtonBodyEvaluationRecorder)
+  var bodyEvaluationRecorder: SignInButtonBodyEvaluationRecorder?
+
+  var body: some View {
+    let _ = bodyEvaluationRecorder?.record(.label)
+    switch style {
+    case .icon:
+      SignInButtonIcon(fillColor: iconColor, borderColor: iconBorderColor, size: nil)
+        .equatable()
+    case .standard, .wide:
+      HStack(alignment: .center) {
+        SignInButtonIcon(
+          fillColor: isDisabled ? .clear : iconColor,
+          borderColor: nil,
+          size: iconWidth - iconPadding
+        )
+        .equatable()
+        .padding(.leading, 1)
+        SignInButtonText(style: style)
+          .equatable()
+        Spacer()
+      }
+    }
+  }
+
+  static func == (lhs: SignInButtonLabel, rhs: SignInButtonLabel) -> Bool {
+    return lhs.style == rhs.style &&
+      lhs.iconColor == rhs.iconColor &&
+      lhs.iconBorderColor == rhs.iconBorderColor &&
+      lhs.isDisabled == rhs.isDisabled
+  }
+}
+
+@available(iOS 13.0, macOS 10.15, *)
+extension SignInButtonLabel {
+  /// Creates the label for the current style and state of `viewModel`.
+  init(viewModel: GoogleSignInButtonViewModel) {
+    let colors = viewModel.buttonStyle.colors
+    self.init(
+      style: viewModel.style,
+      iconColor: colors.iconColor,
+      // The border follows the background, which changes on press, so leave it out where it is not
+      // drawn to keep the label unchanged.
+      iconBorderColor: viewModel.style == .icon ? colors.iconBorderColor : nil,
+      isDisabled: viewModel.state == .disabled
+    )
+  }
+}
+
+/// The Google icon on its rounded background.
+@available(iOS 13.0, macOS 10.15, *)
+struct SignInButtonIcon: View, Equatable {
+  let fillColor: Color
+  /// The border color, or `nil` for no border.
+  let borderColor: Color?
+  /// The side length of the background, or `nil` to fill the available space.
+  let size: CGFloat?
+  @Environment(\.signInButtonBodyEvaluationRecorder)
+  var bodyEvaluationRecorder: SignInButtonBodyEvaluationRecorder?
+
+  var body: some View {
+    let _ = bodyEvaluationRecorder?.record(.icon)
+    ZStack {
+      if let borderColor = borderColor {
+        RoundedRectangle(cornerRadius: googleCornerRadius)
+          .fill(fillColor)
+          .border(borderColor)
+      } else {
+        RoundedRectangle(cornerRadius: googleCornerRadius)
+          .fill(fillColor)
+          .frame(width: size, height: size)
+      }
+      Image.signInButtonImage
+    }
+  }
+
+  static func == (lhs: SignInButtonIcon, rhs: SignInButtonIcon) -> Bool {
+    return lhs.fillColor == rhs.fillColor &&
+      lhs.borderColor == rhs.borderColor &&
+      lhs.size == rhs.size
+  }
+}
+
+/// The localized button text, which only depends on the button style.
+@available(iOS 13.0, macOS 10.15, *)
+struct SignInButtonText: View, Equatable {
+  let style: GoogleSignInButtonStyle
+  @Environment(\.signInButtonBodyEvaluationRecorder)
+  var bodyEvaluationRecorder: SignInButtonBodyEvaluationRecorder?
+
+  var body: some View {
+    let _ = bodyEvaluationRecorder?.record(.text)
+    Text(style.buttonText)
+      .fixedSize()
+      .padding(.trailing, textPadding)
+      .frame(
+        width: style.widthForButtonText,
+        height: buttonHeight,
+        alignment: .leading
+      )
+  }
+
+  static func == (lhs: SignInButtonText, rhs: SignInButtonText) -> Bool {
+    return lhs.style == rhs.style
+  }
+}
+
+// MARK: - Body Evaluation Recording
+
+/// Counts `body` evaluations of the button and its subviews, so that tests can check how much of
+/// the view graph an interaction invalidates.
+///
+/// Nothing is recorded unless a recorder is set with the `signInButtonBodyEvaluationRecorder`
+/// environment value, which only tests do.
+@available(iOS 13.0, macOS 10.15, *)
+@MainActor
+final class SignInButtonBodyEvaluationRecorder {
+  enum Part: Hashable {
+    case button
+    case label
+    case icon
+    case text
+  }
+
+  private var counts = [Part: Int]()
+
+  func record(_ part: Part) {
+    counts[part, default: 0] += 1
+  }
+
+  func count(for part: Part) -> Int {
+    return counts[part, default: 0]
+  }
+
+  func reset() {
+    counts.removeAll()
+  }
+}
+
+@available(iOS 13.0, macOS 10.15, *)
+private struct SignInButtonBodyEvaluationRecorderKey: EnvironmentKey {
+  static let defaultValue: SignInButtonBodyEvaluationRecorder? = nil
+}
+
+@available(iOS 13.0, macOS 10.15, *)
+extension EnvironmentValues {
+  /// The recorder of the sign-in button's `body` evaluations, or `nil` to record nothing.
+  var signInButtonBodyEvaluationRecorder: SignInButtonBodyEvaluationRecorder? {
+    get { self[SignInButtonBodyEvaluationRecorderKey.self] }
+    set { self[SignInButtonBodyEvaluationRecorderKey.self] = newValue }
+  }
+}
+
 // MARK: - Google Icon Image
 
 @available(iOS 13.0, macOS 10.15, *)
 private extension Image {
-  static var signInButtonImage: Image {
+  /// The Google icon, decoded once per process rather than on every `body` evaluation.
+  @MainActor
+  static let signInButtonImage: Image = loadSignInButtonImage()
+
+  static func loadSignInButtonImage() -> Image {
+#if os(iOS) || targetEnvironment(macCatalyst)
+    // Named images are cached by UIKit per bundle and scale, which also serves the UIKit
+    // `GIDSignInButton`.
+    guard let uiImage = UIImage(
+      named: googleImageName,
+      in: Bundle.gidFrameworkBundle(),
+      compatibleWith: nil
+    ) else {
+      fatalError("Unable to load Google icon image url: \(Image.Error.unableToLoadGoogleIcon(name: googleImageName))")
+    }
+    return Image(uiImage: uiImage)
+#elseif os(macOS)
     guard let iconURL = Bundle.urlForGoogleResource(
       name: googleImageName,
       withExtension: "png"
     ) else {
       fatalError("Unable to load Google icon image url: \(Image.Error.unableToLoadGoogleIcon(name: googleImageName))")
     }
-#if os(iOS) || targetEnvironment(macCatalyst)
-    guard let uiImage = UIImage(contentsOfFile: iconURL.path) else {
-      fatalError("Unable to load Google icon image url: \(Image.Error.unableToLoadGoogleIcon(name: googleImageName))")
-    }
-    return Image(uiImage: uiImage)
-#elseif os(macOS)
     guard let nsImage = NSImage(contentsOfFile: iconURL.path) else {
       fatalError("Unable to load Google icon image url: \(Image.Error.unableToLoadGoogleIcon(name: googleImageName))")
     }
@@ -166,32 +321,4 @@ private extension GoogleSignInButton {
   }
 }
 
-@available(iOS 13.0, macOS 10.15, *)
-private extension Font {
-  /// Load the font for the button.
-  /// - returns A `Bool` indicating whether or not the font was loaded.
-  static func loadCGFont() -> Bool {
-    // Check to see if the font has already been loaded
-#if os(iOS) || targetEnvironment(macCatalyst)
-    if let _ = UIFont(name: fontNameRobotoBold, size: fontSize) {
-      return true
-    }
-#elseif os(macOS)
-    if let _ = NSFont(name: fontNameRobotoBold, size: fontSize) {
-      return true
-    }
-#else
-    fatalError("Unrecognized platform for SwiftUI sign in button font")
-#endif
-    guard let fontURL = Bundle.urlForGoogleResource(
-      name: fontNameRobotoBold,
-      withExtension: "ttf"
-    ), let dataProvider = CGDataProvider(filename: fontURL.path),
-          let newFont = CGFont(dataProvider) else {
-            return false
-          }
-    return CTFontManagerRegisterGraphicsFont(newFont, nil)
-  }
-}
-
 #endif // !arch(arm) && !arch(i386)
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#if !arch(arm) && !arch(i386)
+
+import SwiftUI
+import CoreGraphics
+
+/// A process-wide store of the sign-in button's font, localized strings and text metrics.
+///
+/// Strings and widths are computed once per locale, so constructing or re-evaluating a
+/// `GoogleSignInButton` only costs a lookup. Mutable state is guarded by `lock`.
+@available(iOS 13.0, macOS 10.15, *)
+final class GoogleSignInButtonResources: @unchecked Sendable {
+  /// The shared store.
+  static let shared = GoogleSignInButtonResources()
+
+  /// Whether the button font was registered, or was already available.
+  static let fontLoaded: Bool = loadFont()
+
+  /// The localized strings and their measured widths for one locale.
+  private struct LocalizedMetrics {
+    let standardText: String
+    let wideText: String
+    let standardWidth: CGFloat
+    let wideWidth: CGFloat
+  }
+
+  private let lock = NSLock()
+  private var metricsByLocale = [String: LocalizedMetrics]()
+  /// The metrics for the current locale; reset when the locale changes.
+  private var currentMetrics: LocalizedMetrics?
+  private let notificationCenter: NotificationCenter
+  private var localeObserver: NSObjectProtocol?
+
+  init(notificationCenter: NotificationCenter = .default) {
+    self.notificationCenter = notificationCenter
+    localeObserver = notificationCenter.addObserver(
+      forName: NSLocale.currentLocaleDidChangeNotification,
+      object: nil,
+      queue: nil
+    ) { [weak self] _ in
+      self?.invalidateCurrentLocale()
+    }
+  }
+
+  deinit {
+    if let localeObserver = localeObserver {
+      notificationCenter.removeObserver(localeObserver)
+    }
+  }
+
+  /// The localized text for the given button style.
+  func buttonText(for style: GoogleSignInButtonStyle) -> String {
+    switch style {
+    case .wide: return metrics().wideText
+    case .standard: return metrics().standardText
+    case .icon: return ""
+    }
+  }
+
+  /// The width of the localized text for the given button style.
+  func widthForButtonText(for style: GoogleSignInButtonStyle) -> CGFloat {
+    switch style {
+    case .wide: return metrics().wideWidth
+    case .standard: return metrics().standardWidth
+    case .icon: return 0
+    }
+  }
+
+  /// Registers the font and measures the current locale's text on a background
+  /// queue, so that the first button only looks them up.
+  static func prefetch() {
+    DispatchQueue.global(qos: .utility).async {
+      _ = fontLoaded
+      _ = shared.widthForButtonText(for: .standard)
+    }
+  }
+
+  /// Forgets which locale is current so that the next lookup resolves it again.
+  func invalidateCurrentLocale() {
+    lock.lock()
+    currentMetrics = nil
+    lock.unlock()
+  }
+
+  private func metrics() -> LocalizedMetrics {
+    lock.lock()
+    defer { lock.unlock() }
+    if let currentMetrics = currentMetrics {
+      return currentMetrics
+    }
+    let localeKey = Locale.preferredLanguages.first ?? Locale.current.identifier
+    if let cached = metricsByLocale[localeKey] {
+      currentMetrics = cached
+      return cached
+    }
+    let strings = GoogleSignInButtonString()
+    let standardText = strings.localizedStandardButtonText
+    let wideText = strings.localizedWideButtonText
+    let metrics = LocalizedMetrics(
+      standardText: standardText,
+      wideText: wideText,
+      standardWidth: Self.textWidth(standardText),
+      wideWidth: Self.textWidth(wideText)
+    )
+    metricsByLocale[localeKey] = metrics
+    currentMetrics = metrics
+    return metrics
+  }
+
+  /// Measures `text` in the button font.
+  private static func textWidth(_ text: String) -> CGFloat {
+    _ = fontLoaded
+    let size = CGSize(width: .max, height: .max)
+    let anyFont: Any
+#if os(iOS) || targetEnvironment(macCatalyst)
+    anyFont = UIFont(name: fontNameRobotoBold, size: fontSize) ??
+      UIFont.boldSystemFont(ofSize: fontSize)
+#elseif os(macOS)
+    anyFont = NSFont(name: fontNameRobotoBold, size: fontSize) ??
+      NSFont.boldSystemFont(ofSize: fontSize)
+#else
+    fatalError("Unrecognized platform to calculate minimum width")
+#endif
+
+    let rect = (text as NSString).boundingRect(
+      with: size,
+      options: [],
+      attributes: [.font: anyFont],
+      context: nil
+    )
+
+    return rect.width
+  }
+
+  /// Load the font for the button.
+  /// - returns A `Bool` indicating whether or not the font was loaded.
+  private static func loadFont() -> Bool {
+    // Check to see if the font has already been loaded
+#if os(iOS) || targetEnvironment(macCatalyst)
+    if let _ = UIFont(name: fontNameRobotoBold, size: fontSize) {
+      return true
+    }
+#elseif os(macOS)
+    if let _ = NSFont(name: fontNameRobotoBold, size: fontSize) {
+      return true
+    }
+#else
+    fatalError("Unrecognized platform for SwiftUI sign in button font")
+#endif
+    guard let fontURL = Bundle.urlForGoogleResource(
+      name: fontNameRobotoBold,
+      withExtension: "ttf"
+    ), let dataProvider = CGDataProvider(filename: fontURL.path),
+          let newFont = CGFont(dataProvider) else {
+            return false
+          }
+    return CTFontManagerRegisterGraphicsFont(newFont, nil)
+  }
+}
+
+#endif // !arch(arm) && !arch(i386)
@@ -219,38 +219,12 @@ extension GoogleSignInButtonStyle {
     }
   }
 
-  private var buttonStrings: GoogleSignInButtonString {
-    return GoogleSignInButtonString()
-  }
-
   var buttonText: String {
-    switch self {
-    case .wide: return buttonStrings.localizedWideButtonText
-    case .standard: return buttonStrings.localizedStandardButtonText
-    case .icon: return ""
-    }
+    return GoogleSignInButtonResources.shared.buttonText(for: self)
   }
 
   var widthForButtonText: CGFloat {
-    let bt = buttonText as NSString
-    let size = CGSize(width: .max, height: .max)
-    let anyFont: Any
-#if os(iOS) || targetEnvironment(macCatalyst)
-    anyFont = UIFont(name: fontNameRobotoBold, size: fontSize) as Any
-#elseif os(macOS)
-    anyFont = NSFont(name: fontNameRobotoBold, size: fontSize) as Any
-#else
-    fatalError("Unrecognized platform to calculate minimum width")
-#endif
-
-    let rect = bt.boundingRect(
-      with: size,
-      options: [],
-      attributes: [.font: anyFont],
-      context: nil
-    )
-
-    return rect.width
+    return GoogleSignInButtonResources.shared.widthForButtonText(for: self)
   }
 }
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import SwiftUI
+import XCTest
+@testable import GoogleSignInSwift
+
+/// Checks which parts of the button's view graph an interaction invalidates.
+///
+/// The button's subviews are compared by their inputs through `.equatable()`, so a subview's body
+/// is only evaluated again when its inputs change. Hosted buttons count their body evaluations
+/// through a `SignInButtonBodyEvaluationRecorder` set in their environment.
+@MainActor
+@available(iOS 13.0, macOS 10.15, *)
+class GoogleSignInButtonBodyEvaluationTests: XCTestCase {
+#if os(iOS) && !targetEnvironment(macCatalyst)
+  private var window: UIWindow?
+  private var recorder: SignInButtonBodyEvaluationRecorder!
+
+  override func setUp() {
+    super.setUp()
+    recorder = SignInButtonBodyEvaluationRecorder()
+  }
+
+  override func tearDown() {
+    window = nil
+    recorder = nil
+    super.tearDown()
+  }
+
+  func testThatPressOnlyReevaluatesButton() {
+    let viewModel = GoogleSignInButtonViewModel(scheme: .dark, style: .wide)
+    render(viewModel)
+
+    recorder.reset()
+    viewModel.state = .pressed
+    flush()
+
+    XCTAssertGreaterThan(recorder.count(for: .button), 0)
+    XCTAssertEqual(recorder.count(for: .label), 0)
+    XCTAssertEqual(recorder.count(for: .icon), 0)
+    XCTAssertEqual(recorder.count(for: .text), 0)
+  }
+
+  func testThatPressWithIconColorChangeOnlyReevaluatesIcon() {
+    let viewModel = GoogleSignInButtonViewModel(scheme: .light, style: .standard)
+    render(viewModel)
+
+    recorder.reset()
+    viewModel.state = .pressed
+    flush()
+
+    XCTAssertEqual(recorder.count(for: .label), 1)
+    XCTAssertEqual(recorder.count(for: .icon), 1)
+    XCTAssertEqual(recorder.count(for: .text), 0)
+  }
+
+  func testBodyEvaluationsPerPressCycle() {
+    let viewModel = GoogleSignInButtonViewModel(scheme: .dark, style: .wide)
+    render(viewModel)
+
+    let cycles = 50
+    recorder.reset()
+    measure {
+      for _ in 0..<cycles {
+        viewModel.state = .pressed
+        flush()
+        viewModel.state = .normal
+        flush()
+      }
+    }
+
+    // Each press and each release updates the button once. `measure` runs its block 10 times.
+    let interactions = 2 * cycles * 10
+    XCTAssertLessThanOrEqual(recorder.count(for: .button), interactions)
+    XCTAssertEqual(recorder.count(for: .label), 0)
+    XCTAssertEqual(recorder.count(for: .icon), 0)
+    XCTAssertEqual(recorder.count(for: .text), 0)
+  }
+#endif // os(iOS) && !targetEnvironment(macCatalyst)
+
+  func testThatPressKeepsDarkSchemeLabel() {
+    for style in [GoogleSignInButtonStyle.standard, .wide] {
+      let viewModel = GoogleSignInButtonViewModel(scheme: .dark, style: style)
+      let normalLabel = SignInButtonLabel(viewModel: viewModel)
+      viewModel.state = .pressed
+      XCTAssertEqual(SignInButtonLabel(viewModel: viewModel), normalLabel, "\(style)")
+      viewModel.state = .normal
+      XCTAssertEqual(SignInButtonLabel(viewModel: viewModel), normalLabel, "\(style)")
+    }
+  }
+
+  func testThatPressChangesIconStyleBorder() {
+    // The icon style draws a border in the background color, which darkens on press.
+    let viewModel = GoogleSignInButtonViewModel(scheme: .dark, style: .icon)
+    let normalLabel = SignInButtonLabel(viewModel: viewModel)
+    viewModel.state = .pressed
+    let pressedLabel = SignInButtonLabel(viewModel: viewModel)
+
+    XCTAssertNotNil(normalLabel.iconBorderColor)
+    XCTAssertNotEqual(pressedLabel.iconBorderColor, normalLabel.iconBorderColor)
+    XCTAssertEqual(pressedLabel.iconColor, normalLabel.iconColor)
+  }
+
+  func testThatPressWithIconColorChangeKeepsText() {
+    // The light scheme dims the icon background on press.
+    let viewModel = GoogleSignInButtonViewModel(scheme: .light, style: .standard)
+    let normalLabel = SignInButtonLabel(viewModel: viewModel)
+    viewModel.state = .pressed
+    let pressedLabel = SignInButtonLabel(viewModel: viewModel)
+
+    XCTAssertNotEqual(pressedLabel, normalLabel)
+    XCTAssertNotEqual(pressedLabel.iconColor, normalLabel.iconColor)
+    XCTAssertEqual(pressedLabel.isDisabled, normalLabel.isDisabled)
+    XCTAssertEqual(SignInButtonText(style: pressedLabel.style),
+                   SignInButtonText(style: normalLabel.style))
+  }
+
+  func testThatDisablingChangesLabel() {
+    let viewModel = GoogleSignInButtonViewModel(scheme: .dark, style: .wide)
+    let normalLabel = SignInButtonLabel(viewModel: viewModel)
+    viewModel.state = .disabled
+    let disabledLabel = SignInButtonLabel(viewModel: viewModel)
+
+    XCTAssertNotEqual(disabledLabel, normalLabel)
+    XCTAssertTrue(disabledLabel.isDisabled)
+  }
+
+#if os(iOS) && !targetEnvironment(macCatalyst)
+  // MARK: - Helpers
+
+  private func render(_ viewModel: GoogleSignInButtonViewModel) {
+    let button = GoogleSignInButton(viewModel: viewModel) {}
+      .environment(\.signInButtonBodyEvaluationRecorder, recorder)
+    let window = UIWindow(frame: CGRect(x: 0, y: 0, width: 320, height: 100))
+    window.rootViewController = UIHostingController(rootView: button)
+    window.isHidden = false
+    self.window = window
+    flush()
+  }
+
+  private func flush() {
+    RunLoop.current.run(until: Date())
+    window?.rootViewController?.view.setNeedsLayout()
+    window?.rootViewController?.view.layoutIfNeeded()
+  }
+#endif // os(iOS) && !targetEnvironment(macCatalyst)
+}
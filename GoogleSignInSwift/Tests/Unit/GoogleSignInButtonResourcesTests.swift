@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+import XCTest
+@testable import GoogleSignInSwift
+
+@available(iOS 13.0, macOS 10.15, *)
+class GoogleSignInButtonResourcesTests: XCTestCase {
+
+  func testThatButtonTextMatchesLocalizedStrings() {
+    let resources = GoogleSignInButtonResources(notificationCenter: NotificationCenter())
+    let strings = GoogleSignInButtonString()
+    XCTAssertEqual(
+      resources.buttonText(for: .standard),
+      strings.localizedStandardButtonText
+    )
+    XCTAssertEqual(resources.buttonText(for: .wide), strings.localizedWideButtonText)
+    XCTAssertEqual(resources.buttonText(for: .icon), "")
+  }
+
+  func testThatWidthsAreMeasured() {
+    let resources = GoogleSignInButtonResources(notificationCenter: NotificationCenter())
+    let standardWidth = resources.widthForButtonText(for: .standard)
+    let wideWidth = resources.widthForButtonText(for: .wide)
+    XCTAssertGreaterThan(standardWidth, 0)
+    XCTAssertGreaterThan(wideWidth, standardWidth)
+    XCTAssertEqual(resources.widthForButtonText(for: .icon), 0)
+  }
+
+  func testThatLocaleChangeKeepsMetricsConsistent() {
+    let notificationCenter = NotificationCenter()
+    let resources = GoogleSignInButtonResources(notificationCenter: notificationCenter)
+    let width = resources.widthForButtonText(for: .wide)
+    notificationCenter.post(name: NSLocale.currentLocaleDidChangeNotification, object: nil)
+    XCTAssertEqual(resources.widthForButtonText(for: .wide), width)
+    XCTAssertEqual(GoogleSignInButtonStyle.wide.widthForButtonText, width)
+  }
+
+  func testWidthLookupPerformance() {
+    _ = GoogleSignInButtonStyle.wide.widthForButtonText
+    measure {
+      for _ in 0..<10_000 {
+        _ = GoogleSignInButtonStyle.wide.widthForButtonText
+      }
+    }
+  }
+}